@@ -0,0 +1,554 @@
+#ifndef CAAR_FUNCTOR_HPP
+#define CAAR_FUNCTOR_HPP
+
+#include "Types.hpp"
+#include "Control.hpp"
+#include "Elements.hpp"
+#include "Derivative.hpp"
+#include "KernelVariables.hpp"
+#include "SphereOperators.hpp"
+
+#include "Utility.hpp"
+#include "profiling.hpp"
+
+#include <assert.h>
+
+namespace Homme {
+
+// Each team computes the right hand side of a pack of VECTOR_SIZE elements.
+// Since the lanes hold different elements, the vertical integrals are plain
+// recurrences over the levels, with every lane doing useful work.
+struct CaarFunctor {
+  Control m_data;
+  const Elements m_elements;
+  const Derivative m_deriv;
+
+  static constexpr Kokkos::Impl::ALL_t ALL = Kokkos::ALL;
+
+  CaarFunctor()
+      : m_data(), m_elements(get_elements()), m_deriv(get_derivative()) {
+    // Nothing to be done here
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  CaarFunctor(const Control &data, const Elements &elements,
+              const Derivative &deriv)
+      : m_data(data), m_elements(elements), m_deriv(deriv) {
+    // Nothing to be done here
+  }
+
+  // Depends on PHI (after preq_hydrostatic), PECND
+  // Modifies Ephi_grad
+  // Computes \nabla (E + phi) + \nabla (P) * Rgas * T_v / P
+  KOKKOS_INLINE_FUNCTION void compute_energy_grad(KernelVariables &kv) const {
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP),
+                         [&](const int idx) {
+      const int igp = idx / NP;
+      const int jgp = idx % NP;
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV),
+                           [&](const int &ilev) {
+        // pre-fill energy_grad with the pressure(_grad)-temperature part
+        const Scalar rgas_tv_over_p =
+            PhysicalConstants::Rgas *
+            divide(m_elements.buffers.temperature_virt(kv.ie, igp, jgp, ilev),
+                   m_elements.buffers.pressure(kv.ie, igp, jgp, ilev));
+        m_elements.buffers.energy_grad(kv.ie, 0, igp, jgp, ilev) =
+            rgas_tv_over_p *
+            m_elements.buffers.pressure_grad(kv.ie, 0, igp, jgp, ilev);
+        m_elements.buffers.energy_grad(kv.ie, 1, igp, jgp, ilev) =
+            rgas_tv_over_p *
+            m_elements.buffers.pressure_grad(kv.ie, 1, igp, jgp, ilev);
+
+        // Kinetic energy + PHI (geopotential energy) +
+        // PECND (potential energy?)
+        const Scalar &u = m_elements.m_u(kv.ie, m_data.n0, igp, jgp, ilev);
+        const Scalar &v = m_elements.m_v(kv.ie, m_data.n0, igp, jgp, ilev);
+        Scalar k_energy = 0.5 * fma(u, u, v * v);
+        m_elements.buffers.ephi(kv.ie, igp, jgp, ilev) =
+            k_energy + (m_elements.m_phi(kv.ie, igp, jgp, ilev) +
+                        m_elements.m_pecnd(kv.ie, igp, jgp, ilev));
+      });
+    });
+    kv.team_barrier();
+
+    gradient_sphere_update(
+        kv, m_elements.m_dinv, m_deriv.get_dvv(),
+        Kokkos::subview(m_elements.buffers.ephi, kv.ie, ALL, ALL, ALL),
+        m_elements.buffers.grad_buf,
+        Kokkos::subview(m_elements.buffers.energy_grad, kv.ie, ALL, ALL, ALL,
+                        ALL));
+  }
+
+#ifdef NDEBUG
+  KOKKOS_INLINE_FUNCTION void check_dp3d(KernelVariables &kv) const {}
+#else
+  KOKKOS_INLINE_FUNCTION void check_dp3d(KernelVariables &kv) const {
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP * NUM_LEV),
+                         [&](const int &idx) {
+      const int igp = (idx / NUM_LEV) / NP;
+      const int jgp = (idx / NUM_LEV) % NP;
+      const int ilev = idx % NUM_LEV;
+      for (int iv = 0; iv < VECTOR_SIZE; ++iv) {
+        assert(m_elements.m_dp3d(kv.ie, m_data.np1, igp, jgp, ilev)[iv] > 0.0);
+      }
+    });
+    kv.team_barrier();
+  }
+#endif
+
+  // Depends on pressure, PHI, U_current, V_current, METDET,
+  // D, DINV, U, V, FCOR, SPHEREMP, T_v, ETA_DPDN
+  // With rsplit=0, the vertical advection of T and v is fused into the
+  // temperature and velocity updates
+  KOKKOS_INLINE_FUNCTION void compute_phase_3(KernelVariables &kv) const {
+    if (m_data.rsplit == 0) {
+      compute_eta_dpdn_no_rsplit(kv);
+    } else {
+      compute_eta_dpdn_rsplit(kv);
+    }
+    compute_omega_p(kv);
+    compute_temperature_np1(kv);
+    compute_velocity_np1(kv);
+    compute_dp3d_np1(kv);
+    check_dp3d(kv);
+  }
+
+  // Depends on pressure, PHI, U_current, V_current, METDET,
+  // D, DINV, U, V, FCOR, SPHEREMP, T_v
+  KOKKOS_INLINE_FUNCTION
+  void compute_velocity_np1(KernelVariables &kv) const {
+    compute_energy_grad(kv);
+
+    vorticity_sphere(
+        kv, m_elements.m_d, m_elements.m_metdet, m_deriv.get_dvv(),
+        Kokkos::subview(m_elements.m_u, kv.ie, m_data.n0, ALL, ALL, ALL),
+        Kokkos::subview(m_elements.m_v, kv.ie, m_data.n0, ALL, ALL, ALL),
+        m_elements.buffers.vort_buf,
+        Kokkos::subview(m_elements.buffers.vorticity, kv.ie, ALL, ALL, ALL));
+
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP),
+                         [&](const int idx) {
+      const int igp = idx / NP;
+      const int jgp = idx % NP;
+      const Scalar fcor = m_elements.m_fcor(kv.ie, igp, jgp);
+      const Scalar spheremp = m_elements.m_spheremp(kv.ie, igp, jgp);
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV),
+                           [&](const int &ilev) {
+        // Recycle vort to contain (fcor+vort)
+        m_elements.buffers.vorticity(kv.ie, igp, jgp, ilev) += fcor;
+        const Scalar &vort = m_elements.buffers.vorticity(kv.ie, igp, jgp, ilev);
+
+        // -energy_grad - v_vadv + (v, -u) * (fcor + vort)
+        Scalar &grad_0 = m_elements.buffers.energy_grad(kv.ie, 0, igp, jgp, ilev);
+        Scalar &grad_1 = m_elements.buffers.energy_grad(kv.ie, 1, igp, jgp, ilev);
+        grad_0 = fms(m_elements.m_v(kv.ie, m_data.n0, igp, jgp, ilev), vort,
+                     grad_0);
+        grad_1 = fnma(m_elements.m_u(kv.ie, m_data.n0, igp, jgp, ilev), vort,
+                      -grad_1);
+        if (m_data.rsplit == 0) {
+          const Scalar half_rdp = divide(
+              0.5, m_elements.m_dp3d(kv.ie, m_data.n0, igp, jgp, ilev));
+          const Scalar &eta_k =
+              m_elements.buffers.eta_dot_dpdn(kv.ie, igp, jgp, ilev);
+          const Scalar &eta_kp1 =
+              m_elements.buffers.eta_dot_dpdn(kv.ie, igp, jgp, ilev + 1);
+          grad_0 -= preq_vertadv(kv, m_elements.m_u, half_rdp, eta_k, eta_kp1,
+                                 igp, jgp, ilev);
+          grad_1 -= preq_vertadv(kv, m_elements.m_v, half_rdp, eta_k, eta_kp1,
+                                 igp, jgp, ilev);
+        }
+
+        grad_0 = fma(grad_0, m_data.dt,
+                     m_elements.m_u(kv.ie, m_data.nm1, igp, jgp, ilev));
+        grad_1 = fma(grad_1, m_data.dt,
+                     m_elements.m_v(kv.ie, m_data.nm1, igp, jgp, ilev));
+
+        // Velocity at np1 = spheremp * buffer
+        m_elements.m_u(kv.ie, m_data.np1, igp, jgp, ilev) = spheremp * grad_0;
+        m_elements.m_v(kv.ie, m_data.np1, igp, jgp, ilev) = spheremp * grad_1;
+      });
+    });
+    kv.team_barrier();
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void compute_eta_dpdn_rsplit(KernelVariables &kv) const {
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP),
+                         [&](const int idx) {
+      const int igp = idx / NP;
+      const int jgp = idx % NP;
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV_P),
+                           [&](const int &ilev) {
+        m_elements.m_eta_dot_dpdn(kv.ie, igp, jgp, ilev) = 0;
+      });
+    });
+    kv.team_barrier();
+  }
+
+  // eta_dot_dpdn(k) = hybi(k) * sum(div_vdp) - sum_{j<k} div_vdp(j), which
+  // vanishes at the top and bottom interfaces. preq_omega_ps leaves the
+  // partial sums in buffers.eta_dot_dpdn, with the full column sum stored at
+  // the bottom interface
+  KOKKOS_INLINE_FUNCTION
+  void compute_eta_dpdn_no_rsplit(KernelVariables &kv) const {
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP),
+                         [&](const int idx) {
+      const int igp = idx / NP;
+      const int jgp = idx % NP;
+      const Scalar sdot_sum =
+          m_elements.buffers.eta_dot_dpdn(kv.ie, igp, jgp, NUM_PHYSICAL_LEV);
+      // The interior interfaces 1 to NUM_PHYSICAL_LEV - 1
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team,
+                                                     NUM_PHYSICAL_LEV - 1),
+                           [&](const int &k) {
+        const int ilev = k + 1;
+        Scalar &eta_dot_dpdn =
+            m_elements.buffers.eta_dot_dpdn(kv.ie, igp, jgp, ilev);
+        eta_dot_dpdn = fms(m_data.hybrid_b(ilev), sdot_sum, eta_dot_dpdn);
+        m_elements.m_eta_dot_dpdn(kv.ie, igp, jgp, ilev) =
+            fma(m_data.eta_ave_w, eta_dot_dpdn,
+                m_elements.m_eta_dot_dpdn(kv.ie, igp, jgp, ilev));
+      });
+      m_elements.buffers.eta_dot_dpdn(kv.ie, igp, jgp, 0) = 0;
+      m_elements.buffers.eta_dot_dpdn(kv.ie, igp, jgp, NUM_PHYSICAL_LEV) = 0;
+    });
+    kv.team_barrier();
+  }
+
+  // Vertical advection of field at level ilev
+  //   0.5/dp3d(k) * (eta_dot_dpdn(k+1) * (f(k+1) - f(k)) +
+  //                  eta_dot_dpdn(k)   * (f(k) - f(k-1)))
+  // The boundary fluxes are zero, so the missing neighbours of the top and
+  // bottom levels are replaced by the level itself
+  KOKKOS_INLINE_FUNCTION
+  Scalar preq_vertadv(
+      const KernelVariables &kv,
+      const ExecViewManaged<Scalar * [NUM_TIME_LEVELS][NP][NP][NUM_LEV]> &field,
+      const Scalar &half_rdp, const Scalar &eta_k, const Scalar &eta_kp1,
+      const int igp, const int jgp, const int ilev) const {
+    const Scalar &f = field(kv.ie, m_data.n0, igp, jgp, ilev);
+    const Scalar &f_next = field(kv.ie, m_data.n0, igp, jgp,
+                                 ilev + 1 < NUM_LEV ? ilev + 1 : ilev);
+    const Scalar &f_prev =
+        field(kv.ie, m_data.n0, igp, jgp, ilev > 0 ? ilev - 1 : ilev);
+    return half_rdp * fma(eta_kp1, f_next - f, eta_k * (f - f_prev));
+  }
+
+  // Depends on PHIS, DP3D, PHI, pressure, T_v
+  // Modifies PHI
+  KOKKOS_INLINE_FUNCTION
+  void preq_hydrostatic(KernelVariables &kv) const {
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP),
+                         [&](const int loop_idx) {
+      Kokkos::single(Kokkos::PerThread(kv.team), [&]() {
+        const int igp = loop_idx / NP;
+        const int jgp = loop_idx % NP;
+
+        const Scalar phis = m_elements.m_phis(kv.ie, igp, jgp);
+        // Sum of the levels below ilev
+        Scalar integration;
+        for (int ilev = NUM_LEV - 1; ilev >= 0; --ilev) {
+          const Scalar &t_v =
+              m_elements.buffers.temperature_virt(kv.ie, igp, jgp, ilev);
+          const Scalar &dp3d =
+              m_elements.m_dp3d(kv.ie, m_data.n0, igp, jgp, ilev);
+          const Scalar &p = m_elements.buffers.pressure(kv.ie, igp, jgp, ilev);
+
+          const Scalar rgas_tv_dp_over_p =
+              PhysicalConstants::Rgas * t_v * divide(dp3d * 0.5, p);
+
+          // Add integral and constant terms to phi
+          m_elements.m_phi(kv.ie, igp, jgp, ilev) =
+              fma(2.0, integration, phis + rgas_tv_dp_over_p);
+          integration += rgas_tv_dp_over_p;
+        }
+      });
+    });
+    kv.team_barrier();
+  }
+
+  // Depends on pressure, U_current, V_current, div_vdp,
+  // omega_p
+  KOKKOS_INLINE_FUNCTION
+  void preq_omega_ps(KernelVariables &kv) const {
+    gradient_sphere(
+        kv, m_elements.m_dinv, m_deriv.get_dvv(),
+        Kokkos::subview(m_elements.buffers.pressure, kv.ie, ALL, ALL, ALL),
+        m_elements.buffers.grad_buf,
+        Kokkos::subview(m_elements.buffers.pressure_grad, kv.ie, ALL, ALL, ALL,
+                        ALL));
+
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP),
+                         [&](const int loop_idx) {
+      Kokkos::single(Kokkos::PerThread(kv.team), [&]() {
+        const int igp = loop_idx / NP;
+        const int jgp = loop_idx % NP;
+
+        // Sum of div_vdp over the levels above ilev
+        Scalar integration;
+        for (int ilev = 0; ilev < NUM_LEV; ++ilev) {
+          const Scalar vgrad_p = fma(
+              m_elements.m_u(kv.ie, m_data.n0, igp, jgp, ilev),
+              m_elements.buffers.pressure_grad(kv.ie, 0, igp, jgp, ilev),
+              m_elements.m_v(kv.ie, m_data.n0, igp, jgp, ilev) *
+                  m_elements.buffers.pressure_grad(kv.ie, 1, igp, jgp, ilev));
+          const Scalar &p = m_elements.buffers.pressure(kv.ie, igp, jgp, ilev);
+          const Scalar &div_vdp =
+              m_elements.buffers.div_vdp(kv.ie, igp, jgp, ilev);
+
+          m_elements.buffers.omega_p(kv.ie, igp, jgp, ilev) =
+              divide(vgrad_p - fma(0.5, div_vdp, integration), p);
+          if (m_data.rsplit == 0) {
+            // Partial sums for compute_eta_dpdn_no_rsplit
+            m_elements.buffers.eta_dot_dpdn(kv.ie, igp, jgp, ilev) =
+                integration;
+          }
+          integration += div_vdp;
+        }
+        if (m_data.rsplit == 0) {
+          m_elements.buffers.eta_dot_dpdn(kv.ie, igp, jgp, NUM_PHYSICAL_LEV) =
+              integration;
+        }
+      });
+    });
+    kv.team_barrier();
+  }
+
+  // Depends on DP3D
+  KOKKOS_INLINE_FUNCTION
+  void compute_pressure(KernelVariables &kv) const {
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP),
+                         [&](const int loop_idx) {
+      Kokkos::single(Kokkos::PerThread(kv.team), [&]() {
+        const int igp = loop_idx / NP;
+        const int jgp = loop_idx % NP;
+
+        Scalar dp_prev;
+        Scalar p_prev = m_data.hybrid_a(0) * m_data.ps0;
+        for (int ilev = 0; ilev < NUM_LEV; ++ilev) {
+          const Scalar &dp = m_elements.m_dp3d(kv.ie, m_data.n0, igp, jgp, ilev);
+          // p[k] = p[k-1] + 0.5*dp[k-1] + 0.5*dp[k]
+          p_prev = p_prev + 0.5 * dp_prev + 0.5 * dp;
+          dp_prev = dp;
+          m_elements.buffers.pressure(kv.ie, igp, jgp, ilev) = p_prev;
+        }
+      });
+    });
+    kv.team_barrier();
+  }
+
+  // Depends on DP3D, PHIS, DP3D, PHI, T_v
+  // Modifies pressure, PHI
+  KOKKOS_INLINE_FUNCTION
+  void compute_scan_properties(KernelVariables &kv) const {
+    compute_pressure(kv);
+    preq_hydrostatic(kv);
+    preq_omega_ps(kv);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void compute_temperature_no_tracers_helper(KernelVariables &kv) const {
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP),
+                         [&](const int idx) {
+      const int igp = idx / NP;
+      const int jgp = idx % NP;
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV),
+                           [&](const int &ilev) {
+        m_elements.buffers.temperature_virt(kv.ie, igp, jgp, ilev) =
+            m_elements.m_t(kv.ie, m_data.n0, igp, jgp, ilev);
+      });
+    });
+    kv.team_barrier();
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void compute_temperature_tracers_helper(KernelVariables &kv) const {
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP),
+                         [&](const int idx) {
+      const int igp = idx / NP;
+      const int jgp = idx % NP;
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV),
+                           [&](const int &ilev) {
+        Scalar Qt = m_elements.m_qdp(kv.ie, m_data.qn0, 0, igp, jgp, ilev) /
+                    m_elements.m_dp3d(kv.ie, m_data.n0, igp, jgp, ilev);
+        Qt *= (PhysicalConstants::Rwater_vapor / PhysicalConstants::Rgas - 1.0);
+        Qt += 1.0;
+        m_elements.buffers.temperature_virt(kv.ie, igp, jgp, ilev) =
+            m_elements.m_t(kv.ie, m_data.n0, igp, jgp, ilev) * Qt;
+      });
+    });
+    kv.team_barrier();
+  }
+
+  // Depends on DERIVED_UN0, DERIVED_VN0, METDET, DINV
+  // Initializes div_vdp, which is used 2 times afterwards
+  // Modifies DERIVED_UN0, DERIVED_VN0
+  KOKKOS_INLINE_FUNCTION
+  void compute_div_vdp(KernelVariables &kv) const {
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP),
+                         [&](const int idx) {
+      const int igp = idx / NP;
+      const int jgp = idx % NP;
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV),
+                           [&](const int &ilev) {
+        m_elements.buffers.vdp(kv.ie, 0, igp, jgp, ilev) =
+            m_elements.m_u(kv.ie, m_data.n0, igp, jgp, ilev) *
+            m_elements.m_dp3d(kv.ie, m_data.n0, igp, jgp, ilev);
+
+        m_elements.buffers.vdp(kv.ie, 1, igp, jgp, ilev) =
+            m_elements.m_v(kv.ie, m_data.n0, igp, jgp, ilev) *
+            m_elements.m_dp3d(kv.ie, m_data.n0, igp, jgp, ilev);
+
+        m_elements.m_derived_un0(kv.ie, igp, jgp, ilev) =
+            fma(m_data.eta_ave_w,
+                m_elements.buffers.vdp(kv.ie, 0, igp, jgp, ilev),
+                m_elements.m_derived_un0(kv.ie, igp, jgp, ilev));
+
+        m_elements.m_derived_vn0(kv.ie, igp, jgp, ilev) =
+            fma(m_data.eta_ave_w,
+                m_elements.buffers.vdp(kv.ie, 1, igp, jgp, ilev),
+                m_elements.m_derived_vn0(kv.ie, igp, jgp, ilev));
+      });
+    });
+    kv.team_barrier();
+
+    divergence_sphere(
+        kv, m_elements.m_dinv, m_elements.m_metdet, m_deriv.get_dvv(),
+        Kokkos::subview(m_elements.buffers.vdp, kv.ie, ALL, ALL, ALL, ALL),
+        m_elements.buffers.div_buf,
+        Kokkos::subview(m_elements.buffers.div_vdp, kv.ie, ALL, ALL, ALL));
+  }
+
+  // Depends on T_current, DERIVE_UN0, DERIVED_VN0, METDET,
+  // DINV
+  // Might depend on QDP, DP3D_current
+  KOKKOS_INLINE_FUNCTION
+  void compute_temperature_div_vdp(KernelVariables &kv) const {
+    if (m_data.qn0 == -1) {
+      compute_temperature_no_tracers_helper(kv);
+    } else {
+      compute_temperature_tracers_helper(kv);
+    }
+    compute_div_vdp(kv);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void compute_omega_p(KernelVariables &kv) const {
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP),
+                         [&](const int idx) {
+      const int igp = idx / NP;
+      const int jgp = idx % NP;
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV),
+                           [&](const int &ilev) {
+        m_elements.m_omega_p(kv.ie, igp, jgp, ilev) =
+            fma(m_data.eta_ave_w,
+                m_elements.buffers.omega_p(kv.ie, igp, jgp, ilev),
+                m_elements.m_omega_p(kv.ie, igp, jgp, ilev));
+      });
+    });
+    kv.team_barrier();
+  }
+
+  // Depends on T (global), OMEGA_P (global), U (global), V
+  // (global),
+  // SPHEREMP (global), T_v, and omega_p
+  KOKKOS_INLINE_FUNCTION
+  void compute_temperature_np1(KernelVariables &kv) const {
+
+    gradient_sphere(
+        kv, m_elements.m_dinv, m_deriv.get_dvv(),
+        Kokkos::subview(m_elements.m_t, kv.ie, m_data.n0, ALL, ALL, ALL),
+        m_elements.buffers.grad_buf,
+        Kokkos::subview(m_elements.buffers.temperature_grad, kv.ie, ALL, ALL,
+                        ALL, ALL));
+
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP),
+                         [&](const int idx) {
+      const int igp = idx / NP;
+      const int jgp = idx % NP;
+      const Scalar spheremp = m_elements.m_spheremp(kv.ie, igp, jgp);
+
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV),
+                           [&](const int &ilev) {
+        const Scalar vgrad_t = fma(
+            m_elements.m_u(kv.ie, m_data.n0, igp, jgp, ilev),
+            m_elements.buffers.temperature_grad(kv.ie, 0, igp, jgp, ilev),
+            m_elements.m_v(kv.ie, m_data.n0, igp, jgp, ilev) *
+                m_elements.buffers.temperature_grad(kv.ie, 1, igp, jgp, ilev));
+
+        // -vgrad_t - T_vadv + kappa * T_v * omega_p
+        Scalar ttens =
+            fms(PhysicalConstants::kappa *
+                    m_elements.buffers.temperature_virt(kv.ie, igp, jgp, ilev),
+                m_elements.buffers.omega_p(kv.ie, igp, jgp, ilev), vgrad_t);
+        if (m_data.rsplit == 0) {
+          const Scalar half_rdp = divide(
+              0.5, m_elements.m_dp3d(kv.ie, m_data.n0, igp, jgp, ilev));
+          ttens -= preq_vertadv(
+              kv, m_elements.m_t, half_rdp,
+              m_elements.buffers.eta_dot_dpdn(kv.ie, igp, jgp, ilev),
+              m_elements.buffers.eta_dot_dpdn(kv.ie, igp, jgp, ilev + 1), igp,
+              jgp, ilev);
+        }
+
+        Scalar temp_np1 = fma(ttens, m_data.dt,
+                              m_elements.m_t(kv.ie, m_data.nm1, igp, jgp, ilev));
+        temp_np1 *= spheremp;
+        m_elements.m_t(kv.ie, m_data.np1, igp, jgp, ilev) = temp_np1;
+      });
+    });
+    kv.team_barrier();
+  }
+
+  // Depends on DERIVED_UN0, DERIVED_VN0, U, V,
+  // Modifies DERIVED_UN0, DERIVED_VN0, OMEGA_P, T, and DP3D
+  KOKKOS_INLINE_FUNCTION
+  void compute_dp3d_np1(KernelVariables &kv) const {
+    // The flux of this stage when rsplit is 0
+    const ExecViewManaged<Scalar * [NP][NP][NUM_LEV_P]> &eta_dot_dpdn =
+        (m_data.rsplit == 0 ? m_elements.buffers.eta_dot_dpdn
+                            : m_elements.m_eta_dot_dpdn);
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP),
+                         [&](const int idx) {
+      const int igp = idx / NP;
+      const int jgp = idx % NP;
+      const Scalar spheremp = m_elements.m_spheremp(kv.ie, igp, jgp);
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
+        Scalar tmp = eta_dot_dpdn(kv.ie, igp, jgp, ilev + 1);
+        // Add div_vdp before subtracting the previous value to eta_dot_dpdn
+        // This will hopefully reduce numeric error
+        tmp += m_elements.buffers.div_vdp(kv.ie, igp, jgp, ilev);
+        tmp -= eta_dot_dpdn(kv.ie, igp, jgp, ilev);
+        tmp = fnma(tmp, m_data.dt,
+                   m_elements.m_dp3d(kv.ie, m_data.nm1, igp, jgp, ilev));
+
+        m_elements.m_dp3d(kv.ie, m_data.np1, igp, jgp, ilev) = spheremp * tmp;
+      });
+    });
+    kv.team_barrier();
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const TeamMember &team) const {
+    start_timer("caar compute");
+    KernelVariables kv(team);
+
+    compute_temperature_div_vdp(kv);
+    kv.team.team_barrier();
+
+    compute_scan_properties(kv);
+    kv.team.team_barrier();
+
+    compute_phase_3(kv);
+    stop_timer("caar compute");
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  size_t shmem_size(const int team_size) const {
+    return KernelVariables::shmem_size(team_size);
+  }
+};
+
+} // Namespace Homme
+
+#endif // CAAR_FUNCTOR_HPP
@@ -0,0 +1,41 @@
+#include "Control.hpp"
+
+namespace Homme {
+
+void Control::init(const int nets_in, const int nete_in,
+                   const int num_elems_in, const int nm1_in,
+                   const int n0_in, const int np1_in, const int qn0_in,
+                   const int qsize_in, const Real dt_in, const Real ps0_in,
+                   const bool compute_diagonstics_in,
+                   const Real eta_ave_w_in, const int rsplit_in,
+                   CRCPtr hybrid_a_ptr, CRCPtr hybrid_b_ptr) {
+  nets = nets_in;
+  nete = nete_in;
+  num_elems = num_elems_in;
+  n0 = n0_in;
+  nm1 = nm1_in;
+  np1 = np1_in;
+  qn0 = qn0_in;
+  qsize = qsize_in;
+  dt  = dt_in;
+  ps0 = ps0_in;
+  compute_diagonstics = compute_diagonstics_in;
+  eta_ave_w = eta_ave_w_in;
+  rsplit = rsplit_in;
+  hybrid_a = ExecViewManaged<Real[NUM_LEV_P]>(
+      "Hybrid coordinates; translates between pressure and velocity");
+
+  HostViewUnmanaged<const Real[NUM_LEV_P]> host_hybrid_a(hybrid_a_ptr);
+  Kokkos::deep_copy(hybrid_a, host_hybrid_a);
+
+  hybrid_b = ExecViewManaged<Real[NUM_LEV_P]>("Hybrid b at the interfaces");
+  HostViewUnmanaged<const Real[NUM_LEV_P]> host_hybrid_b(hybrid_b_ptr);
+  Kokkos::deep_copy(hybrid_b, host_hybrid_b);
+}
+
+Control &get_control() {
+  static Control cd;
+  return cd;
+}
+
+} // namespace Homme
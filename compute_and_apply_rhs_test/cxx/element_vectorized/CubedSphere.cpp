@@ -0,0 +1,391 @@
+#include "CubedSphere.hpp"
+#include "PhysicalConstants.hpp"
+
+#include <array>
+#include <assert.h>
+#include <cmath>
+#include <map>
+
+namespace Homme {
+
+namespace {
+
+// Solid body rotation of the initial state, one revolution every 12 days
+constexpr Real zonal_wind =
+    2.0 * PhysicalConstants::pi * PhysicalConstants::rearth / (12.0 * 86400.0);
+// Temperature of the isothermal initial state
+constexpr Real isothermal_t = 300.0;
+// Pressure at the model top
+constexpr Real p_top = 200.0;
+
+// Legendre polynomials of degree n and n - 1 at x
+void legendre(const int n, const Real x, Real &p_n, Real &p_nm1) {
+  Real p_prev = 1.0;
+  Real p = x;
+  for (int j = 2; j <= n; ++j) {
+    const Real p_next = ((2 * j - 1) * x * p - (j - 1) * p_prev) / j;
+    p_prev = p;
+    p = p_next;
+  }
+  p_n = p;
+  p_nm1 = p_prev;
+}
+
+// Point of the cube [-1, 1]^3 at the reference coordinates (x, y) of a
+// face, and its derivatives along x and y. The faces 0 to 3 go eastward
+// around the equator starting at longitude 0, 4 is the north one and 5 the
+// south one; all of them are right handed seen from outside.
+// Only exact negations and permutations of x, y and 1 are involved, so the
+// points on the edges of two faces are bitwise identical
+void cube_point(const int face, const Real x, const Real y, Real p[3],
+                Real dp_dx[3], Real dp_dy[3]) {
+  switch (face) {
+  case 0:
+    p[0] = 1.0; p[1] = x; p[2] = y;
+    dp_dx[0] = 0.0; dp_dx[1] = 1.0; dp_dx[2] = 0.0;
+    dp_dy[0] = 0.0; dp_dy[1] = 0.0; dp_dy[2] = 1.0;
+    break;
+  case 1:
+    p[0] = -x; p[1] = 1.0; p[2] = y;
+    dp_dx[0] = -1.0; dp_dx[1] = 0.0; dp_dx[2] = 0.0;
+    dp_dy[0] = 0.0; dp_dy[1] = 0.0; dp_dy[2] = 1.0;
+    break;
+  case 2:
+    p[0] = -1.0; p[1] = -x; p[2] = y;
+    dp_dx[0] = 0.0; dp_dx[1] = -1.0; dp_dx[2] = 0.0;
+    dp_dy[0] = 0.0; dp_dy[1] = 0.0; dp_dy[2] = 1.0;
+    break;
+  case 3:
+    p[0] = x; p[1] = -1.0; p[2] = y;
+    dp_dx[0] = 1.0; dp_dx[1] = 0.0; dp_dx[2] = 0.0;
+    dp_dy[0] = 0.0; dp_dy[1] = 0.0; dp_dy[2] = 1.0;
+    break;
+  case 4:
+    p[0] = -y; p[1] = x; p[2] = 1.0;
+    dp_dx[0] = 0.0; dp_dx[1] = 1.0; dp_dx[2] = 0.0;
+    dp_dy[0] = -1.0; dp_dy[1] = 0.0; dp_dy[2] = 0.0;
+    break;
+  default:
+    p[0] = y; p[1] = x; p[2] = -1.0;
+    dp_dx[0] = 0.0; dp_dx[1] = 1.0; dp_dx[2] = 0.0;
+    dp_dy[0] = 1.0; dp_dy[1] = 0.0; dp_dy[2] = 0.0;
+    break;
+  }
+}
+
+// Offsets in the F90 arrays (jgp is the fastest index, the element the
+// slowest). D(jgp, igp, idim, jdim, ie) in F90 is d(ie, jdim, idim, igp, jgp)
+// in Elements
+int f90_2d(const int ie, const int igp, const int jgp) {
+  return (ie * NP + igp) * NP + jgp;
+}
+
+int f90_tensor(const int ie, const int idim, const int jdim, const int igp,
+               const int jgp) {
+  return (((ie * 2 + jdim) * 2 + idim) * NP + igp) * NP + jgp;
+}
+
+} // namespace
+
+CubedSphere::CubedSphere(const int ne) : m_ne(ne), m_num_unique_points(0) {
+  assert(ne > 0 && NP > 1);
+  init_gll();
+  init_geometry();
+  init_connectivity();
+}
+
+void CubedSphere::init_gll() {
+  // Newton iterations on (x P_N - P_{N-1}) = N (1 - x^2) P'_N / (N + 1),
+  // from the Chebyshev-Gauss-Lobatto points. The second half is mirrored
+  // so that the points are exactly symmetric
+  const int n = NP - 1;
+  for (int k = 0; 2 * k <= n; ++k) {
+    Real x = -std::cos(PhysicalConstants::pi * k / n);
+    Real p_n, p_nm1;
+    for (int iter = 0; iter < 100; ++iter) {
+      legendre(n, x, p_n, p_nm1);
+      const Real dx = (x * p_n - p_nm1) / ((n + 1) * p_n);
+      x -= dx;
+      if (std::abs(dx) <= 1e-16) {
+        break;
+      }
+    }
+    if (k == 0) {
+      x = -1.0;
+    } else if (2 * k == n) {
+      x = 0.0;
+    }
+    legendre(n, x, p_n, p_nm1);
+    m_gll_points[k] = x;
+    m_gll_points[n - k] = -x;
+    m_gll_weights[k] = 2.0 / (n * (n + 1) * p_n * p_n);
+    m_gll_weights[n - k] = m_gll_weights[k];
+  }
+
+  Real p_at_points[NP];
+  for (int igp = 0; igp < NP; ++igp) {
+    Real p_nm1;
+    legendre(n, m_gll_points[igp], p_at_points[igp], p_nm1);
+  }
+  m_dvv.resize(NP * NP);
+  for (int igp = 0; igp < NP; ++igp) {
+    for (int jgp = 0; jgp < NP; ++jgp) {
+      Real value = 0.0;
+      if (igp != jgp) {
+        value = p_at_points[igp] /
+                (p_at_points[jgp] * (m_gll_points[igp] - m_gll_points[jgp]));
+      } else if (igp == 0) {
+        value = -0.25 * n * (n + 1);
+      } else if (igp == n) {
+        value = 0.25 * n * (n + 1);
+      }
+      m_dvv[igp * NP + jgp] = value;
+    }
+  }
+}
+
+Real CubedSphere::face_coordinate(const int g) const {
+  const int num_intervals = m_ne * (NP - 1);
+  if (2 * g > num_intervals) {
+    return -face_coordinate(num_intervals - g);
+  } else if (2 * g == num_intervals) {
+    return 0.0;
+  } else if (g == 0) {
+    return -1.0;
+  }
+  const int ie = g / (NP - 1);
+  const int igp = g % (NP - 1);
+  const Real alpha = 0.5 * PhysicalConstants::pi *
+                     ((ie + 0.5 * (m_gll_points[igp] + 1.0)) / m_ne - 0.5);
+  return std::tan(alpha);
+}
+
+void CubedSphere::init_geometry() {
+  const int num_points = num_elems() * NP * NP;
+  m_d.resize(4 * num_points);
+  m_dinv.resize(4 * num_points);
+  m_fcor.resize(num_points);
+  m_spheremp.resize(num_points);
+  m_metdet.resize(num_points);
+  m_phis.resize(num_points);
+  m_lat.resize(num_points);
+  m_lon.resize(num_points);
+
+  // d alpha / d xi, from the reference element [-1, 1] to the element
+  const Real half_width = 0.25 * PhysicalConstants::pi / m_ne;
+  const Real phis_scale =
+      PhysicalConstants::rearth * PhysicalConstants::omega * zonal_wind +
+      0.5 * zonal_wind * zonal_wind;
+
+  for (int face = 0, ie = 0; face < 6; ++face) {
+    for (int ey = 0; ey < m_ne; ++ey) {
+      for (int ex = 0; ex < m_ne; ++ex, ++ie) {
+        for (int igp = 0; igp < NP; ++igp) {
+          for (int jgp = 0; jgp < NP; ++jgp) {
+            const Real x = face_coordinate(ex * (NP - 1) + jgp);
+            const Real y = face_coordinate(ey * (NP - 1) + igp);
+            Real p[3], dp_dx[3], dp_dy[3];
+            cube_point(face, x, y, p, dp_dx, dp_dy);
+            const Real norm =
+                std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+            const Real lat = std::atan2(p[2], std::hypot(p[0], p[1]));
+            const Real lon = std::atan2(p[1], p[0]);
+
+            // The projection of p / |p| on the tangent plane drops out
+            // against the eastward and northward unit vectors
+            const Real east[3] = { -std::sin(lon), std::cos(lon), 0.0 };
+            const Real north[3] = { -std::sin(lat) * std::cos(lon),
+                                    -std::sin(lat) * std::sin(lon),
+                                    std::cos(lat) };
+            const Real scale_x = (1.0 + x * x) * half_width / norm;
+            const Real scale_y = (1.0 + y * y) * half_width / norm;
+            Real d[2][2];
+            d[0][0] = scale_x * (east[0] * dp_dx[0] + east[1] * dp_dx[1] +
+                                 east[2] * dp_dx[2]);
+            d[1][0] = scale_x * (north[0] * dp_dx[0] + north[1] * dp_dx[1] +
+                                 north[2] * dp_dx[2]);
+            d[0][1] = scale_y * (east[0] * dp_dy[0] + east[1] * dp_dy[1] +
+                                 east[2] * dp_dy[2]);
+            d[1][1] = scale_y * (north[0] * dp_dy[0] + north[1] * dp_dy[1] +
+                                 north[2] * dp_dy[2]);
+            const Real metdet = d[0][0] * d[1][1] - d[0][1] * d[1][0];
+
+            for (int idim = 0; idim < 2; ++idim) {
+              for (int jdim = 0; jdim < 2; ++jdim) {
+                m_d[f90_tensor(ie, idim, jdim, igp, jgp)] = d[idim][jdim];
+              }
+            }
+            m_dinv[f90_tensor(ie, 0, 0, igp, jgp)] = d[1][1] / metdet;
+            m_dinv[f90_tensor(ie, 0, 1, igp, jgp)] = -d[0][1] / metdet;
+            m_dinv[f90_tensor(ie, 1, 0, igp, jgp)] = -d[1][0] / metdet;
+            m_dinv[f90_tensor(ie, 1, 1, igp, jgp)] = d[0][0] / metdet;
+
+            const int k = f90_2d(ie, igp, jgp);
+            m_metdet[k] = metdet;
+            m_spheremp[k] = m_gll_weights[igp] * m_gll_weights[jgp] * metdet;
+            m_fcor[k] = 2.0 * PhysicalConstants::omega * std::sin(lat);
+            m_phis[k] = -phis_scale * std::sin(lat) * std::sin(lat);
+            m_lat[k] = lat;
+            m_lon[k] = lon;
+          }
+        }
+      }
+    }
+  }
+}
+
+void CubedSphere::init_connectivity() {
+  // The points of the cube are bitwise identical in all the elements that
+  // share them, so an exact lookup numbers them
+  std::map<std::array<Real, 3>, int> point_ids;
+  m_gids.resize(num_elems() * NP * NP);
+  for (int face = 0, ie = 0; face < 6; ++face) {
+    for (int ey = 0; ey < m_ne; ++ey) {
+      for (int ex = 0; ex < m_ne; ++ex, ++ie) {
+        for (int igp = 0; igp < NP; ++igp) {
+          for (int jgp = 0; jgp < NP; ++jgp) {
+            std::array<Real, 3> p;
+            Real dp_dx[3], dp_dy[3];
+            cube_point(face, face_coordinate(ex * (NP - 1) + jgp),
+                       face_coordinate(ey * (NP - 1) + igp), p.data(), dp_dx,
+                       dp_dy);
+            auto inserted = point_ids.insert(
+                std::make_pair(p, static_cast<int>(point_ids.size())));
+            m_gids[f90_2d(ie, igp, jgp)] = inserted.first->second;
+          }
+        }
+      }
+    }
+  }
+  m_num_unique_points = point_ids.size();
+
+  // The elements around each vertex of the mesh
+  std::map<int, std::vector<int> > vertex_elems;
+  for (int ie = 0; ie < num_elems(); ++ie) {
+    for (int igp = 0; igp < NP; igp += NP - 1) {
+      for (int jgp = 0; jgp < NP; jgp += NP - 1) {
+        vertex_elems[m_gids[f90_2d(ie, igp, jgp)]].push_back(ie);
+      }
+    }
+  }
+
+  m_neighbors.assign(num_elems() * NUM_DIRECTIONS, -1);
+  for (int ie = 0; ie < num_elems(); ++ie) {
+    const std::vector<int> &sw = vertex_elems[m_gids[f90_2d(ie, 0, 0)]];
+    const std::vector<int> &se = vertex_elems[m_gids[f90_2d(ie, 0, NP - 1)]];
+    const std::vector<int> &nw = vertex_elems[m_gids[f90_2d(ie, NP - 1, 0)]];
+    const std::vector<int> &ne =
+        vertex_elems[m_gids[f90_2d(ie, NP - 1, NP - 1)]];
+    int *neighbors = &m_neighbors[ie * NUM_DIRECTIONS];
+
+    // Across an edge: the other element at both of its vertices
+    auto edge_neighbor = [ie](const std::vector<int> &a,
+                              const std::vector<int> &b) {
+      for (int je : a) {
+        for (int ke : b) {
+          if (je == ke && je != ie) {
+            return je;
+          }
+        }
+      }
+      return -1;
+    };
+    neighbors[WEST] = edge_neighbor(sw, nw);
+    neighbors[EAST] = edge_neighbor(se, ne);
+    neighbors[SOUTH] = edge_neighbor(sw, se);
+    neighbors[NORTH] = edge_neighbor(nw, ne);
+
+    // Across a vertex: the element at the vertex that shares no edge
+    auto corner_neighbor = [ie](const std::vector<int> &v, const int edge_a,
+                                const int edge_b) {
+      for (int je : v) {
+        if (je != ie && je != edge_a && je != edge_b) {
+          return je;
+        }
+      }
+      return -1;
+    };
+    neighbors[SWEST] = corner_neighbor(sw, neighbors[WEST], neighbors[SOUTH]);
+    neighbors[SEAST] = corner_neighbor(se, neighbors[EAST], neighbors[SOUTH]);
+    neighbors[NWEST] = corner_neighbor(nw, neighbors[WEST], neighbors[NORTH]);
+    neighbors[NEAST] = corner_neighbor(ne, neighbors[EAST], neighbors[NORTH]);
+  }
+}
+
+void CubedSphere::init_state(const int num_elems) {
+  assert(num_elems >= 0 && num_elems <= this->num_elems());
+
+  // Uniform surface pressure: the pressure gradient along the model levels
+  // is then the one of phis, which balances the zonal wind
+  const Real ps = PhysicalConstants::p0;
+  m_ps0 = PhysicalConstants::p0;
+  Real p_int[NUM_INTERFACE_LEV];
+  m_hybrid_a.resize(NUM_INTERFACE_LEV);
+  for (int ilevel = 0; ilevel < NUM_INTERFACE_LEV; ++ilevel) {
+    const Real hybrid_b = static_cast<Real>(ilevel) / NUM_PHYSICAL_LEV;
+    m_hybrid_a[ilevel] = p_top / m_ps0 * (1.0 - hybrid_b);
+    p_int[ilevel] = m_hybrid_a[ilevel] * m_ps0 + hybrid_b * ps;
+  }
+
+  constexpr int level_size = NP * NP;
+  m_state_v.resize(num_elems * NUM_TIME_LEVELS * NUM_PHYSICAL_LEV * 2 *
+                   level_size);
+  m_state_t.resize(num_elems * NUM_TIME_LEVELS * NUM_PHYSICAL_LEV *
+                   level_size);
+  m_state_dp3d.resize(m_state_t.size());
+  m_derived_phi.resize(num_elems * NUM_PHYSICAL_LEV * level_size);
+  m_derived_pecnd.assign(m_derived_phi.size(), 0.0);
+  m_derived_omega_p.assign(m_derived_phi.size(), 0.0);
+  m_derived_v.assign(2 * m_derived_phi.size(), 0.0);
+  m_derived_eta_dot_dpdn.assign(num_elems * NUM_INTERFACE_LEV * level_size,
+                                0.0);
+  m_state_qdp.resize(num_elems * Q_NUM_TIME_LEVELS * QSIZE_D *
+                     NUM_PHYSICAL_LEV * level_size);
+
+  for (int ie = 0, k_4d_scalars = 0, k_4d_vectors = 0, k_3d = 0, k_qdp = 0;
+       ie < num_elems; ++ie) {
+    const Real *lat = &m_lat[f90_2d(ie, 0, 0)];
+    const Real *lon = &m_lon[f90_2d(ie, 0, 0)];
+    const Real *phis = &m_phis[f90_2d(ie, 0, 0)];
+    for (int tl = 0; tl < NUM_TIME_LEVELS; ++tl) {
+      for (int ilevel = 0; ilevel < NUM_PHYSICAL_LEV; ++ilevel) {
+        const Real dp = p_int[ilevel + 1] - p_int[ilevel];
+        for (int k = 0; k < level_size; ++k, ++k_4d_scalars) {
+          m_state_t[k_4d_scalars] = isothermal_t;
+          m_state_dp3d[k_4d_scalars] = dp;
+        }
+        for (int k = 0; k < level_size; ++k, ++k_4d_vectors) {
+          m_state_v[k_4d_vectors] = zonal_wind * std::cos(lat[k]);
+        }
+        for (int k = 0; k < level_size; ++k, ++k_4d_vectors) {
+          m_state_v[k_4d_vectors] = 0.0;
+        }
+      }
+    }
+
+    for (int ilevel = 0; ilevel < NUM_PHYSICAL_LEV; ++ilevel) {
+      const Real p_mid = 0.5 * (p_int[ilevel] + p_int[ilevel + 1]);
+      for (int k = 0; k < level_size; ++k, ++k_3d) {
+        m_derived_phi[k_3d] = phis[k] + PhysicalConstants::Rgas *
+                                            isothermal_t * std::log(ps / p_mid);
+      }
+    }
+
+    // Each tracer is a smooth bump centered at its own longitude
+    for (int qni = 0; qni < Q_NUM_TIME_LEVELS; ++qni) {
+      for (int iq = 0; iq < QSIZE_D; ++iq) {
+        const Real center = 2.0 * PhysicalConstants::pi * iq / QSIZE_D;
+        for (int ilevel = 0; ilevel < NUM_PHYSICAL_LEV; ++ilevel) {
+          const Real dp = p_int[ilevel + 1] - p_int[ilevel];
+          for (int k = 0; k < level_size; ++k, ++k_qdp) {
+            const Real q =
+                0.5e-3 * (1.0 + std::cos(lat[k]) * std::cos(lon[k] - center));
+            m_state_qdp[k_qdp] = q * dp;
+          }
+        }
+      }
+    }
+  }
+}
+
+} // namespace Homme
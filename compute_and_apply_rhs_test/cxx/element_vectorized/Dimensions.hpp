@@ -0,0 +1,56 @@
+#ifndef HOMMEXX_DIMENSIONS_HPP
+#define HOMMEXX_DIMENSIONS_HPP
+
+#include "config.h.c"
+
+#include <Kokkos_Core.hpp>
+
+namespace Homme {
+
+// In this variant the lanes of a Scalar hold the same (igp, jgp, level) point
+// of VECTOR_SIZE consecutive elements, so the levels are not packed (and not
+// padded), while the number of elements is rounded up to a multiple of
+// VECTOR_SIZE.
+
+// Until whenever CUDA supports constexpr properly
+#ifdef CUDA_BUILD
+
+#define VECTOR_SIZE         1
+
+#define NUM_PHYSICAL_LEV    PLEV
+#define NUM_TIME_LEVELS     3
+#define Q_NUM_TIME_LEVELS   2
+
+#define NUM_LEV             NUM_PHYSICAL_LEV
+#define NUM_LEV_P           (NUM_LEV + 1)
+#define NUM_INTERFACE_LEV   NUM_LEV_P
+
+#else
+
+#if   (AVX_VERSION == 0)
+static constexpr const int VECTOR_SIZE = 1;
+#elif (AVX_VERSION == 1 || AVX_VERSION == 2)
+static constexpr const int VECTOR_SIZE = 4;
+#elif (AVX_VERSION == 512)
+static constexpr const int VECTOR_SIZE = 8;
+#endif
+
+static constexpr const int NUM_PHYSICAL_LEV = PLEV;
+static constexpr const int NUM_LEV = NUM_PHYSICAL_LEV;
+
+static constexpr const int NUM_INTERFACE_LEV = NUM_PHYSICAL_LEV + 1;
+static constexpr const int NUM_LEV_P = NUM_INTERFACE_LEV;
+
+static constexpr const int NUM_TIME_LEVELS = 3;
+static constexpr const int Q_NUM_TIME_LEVELS = 2;
+
+#endif // CUDA_BUILD
+
+// Number of element packs needed to hold num_elems elements
+inline int num_elem_packs(const int num_elems) {
+  return (num_elems + VECTOR_SIZE - 1) / VECTOR_SIZE;
+}
+
+} // namespace TinMan
+
+#endif // HOMMEXX_DIMENSIONS_HPP
@@ -0,0 +1,522 @@
+#include "Elements.hpp"
+#include "Utility.hpp"
+
+#include <assert.h>
+
+namespace Homme {
+
+void Elements::init(const int num_elems, const int qsize) {
+  assert(qsize >= 0 && qsize <= QSIZE_D);
+  m_num_elems = num_elems;
+  m_num_elem_packs = Homme::num_elem_packs(num_elems);
+  m_qsize = qsize;
+
+  buffers.init(m_num_elem_packs);
+
+  m_fcor = ExecViewManaged<Scalar * [NP][NP]>("FCOR", m_num_elem_packs);
+  m_spheremp =
+      ExecViewManaged<Scalar * [NP][NP]>("SPHEREMP", m_num_elem_packs);
+  m_metdet = ExecViewManaged<Scalar * [NP][NP]>("METDET", m_num_elem_packs);
+  m_phis = ExecViewManaged<Scalar * [NP][NP]>("PHIS", m_num_elem_packs);
+
+  m_d = ExecViewManaged<Scalar * [2][2][NP][NP]>("D - metric tensor",
+                                                 m_num_elem_packs);
+  m_dinv = ExecViewManaged<Scalar * [2][2][NP][NP]>(
+      "DInv - inverse metric tensor", m_num_elem_packs);
+
+  m_omega_p =
+      ExecViewManaged<Scalar * [NP][NP][NUM_LEV]>("Omega P", m_num_elem_packs);
+  m_pecnd =
+      ExecViewManaged<Scalar * [NP][NP][NUM_LEV]>("PECND", m_num_elem_packs);
+  m_phi = ExecViewManaged<Scalar * [NP][NP][NUM_LEV]>("PHI", m_num_elem_packs);
+  m_derived_un0 = ExecViewManaged<Scalar * [NP][NP][NUM_LEV]>(
+      "Derived Lateral Velocity 1", m_num_elem_packs);
+  m_derived_vn0 = ExecViewManaged<Scalar * [NP][NP][NUM_LEV]>(
+      "Derived Lateral Velocity 2", m_num_elem_packs);
+
+  m_u = ExecViewManaged<Scalar * [NUM_TIME_LEVELS][NP][NP][NUM_LEV]>(
+      "Lateral Velocity 1", m_num_elem_packs);
+  m_v = ExecViewManaged<Scalar * [NUM_TIME_LEVELS][NP][NP][NUM_LEV]>(
+      "Lateral Velocity 2", m_num_elem_packs);
+  m_t = ExecViewManaged<Scalar * [NUM_TIME_LEVELS][NP][NP][NUM_LEV]>(
+      "Temperature", m_num_elem_packs);
+  m_dp3d = ExecViewManaged<Scalar * [NUM_TIME_LEVELS][NP][NP][NUM_LEV]>(
+      "DP3D", m_num_elem_packs);
+
+  m_qdp = ExecViewManaged<Scalar * * * [NP][NP][NUM_LEV]>(
+      "qdp", m_num_elem_packs, Q_NUM_TIME_LEVELS, m_qsize);
+  m_eta_dot_dpdn = ExecViewManaged<Scalar * [NP][NP][NUM_LEV_P]>(
+      "eta_dot_dpdn", m_num_elem_packs);
+}
+
+void Elements::init_2d(CF90Ptr &D, CF90Ptr &Dinv, CF90Ptr &fcor,
+                       CF90Ptr &spheremp, CF90Ptr &metdet, CF90Ptr &phis) {
+  ExecViewManaged<Scalar *[NP][NP]>::HostMirror h_fcor =
+      Kokkos::create_mirror_view(m_fcor);
+  ExecViewManaged<Scalar *[NP][NP]>::HostMirror h_metdet =
+      Kokkos::create_mirror_view(m_metdet);
+  ExecViewManaged<Scalar *[NP][NP]>::HostMirror h_spheremp =
+      Kokkos::create_mirror_view(m_spheremp);
+  ExecViewManaged<Scalar *[NP][NP]>::HostMirror h_phis =
+      Kokkos::create_mirror_view(m_phis);
+
+  ExecViewManaged<Scalar *[2][2][NP][NP]>::HostMirror h_d =
+      Kokkos::create_mirror_view(m_d);
+  ExecViewManaged<Scalar *[2][2][NP][NP]>::HostMirror h_dinv =
+      Kokkos::create_mirror_view(m_dinv);
+
+  for (int ie = 0; ie < m_num_elem_packs; ++ie) {
+    for (int iv = 0; iv < VECTOR_SIZE; ++iv) {
+      // 2d scalars
+      int k_scalars = f90_elem(ie, iv) * NP * NP;
+      for (int igp = 0; igp < NP; ++igp) {
+        for (int jgp = 0; jgp < NP; ++jgp, ++k_scalars) {
+          h_fcor(ie, igp, jgp)[iv] = fcor[k_scalars];
+          h_spheremp(ie, igp, jgp)[iv] = spheremp[k_scalars];
+          h_metdet(ie, igp, jgp)[iv] = metdet[k_scalars];
+          h_phis(ie, igp, jgp)[iv] = phis[k_scalars];
+        }
+      }
+
+      // 2d tensors
+      int k_tensors = f90_elem(ie, iv) * 2 * 2 * NP * NP;
+      for (int idim = 0; idim < 2; ++idim) {
+        for (int jdim = 0; jdim < 2; ++jdim) {
+          for (int igp = 0; igp < NP; ++igp) {
+            for (int jgp = 0; jgp < NP; ++jgp, ++k_tensors) {
+              h_d(ie, idim, jdim, igp, jgp)[iv] = D[k_tensors];
+              h_dinv(ie, idim, jdim, igp, jgp)[iv] = Dinv[k_tensors];
+            }
+          }
+        }
+      }
+    }
+  }
+
+  Kokkos::deep_copy(m_fcor, h_fcor);
+  Kokkos::deep_copy(m_metdet, h_metdet);
+  Kokkos::deep_copy(m_spheremp, h_spheremp);
+  Kokkos::deep_copy(m_phis, h_phis);
+
+  Kokkos::deep_copy(m_d, h_d);
+  Kokkos::deep_copy(m_dinv, h_dinv);
+}
+
+void Elements::random_init(const int num_elems, const int qsize,
+                           std::mt19937_64 &engine) {
+  init(num_elems, qsize);
+  constexpr const Real min_value = 0.015625;
+  std::uniform_real_distribution<Real> random_dist(min_value, 1.0);
+
+  // The padding lanes get random values as well, which are just as harmless
+  // as copies of the last element
+  genRandArray(m_fcor, engine, random_dist);
+  genRandArray(m_spheremp, engine, random_dist);
+  genRandArray(m_metdet, engine, random_dist);
+  genRandArray(m_phis, engine, random_dist);
+  genRandArray(m_d, engine, random_dist);
+  genRandArray(m_omega_p, engine, random_dist);
+  genRandArray(m_pecnd, engine, random_dist);
+  genRandArray(m_phi, engine, random_dist);
+  genRandArray(m_derived_un0, engine, random_dist);
+  genRandArray(m_derived_vn0, engine, random_dist);
+  genRandArray(m_u, engine, random_dist);
+  genRandArray(m_v, engine, random_dist);
+  genRandArray(m_t, engine, random_dist);
+  genRandArray(m_dp3d, engine, random_dist);
+  genRandArray(m_qdp, engine, random_dist);
+  genRandArray(m_eta_dot_dpdn, engine, random_dist);
+
+  ExecViewManaged<Scalar *[2][2][NP][NP]>::HostMirror h_d =
+      Kokkos::create_mirror_view(m_d);
+  ExecViewManaged<Scalar *[2][2][NP][NP]>::HostMirror h_dinv =
+      Kokkos::create_mirror_view(m_dinv);
+
+  for (int ie = 0; ie < m_num_elem_packs; ++ie) {
+    for (int iv = 0; iv < VECTOR_SIZE; ++iv) {
+      for (int igp = 0; igp < NP; ++igp) {
+        for (int jgp = 0; jgp < NP; ++jgp) {
+          Real determinant = 0.0;
+          while (std::abs(determinant) < min_value) {
+            // 2d tensors
+            for (int idim = 0; idim < 2; ++idim) {
+              for (int jdim = 0; jdim < 2; ++jdim) {
+                h_d(ie, idim, jdim, igp, jgp)[iv] = random_dist(engine);
+              }
+            }
+            const Real d00 = h_d(ie, 0, 0, igp, jgp)[iv];
+            const Real d01 = h_d(ie, 0, 1, igp, jgp)[iv];
+            const Real d10 = h_d(ie, 1, 0, igp, jgp)[iv];
+            const Real d11 = h_d(ie, 1, 1, igp, jgp)[iv];
+            determinant = d00 * d11 - d01 * d10;
+            h_dinv(ie, 0, 0, igp, jgp)[iv] = d11 / determinant;
+            h_dinv(ie, 0, 1, igp, jgp)[iv] = -d10 / determinant;
+            h_dinv(ie, 1, 0, igp, jgp)[iv] = -d01 / determinant;
+            h_dinv(ie, 1, 1, igp, jgp)[iv] = d00 / determinant;
+          }
+        }
+      }
+    }
+  }
+
+  Kokkos::deep_copy(m_d, h_d);
+  Kokkos::deep_copy(m_dinv, h_dinv);
+  return;
+}
+
+void Elements::pull_from_f90_pointers(
+    CF90Ptr &state_v, CF90Ptr &state_t, CF90Ptr &state_dp3d,
+    CF90Ptr &derived_phi, CF90Ptr &derived_pecnd, CF90Ptr &derived_omega_p,
+    CF90Ptr &derived_v, CF90Ptr &derived_eta_dot_dpdn, CF90Ptr &state_qdp) {
+  pull_3d(derived_phi, derived_pecnd, derived_omega_p, derived_v);
+  pull_4d(state_v, state_t, state_dp3d);
+  pull_eta_dot(derived_eta_dot_dpdn);
+  pull_qdp(state_qdp);
+}
+
+void Elements::pull_3d(CF90Ptr &derived_phi, CF90Ptr &derived_pecnd,
+                       CF90Ptr &derived_omega_p, CF90Ptr &derived_v) {
+  ExecViewManaged<Scalar *[NP][NP][NUM_LEV]>::HostMirror h_omega_p =
+      Kokkos::create_mirror_view(m_omega_p);
+  ExecViewManaged<Scalar *[NP][NP][NUM_LEV]>::HostMirror h_pecnd =
+      Kokkos::create_mirror_view(m_pecnd);
+  ExecViewManaged<Scalar *[NP][NP][NUM_LEV]>::HostMirror h_phi =
+      Kokkos::create_mirror_view(m_phi);
+  ExecViewManaged<Scalar *[NP][NP][NUM_LEV]>::HostMirror h_derived_un0 =
+      Kokkos::create_mirror_view(m_derived_un0);
+  ExecViewManaged<Scalar *[NP][NP][NUM_LEV]>::HostMirror h_derived_vn0 =
+      Kokkos::create_mirror_view(m_derived_vn0);
+  for (int ie = 0; ie < m_num_elem_packs; ++ie) {
+    for (int iv = 0; iv < VECTOR_SIZE; ++iv) {
+      int k_3d_scalars = f90_elem(ie, iv) * NUM_PHYSICAL_LEV * NP * NP;
+      int k_3d_vectors = 2 * k_3d_scalars;
+      for (int ilev = 0; ilev < NUM_PHYSICAL_LEV; ++ilev) {
+        for (int igp = 0; igp < NP; ++igp) {
+          for (int jgp = 0; jgp < NP; ++jgp, ++k_3d_scalars) {
+            h_omega_p(ie, igp, jgp, ilev)[iv] = derived_omega_p[k_3d_scalars];
+            h_pecnd(ie, igp, jgp, ilev)[iv] = derived_pecnd[k_3d_scalars];
+            h_phi(ie, igp, jgp, ilev)[iv] = derived_phi[k_3d_scalars];
+          }
+        }
+
+        for (int igp = 0; igp < NP; ++igp) {
+          for (int jgp = 0; jgp < NP; ++jgp, ++k_3d_vectors) {
+            h_derived_un0(ie, igp, jgp, ilev)[iv] = derived_v[k_3d_vectors];
+          }
+        }
+        for (int igp = 0; igp < NP; ++igp) {
+          for (int jgp = 0; jgp < NP; ++jgp, ++k_3d_vectors) {
+            h_derived_vn0(ie, igp, jgp, ilev)[iv] = derived_v[k_3d_vectors];
+          }
+        }
+      }
+    }
+  }
+  Kokkos::deep_copy(m_omega_p, h_omega_p);
+  Kokkos::deep_copy(m_pecnd, h_pecnd);
+  Kokkos::deep_copy(m_phi, h_phi);
+  Kokkos::deep_copy(m_derived_un0, h_derived_un0);
+  Kokkos::deep_copy(m_derived_vn0, h_derived_vn0);
+}
+
+void Elements::pull_4d(CF90Ptr &state_v, CF90Ptr &state_t,
+                       CF90Ptr &state_dp3d) {
+  ExecViewManaged<Scalar *[NUM_TIME_LEVELS][NP][NP][NUM_LEV]>::HostMirror h_u =
+      Kokkos::create_mirror_view(m_u);
+  ExecViewManaged<Scalar *[NUM_TIME_LEVELS][NP][NP][NUM_LEV]>::HostMirror h_v =
+      Kokkos::create_mirror_view(m_v);
+  ExecViewManaged<Scalar *[NUM_TIME_LEVELS][NP][NP][NUM_LEV]>::HostMirror h_t =
+      Kokkos::create_mirror_view(m_t);
+  ExecViewManaged<Scalar *[NUM_TIME_LEVELS][NP][NP][NUM_LEV]>::HostMirror
+  h_dp3d = Kokkos::create_mirror_view(m_dp3d);
+  for (int ie = 0; ie < m_num_elem_packs; ++ie) {
+    for (int iv = 0; iv < VECTOR_SIZE; ++iv) {
+      int k_4d_scalars =
+          f90_elem(ie, iv) * NUM_TIME_LEVELS * NUM_PHYSICAL_LEV * NP * NP;
+      int k_4d_vectors = 2 * k_4d_scalars;
+      for (int tl = 0; tl < NUM_TIME_LEVELS; ++tl) {
+        for (int ilev = 0; ilev < NUM_PHYSICAL_LEV; ++ilev) {
+          for (int igp = 0; igp < NP; ++igp) {
+            for (int jgp = 0; jgp < NP; ++jgp, ++k_4d_scalars) {
+              h_dp3d(ie, tl, igp, jgp, ilev)[iv] = state_dp3d[k_4d_scalars];
+              h_t(ie, tl, igp, jgp, ilev)[iv] = state_t[k_4d_scalars];
+            }
+          }
+
+          for (int igp = 0; igp < NP; ++igp) {
+            for (int jgp = 0; jgp < NP; ++jgp, ++k_4d_vectors) {
+              h_u(ie, tl, igp, jgp, ilev)[iv] = state_v[k_4d_vectors];
+            }
+          }
+          for (int igp = 0; igp < NP; ++igp) {
+            for (int jgp = 0; jgp < NP; ++jgp, ++k_4d_vectors) {
+              h_v(ie, tl, igp, jgp, ilev)[iv] = state_v[k_4d_vectors];
+            }
+          }
+        }
+      }
+    }
+  }
+  Kokkos::deep_copy(m_u, h_u);
+  Kokkos::deep_copy(m_v, h_v);
+  Kokkos::deep_copy(m_t, h_t);
+  Kokkos::deep_copy(m_dp3d, h_dp3d);
+}
+
+void Elements::pull_eta_dot(CF90Ptr &derived_eta_dot_dpdn) {
+  ExecViewManaged<Scalar *[NP][NP][NUM_LEV_P]>::HostMirror h_eta_dot_dpdn =
+      Kokkos::create_mirror_view(m_eta_dot_dpdn);
+  for (int ie = 0; ie < m_num_elem_packs; ++ie) {
+    for (int iv = 0; iv < VECTOR_SIZE; ++iv) {
+      int k_eta_dot_dp_dn = f90_elem(ie, iv) * NUM_INTERFACE_LEV * NP * NP;
+      for (int ilev = 0; ilev < NUM_INTERFACE_LEV; ++ilev) {
+        for (int igp = 0; igp < NP; ++igp) {
+          for (int jgp = 0; jgp < NP; ++jgp, ++k_eta_dot_dp_dn) {
+            h_eta_dot_dpdn(ie, igp, jgp, ilev)[iv] =
+                derived_eta_dot_dpdn[k_eta_dot_dp_dn];
+          }
+        }
+      }
+    }
+  }
+  Kokkos::deep_copy(m_eta_dot_dpdn, h_eta_dot_dpdn);
+}
+
+// The F90 array is always dimensioned for QSIZE_D tracers;
+// the slots past qsize are skipped
+void Elements::pull_qdp(CF90Ptr &state_qdp) {
+  ExecViewManaged<Scalar ***[NP][NP][NUM_LEV]>::HostMirror h_qdp =
+      Kokkos::create_mirror_view(m_qdp);
+  const int unused_qdp = (QSIZE_D - m_qsize) * NUM_PHYSICAL_LEV * NP * NP;
+  for (int ie = 0; ie < m_num_elem_packs; ++ie) {
+    for (int iv = 0; iv < VECTOR_SIZE; ++iv) {
+      int k_qdp = f90_elem(ie, iv) * Q_NUM_TIME_LEVELS * QSIZE_D *
+                  NUM_PHYSICAL_LEV * NP * NP;
+      for (int qni = 0; qni < Q_NUM_TIME_LEVELS; ++qni, k_qdp += unused_qdp) {
+        for (int iq = 0; iq < m_qsize; ++iq) {
+          for (int ilev = 0; ilev < NUM_PHYSICAL_LEV; ++ilev) {
+            for (int igp = 0; igp < NP; ++igp) {
+              for (int jgp = 0; jgp < NP; ++jgp, ++k_qdp) {
+                h_qdp(ie, qni, iq, igp, jgp, ilev)[iv] = state_qdp[k_qdp];
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+  Kokkos::deep_copy(m_qdp, h_qdp);
+}
+
+void Elements::push_to_f90_pointers(F90Ptr &state_v, F90Ptr &state_t,
+                                    F90Ptr &state_dp3d, F90Ptr &derived_phi,
+                                    F90Ptr &derived_pecnd,
+                                    F90Ptr &derived_omega_p, F90Ptr &derived_v,
+                                    F90Ptr &derived_eta_dot_dpdn,
+                                    F90Ptr &state_qdp) const {
+  push_3d(derived_phi, derived_pecnd, derived_omega_p, derived_v);
+  push_4d(state_v, state_t, state_dp3d);
+  push_eta_dot(derived_eta_dot_dpdn);
+  push_qdp(state_qdp);
+}
+
+// Only the lanes of actual elements are pushed; the padding lanes are dropped
+void Elements::push_3d(F90Ptr &derived_phi, F90Ptr &derived_pecnd,
+                       F90Ptr &derived_omega_p, F90Ptr &derived_v) const {
+  ExecViewManaged<Scalar *[NP][NP][NUM_LEV]>::HostMirror h_omega_p =
+      Kokkos::create_mirror_view(m_omega_p);
+  ExecViewManaged<Scalar *[NP][NP][NUM_LEV]>::HostMirror h_pecnd =
+      Kokkos::create_mirror_view(m_pecnd);
+  ExecViewManaged<Scalar *[NP][NP][NUM_LEV]>::HostMirror h_phi =
+      Kokkos::create_mirror_view(m_phi);
+  ExecViewManaged<Scalar *[NP][NP][NUM_LEV]>::HostMirror h_derived_un0 =
+      Kokkos::create_mirror_view(m_derived_un0);
+  ExecViewManaged<Scalar *[NP][NP][NUM_LEV]>::HostMirror h_derived_vn0 =
+      Kokkos::create_mirror_view(m_derived_vn0);
+
+  Kokkos::deep_copy(h_omega_p, m_omega_p);
+  Kokkos::deep_copy(h_pecnd, m_pecnd);
+  Kokkos::deep_copy(h_phi, m_phi);
+  Kokkos::deep_copy(h_derived_un0, m_derived_un0);
+  Kokkos::deep_copy(h_derived_vn0, m_derived_vn0);
+  for (int elem = 0, k_3d_scalars = 0, k_3d_vectors = 0; elem < m_num_elems;
+       ++elem) {
+    const int ie = elem / VECTOR_SIZE;
+    const int iv = elem % VECTOR_SIZE;
+    for (int ilev = 0; ilev < NUM_PHYSICAL_LEV; ++ilev) {
+      for (int igp = 0; igp < NP; ++igp) {
+        for (int jgp = 0; jgp < NP; ++jgp, ++k_3d_scalars) {
+          derived_omega_p[k_3d_scalars] = h_omega_p(ie, igp, jgp, ilev)[iv];
+          derived_pecnd[k_3d_scalars] = h_pecnd(ie, igp, jgp, ilev)[iv];
+          derived_phi[k_3d_scalars] = h_phi(ie, igp, jgp, ilev)[iv];
+        }
+      }
+
+      for (int igp = 0; igp < NP; ++igp) {
+        for (int jgp = 0; jgp < NP; ++jgp, ++k_3d_vectors) {
+          derived_v[k_3d_vectors] = h_derived_un0(ie, igp, jgp, ilev)[iv];
+        }
+      }
+      for (int igp = 0; igp < NP; ++igp) {
+        for (int jgp = 0; jgp < NP; ++jgp, ++k_3d_vectors) {
+          derived_v[k_3d_vectors] = h_derived_vn0(ie, igp, jgp, ilev)[iv];
+        }
+      }
+    }
+  }
+}
+
+void Elements::push_4d(F90Ptr &state_v, F90Ptr &state_t,
+                       F90Ptr &state_dp3d) const {
+  ExecViewManaged<Scalar *[NUM_TIME_LEVELS][NP][NP][NUM_LEV]>::HostMirror h_u =
+      Kokkos::create_mirror_view(m_u);
+  ExecViewManaged<Scalar *[NUM_TIME_LEVELS][NP][NP][NUM_LEV]>::HostMirror h_v =
+      Kokkos::create_mirror_view(m_v);
+  ExecViewManaged<Scalar *[NUM_TIME_LEVELS][NP][NP][NUM_LEV]>::HostMirror h_t =
+      Kokkos::create_mirror_view(m_t);
+  ExecViewManaged<Scalar *[NUM_TIME_LEVELS][NP][NP][NUM_LEV]>::HostMirror
+  h_dp3d = Kokkos::create_mirror_view(m_dp3d);
+  Kokkos::deep_copy(h_u, m_u);
+  Kokkos::deep_copy(h_v, m_v);
+  Kokkos::deep_copy(h_t, m_t);
+  Kokkos::deep_copy(h_dp3d, m_dp3d);
+  for (int elem = 0, k_4d_scalars = 0, k_4d_vectors = 0; elem < m_num_elems;
+       ++elem) {
+    const int ie = elem / VECTOR_SIZE;
+    const int iv = elem % VECTOR_SIZE;
+    for (int tl = 0; tl < NUM_TIME_LEVELS; ++tl) {
+      for (int ilev = 0; ilev < NUM_PHYSICAL_LEV; ++ilev) {
+        for (int igp = 0; igp < NP; ++igp) {
+          for (int jgp = 0; jgp < NP; ++jgp, ++k_4d_scalars) {
+            state_dp3d[k_4d_scalars] = h_dp3d(ie, tl, igp, jgp, ilev)[iv];
+            state_t[k_4d_scalars] = h_t(ie, tl, igp, jgp, ilev)[iv];
+          }
+        }
+
+        for (int igp = 0; igp < NP; ++igp) {
+          for (int jgp = 0; jgp < NP; ++jgp, ++k_4d_vectors) {
+            state_v[k_4d_vectors] = h_u(ie, tl, igp, jgp, ilev)[iv];
+          }
+        }
+        for (int igp = 0; igp < NP; ++igp) {
+          for (int jgp = 0; jgp < NP; ++jgp, ++k_4d_vectors) {
+            state_v[k_4d_vectors] = h_v(ie, tl, igp, jgp, ilev)[iv];
+          }
+        }
+      }
+    }
+  }
+}
+
+void Elements::push_eta_dot(F90Ptr &derived_eta_dot_dpdn) const {
+  ExecViewManaged<Scalar *[NP][NP][NUM_LEV_P]>::HostMirror h_eta_dot_dpdn =
+      Kokkos::create_mirror_view(m_eta_dot_dpdn);
+  Kokkos::deep_copy(h_eta_dot_dpdn, m_eta_dot_dpdn);
+  for (int elem = 0, k_eta_dot_dp_dn = 0; elem < m_num_elems; ++elem) {
+    const int ie = elem / VECTOR_SIZE;
+    const int iv = elem % VECTOR_SIZE;
+    for (int ilev = 0; ilev < NUM_INTERFACE_LEV; ++ilev) {
+      for (int igp = 0; igp < NP; ++igp) {
+        for (int jgp = 0; jgp < NP; ++jgp, ++k_eta_dot_dp_dn) {
+          derived_eta_dot_dpdn[k_eta_dot_dp_dn] =
+              h_eta_dot_dpdn(ie, igp, jgp, ilev)[iv];
+        }
+      }
+    }
+  }
+}
+
+void Elements::push_qdp(F90Ptr &state_qdp) const {
+  ExecViewManaged<Scalar ***[NP][NP][NUM_LEV]>::HostMirror h_qdp =
+      Kokkos::create_mirror_view(m_qdp);
+  Kokkos::deep_copy(h_qdp, m_qdp);
+  const int unused_qdp = (QSIZE_D - m_qsize) * NUM_PHYSICAL_LEV * NP * NP;
+  for (int elem = 0, k_qdp = 0; elem < m_num_elems; ++elem) {
+    const int ie = elem / VECTOR_SIZE;
+    const int iv = elem % VECTOR_SIZE;
+    for (int qni = 0; qni < Q_NUM_TIME_LEVELS; ++qni, k_qdp += unused_qdp) {
+      for (int iq = 0; iq < m_qsize; ++iq) {
+        for (int ilev = 0; ilev < NUM_PHYSICAL_LEV; ++ilev) {
+          for (int igp = 0; igp < NP; ++igp) {
+            for (int jgp = 0; jgp < NP; ++jgp, ++k_qdp) {
+              state_qdp[k_qdp] = h_qdp(ie, qni, iq, igp, jgp, ilev)[iv];
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+void Elements::d(Real *d_ptr, int ie) const {
+  ExecViewManaged<Scalar *[2][2][NP][NP]>::HostMirror d_host =
+      Kokkos::create_mirror_view(m_d);
+  Kokkos::deep_copy(d_host, m_d);
+  HostViewUnmanaged<Real[2][2][NP][NP]> d_wrapper(d_ptr);
+  for (int m = 0; m < 2; ++m) {
+    for (int n = 0; n < 2; ++n) {
+      for (int igp = 0; igp < NP; ++igp) {
+        for (int jgp = 0; jgp < NP; ++jgp) {
+          d_wrapper(m, n, jgp, igp) = d_host(ie / VECTOR_SIZE, n, m, igp,
+                                             jgp)[ie % VECTOR_SIZE];
+        }
+      }
+    }
+  }
+}
+
+void Elements::dinv(Real *dinv_ptr, int ie) const {
+  ExecViewManaged<Scalar *[2][2][NP][NP]>::HostMirror dinv_host =
+      Kokkos::create_mirror_view(m_dinv);
+  Kokkos::deep_copy(dinv_host, m_dinv);
+  HostViewUnmanaged<Real[2][2][NP][NP]> dinv_wrapper(dinv_ptr);
+  for (int m = 0; m < 2; ++m) {
+    for (int n = 0; n < 2; ++n) {
+      for (int igp = 0; igp < NP; ++igp) {
+        for (int jgp = 0; jgp < NP; ++jgp) {
+          dinv_wrapper(m, n, igp, jgp) = dinv_host(ie / VECTOR_SIZE, m, n, igp,
+                                                   jgp)[ie % VECTOR_SIZE];
+        }
+      }
+    }
+  }
+}
+
+void Elements::BufferViews::init(const int num_elem_packs) {
+  pressure = ExecViewManaged<Scalar * [NP][NP][NUM_LEV]>("Pressure buffer",
+                                                         num_elem_packs);
+  pressure_grad = ExecViewManaged<Scalar * [2][NP][NP][NUM_LEV]>(
+      "Gradient of pressure", num_elem_packs);
+  temperature_virt = ExecViewManaged<Scalar * [NP][NP][NUM_LEV]>(
+      "Virtual Temperature", num_elem_packs);
+  temperature_grad = ExecViewManaged<Scalar * [2][NP][NP][NUM_LEV]>(
+      "Gradient of temperature", num_elem_packs);
+  omega_p = ExecViewManaged<Scalar * [NP][NP][NUM_LEV]>("Omega_P buffer",
+                                                        num_elem_packs);
+  vdp = ExecViewManaged<Scalar * [2][NP][NP][NUM_LEV]>("dp3d * u",
+                                                       num_elem_packs);
+  div_vdp = ExecViewManaged<Scalar * [NP][NP][NUM_LEV]>(
+      "Divergence of dp3d * u", num_elem_packs);
+  ephi = ExecViewManaged<Scalar * [NP][NP][NUM_LEV]>(
+      "Kinetic Energy + Geopotential Energy", num_elem_packs);
+  energy_grad = ExecViewManaged<Scalar * [2][NP][NP][NUM_LEV]>(
+      "Gradient of ephi", num_elem_packs);
+  vorticity =
+      ExecViewManaged<Scalar * [NP][NP][NUM_LEV]>("Vorticity", num_elem_packs);
+  eta_dot_dpdn = ExecViewManaged<Scalar * [NP][NP][NUM_LEV_P]>(
+      "Flux through the interfaces", num_elem_packs);
+
+  div_buf = ExecViewManaged<Scalar * [2][NP][NP][NUM_LEV]>("Divergence Buffer",
+                                                           num_elem_packs);
+  grad_buf = ExecViewManaged<Scalar * [2][NP][NP][NUM_LEV]>("Gradient Buffer",
+                                                            num_elem_packs);
+  vort_buf = ExecViewManaged<Scalar * [2][NP][NP][NUM_LEV]>("Vorticity Buffer",
+                                                            num_elem_packs);
+}
+
+Elements &get_elements() {
+  static Elements r;
+  return r;
+}
+
+} // namespace Homme
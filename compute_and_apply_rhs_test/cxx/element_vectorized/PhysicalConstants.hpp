@@ -0,0 +1,25 @@
+#ifndef HOMMEXX_PHYSICAL_CONSTANTS_HPP
+#define HOMMEXX_PHYSICAL_CONSTANTS_HPP
+
+#include "Types.hpp"
+
+namespace Homme
+{
+
+struct PhysicalConstants
+{
+  static constexpr Real pi            = 3.141592653589793238462643383279;
+  static constexpr Real rearth        = 6.376e6;
+  static constexpr Real omega         = 7.292e-5;
+  static constexpr Real p0            = 100000.0;
+  static constexpr Real Rwater_vapor  = 461.5;
+  static constexpr Real Cpwater_vapor = 1870.0;
+  static constexpr Real Rgas          = 287.04;
+  static constexpr Real cp            = 1005.0;
+  static constexpr Real kappa         = Rgas / cp;
+  static constexpr Real rrearth       = 1.0 / 6.376e6;
+};
+
+} // namespace Homme
+
+#endif // HOMMEXX_PHYSICAL_CONSTANTS_HPP
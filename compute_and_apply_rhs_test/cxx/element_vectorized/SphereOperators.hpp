@@ -0,0 +1,212 @@
+#ifndef HOMMEXX_SPHERE_OPERATORS_HPP
+#define HOMMEXX_SPHERE_OPERATORS_HPP
+
+#include "Types.hpp"
+#include "Elements.hpp"
+#include "Dimensions.hpp"
+#include "KernelVariables.hpp"
+#include "PhysicalConstants.hpp"
+
+#include <Kokkos_Core.hpp>
+
+namespace Homme {
+
+// The operators act on one pack of elements: every Scalar holds the same
+// point of VECTOR_SIZE elements, including the metric terms, while dvv is
+// shared by all elements and stays a Real. The loops are the same as in the
+// level packed variant, with NUM_LEV now counting single levels.
+
+KOKKOS_INLINE_FUNCTION void
+gradient_sphere(const KernelVariables &kv,
+                const ExecViewUnmanaged<const Scalar* [2][2][NP][NP]>          dinv,
+                const ExecViewUnmanaged<const Real          [NP][NP]>          dvv,
+                const ExecViewUnmanaged<const Scalar        [NP][NP][NUM_LEV]> scalar,
+                      ExecViewUnmanaged<      Scalar*    [2][NP][NP][NUM_LEV]> v_buf,
+                      ExecViewUnmanaged<      Scalar     [2][NP][NP][NUM_LEV]> grad_s)
+{
+  constexpr int contra_iters = NP * NP;
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, contra_iters),
+                       [&](const int loop_idx) {
+    const int igp = loop_idx / NP;
+    const int jgp = loop_idx % NP;
+    Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
+      Scalar dsdx, dsdy;
+      for (int kgp = 0; kgp < NP; ++kgp) {
+        dsdx = fma(dvv(jgp, kgp), scalar(igp, kgp, ilev), dsdx);
+        dsdy = fma(dvv(jgp, kgp), scalar(kgp, igp, ilev), dsdy);
+      }
+      v_buf(kv.ie, 0, igp, jgp, ilev) = dsdx * PhysicalConstants::rrearth;
+      v_buf(kv.ie, 1, jgp, igp, ilev) = dsdy * PhysicalConstants::rrearth;
+    });
+  });
+  kv.team_barrier();
+
+  constexpr int grad_iters = NP * NP;
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, grad_iters),
+                       [&](const int loop_idx) {
+    const int igp = loop_idx / NP;
+    const int jgp = loop_idx % NP;
+    const Scalar dinv_00 = dinv(kv.ie, 0, 0, igp, jgp);
+    const Scalar dinv_01 = dinv(kv.ie, 0, 1, igp, jgp);
+    const Scalar dinv_10 = dinv(kv.ie, 1, 0, igp, jgp);
+    const Scalar dinv_11 = dinv(kv.ie, 1, 1, igp, jgp);
+    Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
+      grad_s(0, igp, jgp, ilev) =
+          fma(dinv_00, v_buf(kv.ie, 0, igp, jgp, ilev),
+              dinv_01 * v_buf(kv.ie, 1, igp, jgp, ilev));
+      grad_s(1, igp, jgp, ilev) =
+          fma(dinv_10, v_buf(kv.ie, 0, igp, jgp, ilev),
+              dinv_11 * v_buf(kv.ie, 1, igp, jgp, ilev));
+    });
+  });
+  kv.team_barrier();
+}
+
+KOKKOS_INLINE_FUNCTION void gradient_sphere_update(
+    const KernelVariables &kv,
+    const ExecViewUnmanaged<const Scalar* [2][2][NP][NP]>          dinv,
+    const ExecViewUnmanaged<const Real          [NP][NP]>          dvv,
+    const ExecViewUnmanaged<const Scalar        [NP][NP][NUM_LEV]> scalar,
+          ExecViewUnmanaged<      Scalar*    [2][NP][NP][NUM_LEV]> v_buf,
+          ExecViewUnmanaged<      Scalar     [2][NP][NP][NUM_LEV]> grad_s)
+{
+  constexpr int contra_iters = NP * NP;
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, contra_iters),
+                       [&](const int loop_idx) {
+    const int igp = loop_idx / NP;
+    const int jgp = loop_idx % NP;
+    Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
+      Scalar dsdx, dsdy;
+      for (int kgp = 0; kgp < NP; ++kgp) {
+        dsdx = fma(dvv(jgp, kgp), scalar(igp, kgp, ilev), dsdx);
+        dsdy = fma(dvv(jgp, kgp), scalar(kgp, igp, ilev), dsdy);
+      }
+      v_buf(kv.ie, 0, igp, jgp, ilev) = dsdx * PhysicalConstants::rrearth;
+      v_buf(kv.ie, 1, jgp, igp, ilev) = dsdy * PhysicalConstants::rrearth;
+    });
+  });
+  kv.team_barrier();
+
+  constexpr int grad_iters = NP * NP;
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, grad_iters),
+                       [&](const int loop_idx) {
+    const int igp = loop_idx / NP;
+    const int jgp = loop_idx % NP;
+    const Scalar dinv_00 = dinv(kv.ie, 0, 0, igp, jgp);
+    const Scalar dinv_01 = dinv(kv.ie, 0, 1, igp, jgp);
+    const Scalar dinv_10 = dinv(kv.ie, 1, 0, igp, jgp);
+    const Scalar dinv_11 = dinv(kv.ie, 1, 1, igp, jgp);
+    Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
+      grad_s(0, igp, jgp, ilev) =
+          fma(dinv_00, v_buf(kv.ie, 0, igp, jgp, ilev),
+              fma(dinv_01, v_buf(kv.ie, 1, igp, jgp, ilev),
+                  grad_s(0, igp, jgp, ilev)));
+      grad_s(1, igp, jgp, ilev) =
+          fma(dinv_10, v_buf(kv.ie, 0, igp, jgp, ilev),
+              fma(dinv_11, v_buf(kv.ie, 1, igp, jgp, ilev),
+                  grad_s(1, igp, jgp, ilev)));
+    });
+  });
+  kv.team_barrier();
+}
+
+KOKKOS_INLINE_FUNCTION void
+divergence_sphere(const KernelVariables &kv,
+                  const ExecViewUnmanaged<const Scalar* [2][2][NP][NP]>          dinv,
+                  const ExecViewUnmanaged<const Scalar*       [NP][NP]>          metdet,
+                  const ExecViewUnmanaged<const Real          [NP][NP]>          dvv,
+                  const ExecViewUnmanaged<const Scalar     [2][NP][NP][NUM_LEV]> v,
+                        ExecViewUnmanaged<      Scalar*    [2][NP][NP][NUM_LEV]> gv_buf,
+                        ExecViewUnmanaged<      Scalar        [NP][NP][NUM_LEV]> div_v)
+{
+  constexpr int contra_iters = NP * NP;
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, contra_iters),
+                       [&](const int loop_idx) {
+    const int igp = loop_idx / NP;
+    const int jgp = loop_idx % NP;
+    // Fold metdet into the metric terms once per point
+    const Scalar &md = metdet(kv.ie, igp, jgp);
+    const Scalar dinv_00 = dinv(kv.ie, 0, 0, igp, jgp) * md;
+    const Scalar dinv_01 = dinv(kv.ie, 0, 1, igp, jgp) * md;
+    const Scalar dinv_10 = dinv(kv.ie, 1, 0, igp, jgp) * md;
+    const Scalar dinv_11 = dinv(kv.ie, 1, 1, igp, jgp) * md;
+    Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
+      gv_buf(kv.ie, 0, igp, jgp, ilev) =
+          fma(dinv_00, v(0, igp, jgp, ilev), dinv_10 * v(1, igp, jgp, ilev));
+      gv_buf(kv.ie, 1, igp, jgp, ilev) =
+          fma(dinv_01, v(0, igp, jgp, ilev), dinv_11 * v(1, igp, jgp, ilev));
+    });
+  });
+  kv.team_barrier();
+
+  // j, l, i -> i, j, k
+  constexpr int div_iters = NP * NP;
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, div_iters),
+                       [&](const int loop_idx) {
+    const int igp = loop_idx / NP;
+    const int jgp = loop_idx % NP;
+    // One packed division per point rather than one per level
+    const Scalar rmetdet =
+        1.0 / metdet(kv.ie, igp, jgp) * PhysicalConstants::rrearth;
+    Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
+      Scalar dudx, dvdy;
+      for (int kgp = 0; kgp < NP; ++kgp) {
+        dudx = fma(dvv(jgp, kgp), gv_buf(kv.ie, 0, igp, kgp, ilev), dudx);
+        dvdy = fma(dvv(igp, kgp), gv_buf(kv.ie, 1, kgp, jgp, ilev), dvdy);
+      }
+      div_v(igp, jgp, ilev) = (dudx + dvdy) * rmetdet;
+    });
+  });
+  kv.team_barrier();
+}
+
+KOKKOS_INLINE_FUNCTION void
+vorticity_sphere(const KernelVariables &kv,
+                 const ExecViewUnmanaged<const Scalar* [2][2][NP][NP]>          d,
+                 const ExecViewUnmanaged<const Scalar*       [NP][NP]>          metdet,
+                 const ExecViewUnmanaged<const Real          [NP][NP]>          dvv,
+                 const ExecViewUnmanaged<const Scalar        [NP][NP][NUM_LEV]> u,
+                 const ExecViewUnmanaged<const Scalar        [NP][NP][NUM_LEV]> v,
+                       ExecViewUnmanaged<      Scalar*    [2][NP][NP][NUM_LEV]> vcov_buf,
+                       ExecViewUnmanaged<      Scalar        [NP][NP][NUM_LEV]> vort)
+{
+  constexpr int covar_iters = NP * NP;
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, covar_iters),
+                       [&](const int loop_idx) {
+    const int igp = loop_idx / NP;
+    const int jgp = loop_idx % NP;
+    const Scalar d_00 = d(kv.ie, 0, 0, jgp, igp);
+    const Scalar d_01 = d(kv.ie, 0, 1, jgp, igp);
+    const Scalar d_10 = d(kv.ie, 1, 0, jgp, igp);
+    const Scalar d_11 = d(kv.ie, 1, 1, jgp, igp);
+    Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
+      vcov_buf(kv.ie, 0, jgp, igp, ilev) =
+          fma(d_00, u(jgp, igp, ilev), d_01 * v(jgp, igp, ilev));
+      vcov_buf(kv.ie, 1, jgp, igp, ilev) =
+          fma(d_10, u(jgp, igp, ilev), d_11 * v(jgp, igp, ilev));
+    });
+  });
+  kv.team_barrier();
+
+  constexpr int vort_iters = NP * NP;
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, vort_iters),
+                       [&](const int loop_idx) {
+    const int igp = loop_idx / NP;
+    const int jgp = loop_idx % NP;
+    const Scalar rmetdet =
+        1.0 / metdet(kv.ie, igp, jgp) * PhysicalConstants::rrearth;
+    Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
+      Scalar dudy, dvdx;
+      for (int kgp = 0; kgp < NP; ++kgp) {
+        dvdx = fma(dvv(jgp, kgp), vcov_buf(kv.ie, 1, igp, kgp, ilev), dvdx);
+        dudy = fma(dvv(igp, kgp), vcov_buf(kv.ie, 0, kgp, jgp, ilev), dudy);
+      }
+      vort(igp, jgp, ilev) = (dvdx - dudy) * rmetdet;
+    });
+  });
+  kv.team_barrier();
+}
+
+} // namespace Homme
+
+#endif // HOMMEXX_SPHERE_OPERATORS_HPP
@@ -0,0 +1,67 @@
+#ifndef HOMMEXX_UTILITY_HPP
+#define HOMMEXX_UTILITY_HPP
+
+#include "Types.hpp"
+
+#include <cmath>
+
+#ifndef NDEBUG
+#define DEBUG_PRINT(...)                                                       \
+  { printf(__VA_ARGS__); }
+#else
+#define DEBUG_PRINT(...)                                                       \
+  {}
+#endif
+
+namespace Homme {
+
+// Division by a per-point quantity (e.g. the pressure). Configuring with
+// HOMMEXX_FAST_RECIPROCAL turns this into a multiplication by a
+// Newton-refined reciprocal, which is cheaper than a packed division on
+// wide vectors but no longer bitwise identical to it.
+template <typename NumeratorType>
+KOKKOS_INLINE_FUNCTION Scalar divide(const NumeratorType &num,
+                                     const Scalar &den) {
+#ifdef HOMMEXX_FAST_RECIPROCAL
+  return num * reciprocal(den);
+#else
+  return num / den;
+#endif
+}
+
+template <typename rngAlg, typename PDF>
+void genRandArray(Real *const x, int length, rngAlg &engine, PDF &&pdf) {
+  for (int i = 0; i < length; ++i) {
+    x[i] = pdf(engine);
+  }
+}
+
+template <typename rngAlg, typename PDF>
+void genRandArray(Scalar *const x, int length, rngAlg &engine, PDF &&pdf) {
+  for (int i = 0; i < length; ++i) {
+    for(int j = 0; j < VECTOR_SIZE; ++j) {
+      x[i][j] = pdf(engine);
+    }
+  }
+}
+
+template <typename ViewType, typename rngAlg, typename PDF>
+void genRandArray(ViewType view, rngAlg &engine, PDF &&pdf) {
+  typename ViewType::HostMirror h_view = Kokkos::create_mirror_view(view);
+  genRandArray(h_view.data(), h_view.size(), engine, pdf);
+  Kokkos::deep_copy(view, h_view);
+}
+
+template <typename FPType>
+Real compare_answers(FPType target, FPType computed, FPType relative_coeff = 1.0) {
+  Real denom = 1.0;
+  if (relative_coeff > 0.0 && target != 0.0) {
+    denom = relative_coeff * std::fabs(target);
+  }
+
+  return std::fabs(target - computed) / denom;
+}
+
+} // namespace Homme
+
+#endif // HOMMEXX_UTILITY_HPP
@@ -0,0 +1,221 @@
+
+#include "Types.hpp"
+#include "Control.hpp"
+#include "Elements.hpp"
+#include "Derivative.hpp"
+#include "CubedSphere.hpp"
+#include "CaarFunctor.hpp"
+
+#include "profiling.hpp"
+
+#include <iostream>
+#include <chrono>
+
+using namespace Homme;
+
+using clock_type = std::chrono::high_resolution_clock;
+using ns = std::chrono::nanoseconds;
+
+// See https://youtu.be/nXaxk27zwlk?t=2478 for an in depth explanation
+// Use escape to force the compiler to pin down a specific piece of memory,
+// and force the compiler to allocate it
+static __inline__ void escape(const void *p) {
+  // The volatile tells the compiler some unknowable side-effect is occuring
+  // This is used for benchmarking, as this disables the optimizer,
+  // preventing it from getting rid of the evaluation entirely
+  // This tells the compiler we have touched all of the memory in the program
+  // We use the pointer to ensure the compiler has created an address for the
+  // data we're concerned about,
+  // and that it's not just in registers
+  asm volatile("" : : "g"(p) : "memory");
+}
+
+static __inline__ void clobber() {
+  // Tell the compiler we've magically written to all memory in the program
+  asm volatile("" : : : "memory");
+}
+
+// Attempt to invalidate the instruction cache
+void __attribute__((__noinline__)) function_call_test() {}
+
+void init_kokkos(const bool print_configuration = true) {
+  /* Make certain profiling is only done for code we're working on */
+  profiling_pause();
+
+  /* Set OpenMP Environment variables to control how many
+   * threads/processors Kokkos uses */
+  Kokkos::initialize();
+
+  ExecSpace::print_configuration(std::cout, print_configuration);
+}
+
+void flush_caches(HostViewManaged<Real *> &trash) {
+  for (int i = 0; i < trash.extent(0); ++i) {
+    Real a = trash(i);
+    escape(&a);
+  }
+}
+
+void finalize_kokkos() { Kokkos::finalize(); }
+
+// Replace the random data with the first num_elems elements of a cubed sphere
+void init_from_mesh(const int ne, const int num_elems, const int qsize,
+                    Control &data, Elements &elem, Derivative &deriv) {
+  CubedSphere mesh(ne);
+  mesh.init_state(num_elems);
+
+  deriv.init(mesh.m_dvv.data());
+
+  elem.init(num_elems, qsize);
+  elem.init_2d(mesh.m_d.data(), mesh.m_dinv.data(), mesh.m_fcor.data(),
+               mesh.m_spheremp.data(), mesh.m_metdet.data(),
+               mesh.m_phis.data());
+  elem.pull_from_f90_pointers(
+      mesh.m_state_v.data(), mesh.m_state_t.data(), mesh.m_state_dp3d.data(),
+      mesh.m_derived_phi.data(), mesh.m_derived_pecnd.data(),
+      mesh.m_derived_omega_p.data(), mesh.m_derived_v.data(),
+      mesh.m_derived_eta_dot_dpdn.data(), mesh.m_state_qdp.data());
+
+  // The mesh uses the same evenly spaced hybrid_b as the random data
+  data.ps0 = mesh.m_ps0;
+  ExecViewManaged<Real[NUM_LEV_P]>::HostMirror h_hybrid_a =
+      Kokkos::create_mirror_view(data.hybrid_a);
+  for (int i = 0; i < NUM_LEV_P; ++i) {
+    h_hybrid_a(i) = mesh.m_hybrid_a[i];
+  }
+  Kokkos::deep_copy(data.hybrid_a, h_hybrid_a);
+}
+
+int main(int argc, char **argv) {
+  constexpr int tstep = 600;
+
+  init_kokkos();
+  GPTLinitialize();
+
+  constexpr int threads_per_team = 4;
+  constexpr int vectors_per_thread = 1;
+
+  std::random_device rd;
+  std::mt19937_64 rng(rd());
+
+  Control data;
+  data.nm1 = 0;
+  data.n0 = 1;
+  data.np1 = 2;
+  data.qn0 = -1;
+  data.dt = tstep;
+  data.ps0 = 1.0;
+  data.eta_ave_w = 1.0;
+  data.hybrid_a = ExecViewManaged<Real[NUM_LEV_P]>(
+      "Hybrid coordinates; translates between pressure and velocity");
+
+  genRandArray(data.hybrid_a, rng,
+               std::uniform_real_distribution<Real>(1.0, 2.0));
+
+  // Evenly spaced hybrid b, from 0 at the top to 1 at the surface
+  data.hybrid_b =
+      ExecViewManaged<Real[NUM_LEV_P]>("Hybrid b at the interfaces");
+  ExecViewManaged<Real[NUM_LEV_P]>::HostMirror h_hybrid_b =
+      Kokkos::create_mirror_view(data.hybrid_b);
+  for (int ilevel = 0; ilevel < NUM_INTERFACE_LEV; ++ilevel) {
+    h_hybrid_b(ilevel) = static_cast<Real>(ilevel) / NUM_PHYSICAL_LEV;
+  }
+  Kokkos::deep_copy(data.hybrid_b, h_hybrid_b);
+
+  int num_elems = 32;
+  if (argc > 1) {
+    num_elems = atoi(argv[1]);
+  }
+
+  // Tracers actually advected; storage and initialization are sized to it
+  int qsize = QSIZE_D;
+  if (argc > 3) {
+    qsize = atoi(argv[3]);
+  }
+  data.qsize = qsize;
+
+  // rsplit=0 adds the Eulerian vertical advection to the timed kernel
+  data.rsplit = 1;
+  if (argc > 4) {
+    data.rsplit = atoi(argv[4]);
+  }
+
+  // With ne > 0 the elements are taken from a cubed sphere with ne x ne
+  // elements per face, instead of being filled with random numbers
+  int ne = 0;
+  if (argc > 5) {
+    ne = atoi(argv[5]);
+  }
+  if (num_elems > 6 * ne * ne && ne > 0) {
+    std::cerr << "A cubed sphere with ne=" << ne << " only has "
+              << 6 * ne * ne << " elements\n";
+    finalize_kokkos();
+    return 1;
+  }
+
+  Elements elem;
+  Derivative deriv;
+  if (ne > 0) {
+    init_from_mesh(ne, num_elems, qsize, data, elem, deriv);
+  } else {
+    elem.random_init(num_elems, qsize, rng);
+    deriv.random_init(rng);
+  }
+
+  constexpr int seconds_per_day = 24 * 3600;
+  constexpr int rk_stages = 5;
+  int num_exec = (seconds_per_day / tstep) * rk_stages;
+
+  if (argc > 2) {
+    num_exec = atoi(argv[2]);
+  }
+
+  // Create the functor
+  CaarFunctor func(data, elem, deriv);
+
+  constexpr int kb_size = 1024;
+  constexpr int doubles_per_kb = kb_size / sizeof(double);
+  constexpr int doubles_per_mb = doubles_per_kb * 1024;
+
+  HostViewManaged<Real *> trash("trash cache filler", 20 * doubles_per_mb);
+
+  {
+    // Setup the policy; each team handles a pack of VECTOR_SIZE elements
+    Kokkos::TeamPolicy<ExecSpace> policy(elem.num_elem_packs(),
+                                         threads_per_team, vectors_per_thread);
+    policy.set_chunk_size(1);
+
+    std::vector<clock_type::time_point> start_times(num_exec);
+    std::vector<clock_type::time_point> end_times(num_exec);
+
+    for (int exec = 0; exec < num_exec; ++exec) {
+      auto start = clock_type::now();
+      ExecSpace::fence();
+      start_timer("dispatch and compute");
+      Kokkos::parallel_for(policy, func);
+      ExecSpace::fence();
+      stop_timer("dispatch and compute");
+      flush_caches(trash);
+      auto end = clock_type::now();
+      start_times[exec] = start;
+      end_times[exec] = end;
+    }
+
+    clobber();
+
+    clock_type::duration total_time = end_times[0] - start_times[0];
+    for (int exec = 1; exec < num_exec; ++exec) {
+      total_time += end_times[exec] - start_times[exec];
+    }
+
+    auto count = std::chrono::duration_cast<ns>(total_time).count();
+    std::cout << "Seconds " << count * 1e-9 << " to evaluate " << num_elems
+              << " elements (" << elem.num_elem_packs() << " packs of "
+              << VECTOR_SIZE << ") " << num_exec << " times with rsplit "
+              << data.rsplit << "\n";
+  }
+
+  finalize_kokkos();
+  GPTLpr_summary_file(0, "Timing.dat");
+  return 0;
+}
@@ -0,0 +1,352 @@
+#ifndef __KOKKOSKERNELS_VECTOR_AVX256D_HPP__
+#define __KOKKOSKERNELS_VECTOR_AVX256D_HPP__
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#if defined(__AVX__) || defined(__AVX2__)
+
+#include <immintrin.h>
+
+namespace KokkosKernels {
+namespace Batched {
+namespace Experimental {
+
+///
+/// AVX256D double
+///
+
+template <typename SpT> class Vector<VectorTag<AVX<double, SpT>, 4> > {
+public:
+  using type = Vector<VectorTag<AVX<double, SpT>, 4> >;
+  using value_type = double;
+  using real_type = double;
+
+  enum : int { vector_length = 4 };
+
+  union data_type {
+    __m256d v;
+    double d[4];
+  };
+
+  KOKKOS_INLINE_FUNCTION
+  static const char *label() { return "AVX256"; }
+
+private:
+  mutable data_type _data;
+
+public:
+  inline Vector() { _data.v = _mm256_setzero_pd(); }
+  inline Vector(const value_type val) { _data.v = _mm256_set1_pd(val); }
+  inline Vector(const type &b) { _data.v = b._data.v; }
+  inline Vector(__m256d const &val) { _data.v = val; }
+
+  inline type &operator=(__m256d const &val) {
+    _data.v = val;
+    return *this;
+  }
+
+  inline operator __m256d() const { return _data.v; }
+
+  inline type &loadAligned(value_type const *p) {
+    _data.v = _mm256_load_pd(p);
+    return *this;
+  }
+
+  inline type &loadUnaligned(value_type const *p) {
+    _data.v = _mm256_loadu_pd(p);
+    return *this;
+  }
+
+  inline void storeAligned(value_type *p) const { _mm256_store_pd(p, _data.v); }
+
+  inline void storeUnaligned(value_type *p) const {
+    _mm256_storeu_pd(p, _data.v);
+  }
+
+  inline value_type &operator[](int i) const { return _data.d[i]; }
+
+  inline void shift_left(int num_shift) {
+    for (int i = 0; i < vector_length - num_shift; ++i) {
+      _data.d[i] = _data.d[i + num_shift];
+    }
+  }
+
+  inline void shift_right(int num_shift) {
+    for (int i = vector_length - 1; i >= num_shift; --i) {
+      _data.d[i] = _data.d[i - num_shift];
+    }
+  }
+};
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+operator+(Vector<VectorTag<AVX<double, SpT>, 4> > const &a,
+          Vector<VectorTag<AVX<double, SpT>, 4> > const &b) {
+  return _mm256_add_pd(a, b);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+operator+(Vector<VectorTag<AVX<double, SpT>, 4> > const &a, const double b) {
+  return a + Vector<VectorTag<AVX<double, SpT>, 4> >(b);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+operator+(const double a, Vector<VectorTag<AVX<double, SpT>, 4> > const &b) {
+  return Vector<VectorTag<AVX<double, SpT>, 4> >(a) + b;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> > &
+operator+=(Vector<VectorTag<AVX<double, SpT>, 4> > &a,
+           Vector<VectorTag<AVX<double, SpT>, 4> > const &b) {
+  a = a + b;
+  return a;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> > &
+operator+=(Vector<VectorTag<AVX<double, SpT>, 4> > &a, const double b) {
+  a = a + b;
+  return a;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+operator++(Vector<VectorTag<AVX<double, SpT>, 4> > &a, int) {
+  Vector<VectorTag<AVX<double, SpT>, 4> > a0 = a;
+  a = a + 1.0;
+  return a0;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> > &
+operator++(Vector<VectorTag<AVX<double, SpT>, 4> > &a) {
+  a = a + 1.0;
+  return a;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+operator-(Vector<VectorTag<AVX<double, SpT>, 4> > const &a,
+          Vector<VectorTag<AVX<double, SpT>, 4> > const &b) {
+  return _mm256_sub_pd(a, b);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+operator-(Vector<VectorTag<AVX<double, SpT>, 4> > const &a, const double b) {
+  return a - Vector<VectorTag<AVX<double, SpT>, 4> >(b);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+operator-(const double a, Vector<VectorTag<AVX<double, SpT>, 4> > const &b) {
+  return Vector<VectorTag<AVX<double, SpT>, 4> >(a) - b;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> > &
+operator-=(Vector<VectorTag<AVX<double, SpT>, 4> > &a,
+           Vector<VectorTag<AVX<double, SpT>, 4> > const &b) {
+  a = a - b;
+  return a;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> > &
+operator-=(Vector<VectorTag<AVX<double, SpT>, 4> > &a, const double b) {
+  a = a - b;
+  return a;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+operator--(Vector<VectorTag<AVX<double, SpT>, 4> > &a, int) {
+  Vector<VectorTag<AVX<double, SpT>, 4> > a0 = a;
+  a = a - 1.0;
+  return a0;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> > &
+operator--(Vector<VectorTag<AVX<double, SpT>, 4> > &a) {
+  a = a - 1.0;
+  return a;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+operator*(Vector<VectorTag<AVX<double, SpT>, 4> > const &a,
+          Vector<VectorTag<AVX<double, SpT>, 4> > const &b) {
+  return _mm256_mul_pd(a, b);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+operator*(Vector<VectorTag<AVX<double, SpT>, 4> > const &a, const double b) {
+  return a * Vector<VectorTag<AVX<double, SpT>, 4> >(b);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+operator*(const double a, Vector<VectorTag<AVX<double, SpT>, 4> > const &b) {
+  return Vector<VectorTag<AVX<double, SpT>, 4> >(a) * b;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> > &
+operator*=(Vector<VectorTag<AVX<double, SpT>, 4> > &a,
+           Vector<VectorTag<AVX<double, SpT>, 4> > const &b) {
+  a = a * b;
+  return a;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> > &
+operator*=(Vector<VectorTag<AVX<double, SpT>, 4> > &a, const double b) {
+  a = a * b;
+  return a;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+operator/(Vector<VectorTag<AVX<double, SpT>, 4> > const &a,
+          Vector<VectorTag<AVX<double, SpT>, 4> > const &b) {
+  return _mm256_div_pd(a, b);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+operator/(Vector<VectorTag<AVX<double, SpT>, 4> > const &a, const double b) {
+  return a / Vector<VectorTag<AVX<double, SpT>, 4> >(b);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+operator/(const double a, Vector<VectorTag<AVX<double, SpT>, 4> > const &b) {
+  return Vector<VectorTag<AVX<double, SpT>, 4> >(a) / b;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> > &
+operator/=(Vector<VectorTag<AVX<double, SpT>, 4> > &a,
+           Vector<VectorTag<AVX<double, SpT>, 4> > const &b) {
+  a = a / b;
+  return a;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> > &
+operator/=(Vector<VectorTag<AVX<double, SpT>, 4> > &a, const double b) {
+  a = a / b;
+  return a;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+operator-(Vector<VectorTag<AVX<double, SpT>, 4> > const &a) {
+  return -1 * a;
+}
+
+// Fused multiply-add family: fma(a,b,c) = a*b+c, fms(a,b,c) = a*b-c,
+// fnma(a,b,c) = c-a*b. Without FMA hardware these fall back to mul+add.
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+fma(Vector<VectorTag<AVX<double, SpT>, 4> > const &a,
+    Vector<VectorTag<AVX<double, SpT>, 4> > const &b,
+    Vector<VectorTag<AVX<double, SpT>, 4> > const &c) {
+#if defined(__FMA__)
+  return _mm256_fmadd_pd(a, b, c);
+#else
+  return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+fma(const double a, Vector<VectorTag<AVX<double, SpT>, 4> > const &b,
+    Vector<VectorTag<AVX<double, SpT>, 4> > const &c) {
+  return fma(Vector<VectorTag<AVX<double, SpT>, 4> >(a), b, c);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+fma(Vector<VectorTag<AVX<double, SpT>, 4> > const &a, const double b,
+    Vector<VectorTag<AVX<double, SpT>, 4> > const &c) {
+  return fma(a, Vector<VectorTag<AVX<double, SpT>, 4> >(b), c);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+fms(Vector<VectorTag<AVX<double, SpT>, 4> > const &a,
+    Vector<VectorTag<AVX<double, SpT>, 4> > const &b,
+    Vector<VectorTag<AVX<double, SpT>, 4> > const &c) {
+#if defined(__FMA__)
+  return _mm256_fmsub_pd(a, b, c);
+#else
+  return _mm256_sub_pd(_mm256_mul_pd(a, b), c);
+#endif
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+fms(const double a, Vector<VectorTag<AVX<double, SpT>, 4> > const &b,
+    Vector<VectorTag<AVX<double, SpT>, 4> > const &c) {
+  return fms(Vector<VectorTag<AVX<double, SpT>, 4> >(a), b, c);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+fms(Vector<VectorTag<AVX<double, SpT>, 4> > const &a, const double b,
+    Vector<VectorTag<AVX<double, SpT>, 4> > const &c) {
+  return fms(a, Vector<VectorTag<AVX<double, SpT>, 4> >(b), c);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+fnma(Vector<VectorTag<AVX<double, SpT>, 4> > const &a,
+     Vector<VectorTag<AVX<double, SpT>, 4> > const &b,
+     Vector<VectorTag<AVX<double, SpT>, 4> > const &c) {
+#if defined(__FMA__)
+  return _mm256_fnmadd_pd(a, b, c);
+#else
+  return _mm256_sub_pd(c, _mm256_mul_pd(a, b));
+#endif
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+fnma(const double a, Vector<VectorTag<AVX<double, SpT>, 4> > const &b,
+     Vector<VectorTag<AVX<double, SpT>, 4> > const &c) {
+  return fnma(Vector<VectorTag<AVX<double, SpT>, 4> >(a), b, c);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+fnma(Vector<VectorTag<AVX<double, SpT>, 4> > const &a, const double b,
+     Vector<VectorTag<AVX<double, SpT>, 4> > const &c) {
+  return fnma(a, Vector<VectorTag<AVX<double, SpT>, 4> >(b), c);
+}
+
+// Approximate 1/a: single precision estimate refined by three Newton-Raphson
+// steps. Only valid for |a| within the single precision range.
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+reciprocal(Vector<VectorTag<AVX<double, SpT>, 4> > const &a) {
+  const Vector<VectorTag<AVX<double, SpT>, 4> > one(1.0);
+  Vector<VectorTag<AVX<double, SpT>, 4> > x(
+      _mm256_cvtps_pd(_mm_rcp_ps(_mm256_cvtpd_ps(a))));
+  x = fma(x, fnma(a, x, one), x);
+  x = fma(x, fnma(a, x, one), x);
+  x = fma(x, fnma(a, x, one), x);
+  return x;
+}
+
+} // Experimental
+} // Batched
+} // KokkosKernels
+
+#endif
+#endif
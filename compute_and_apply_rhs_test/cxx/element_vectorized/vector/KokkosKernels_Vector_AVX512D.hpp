@@ -0,0 +1,335 @@
+#ifndef __KOKKOSKERNELS_VECTOR_AVX512D_HPP__
+#define __KOKKOSKERNELS_VECTOR_AVX512D_HPP__
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+#if defined(__AVX512F__)
+
+#include <immintrin.h>
+
+namespace KokkosKernels {
+namespace Batched {
+namespace Experimental {
+///
+/// AVX512D double
+///
+
+template <typename SpT> class Vector<VectorTag<AVX<double, SpT>, 8> > {
+public:
+  using type = Vector<VectorTag<AVX<double, SpT>, 8> >;
+  using value_type = double;
+  using real_type = double;
+
+  enum : int { vector_length = 8 };
+
+  union data_type {
+    __m512d v;
+    double d[8];
+  };
+
+  KOKKOS_INLINE_FUNCTION
+  static const char *label() { return "AVX512"; }
+
+private:
+  mutable data_type _data;
+
+public:
+  inline Vector() { _data.v = _mm512_setzero_pd(); }
+  inline Vector(const value_type val) { _data.v = _mm512_set1_pd(val); }
+  inline Vector(const type &b) { _data.v = b._data.v; }
+  inline Vector(__m512d const &val) { _data.v = val; }
+
+  inline type &operator=(__m512d const &val) {
+    _data.v = val;
+    return *this;
+  }
+
+  inline operator __m512d() const { return _data.v; }
+
+  inline type &loadAligned(value_type const *p) {
+    _data.v = _mm512_load_pd(p);
+    return *this;
+  }
+
+  inline type &loadUnaligned(value_type const *p) {
+    _data.v = _mm512_loadu_pd(p);
+    return *this;
+  }
+
+  inline void storeAligned(value_type *p) const { _mm512_store_pd(p, _data.v); }
+
+  inline void storeUnaligned(value_type *p) const {
+    _mm512_storeu_pd(p, _data.v);
+  }
+
+  inline value_type &operator[](int i) const { return _data.d[i]; }
+
+  inline void shift_left(int num_shift) {
+    for (int i = 0; i < vector_length - num_shift; ++i) {
+      _data.d[i] = _data.d[i + num_shift];
+    }
+  }
+
+  inline void shift_right(int num_shift) {
+    for (int i = vector_length - 1; i >= num_shift; --i) {
+      _data.d[i] = _data.d[i - num_shift];
+    }
+  }
+};
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+operator+(Vector<VectorTag<AVX<double, SpT>, 8> > const &a,
+          Vector<VectorTag<AVX<double, SpT>, 8> > const &b) {
+  return _mm512_add_pd(a, b);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+operator+(Vector<VectorTag<AVX<double, SpT>, 8> > const &a, const double b) {
+  return a + Vector<VectorTag<AVX<double, SpT>, 8> >(b);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+operator+(const double a, Vector<VectorTag<AVX<double, SpT>, 8> > const &b) {
+  return Vector<VectorTag<AVX<double, SpT>, 8> >(a) + b;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> > &
+operator+=(Vector<VectorTag<AVX<double, SpT>, 8> > &a,
+           Vector<VectorTag<AVX<double, SpT>, 8> > const &b) {
+  a = a + b;
+  return a;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> > &
+operator+=(Vector<VectorTag<AVX<double, SpT>, 8> > &a, const double b) {
+  a = a + b;
+  return a;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+operator++(Vector<VectorTag<AVX<double, SpT>, 8> > &a, int) {
+  Vector<VectorTag<AVX<double, SpT>, 8> > a0 = a;
+  a = a + 1.0;
+  return a0;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> > &
+operator++(Vector<VectorTag<AVX<double, SpT>, 8> > &a) {
+  a = a + 1.0;
+  return a;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+operator-(Vector<VectorTag<AVX<double, SpT>, 8> > const &a,
+          Vector<VectorTag<AVX<double, SpT>, 8> > const &b) {
+  return _mm512_sub_pd(a, b);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+operator-(Vector<VectorTag<AVX<double, SpT>, 8> > const &a, const double b) {
+  return a - Vector<VectorTag<AVX<double, SpT>, 8> >(b);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+operator-(const double a, Vector<VectorTag<AVX<double, SpT>, 8> > const &b) {
+  return Vector<VectorTag<AVX<double, SpT>, 8> >(a) - b;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> > &
+operator-=(Vector<VectorTag<AVX<double, SpT>, 8> > &a,
+           Vector<VectorTag<AVX<double, SpT>, 8> > const &b) {
+  a = a - b;
+  return a;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> > &
+operator-=(Vector<VectorTag<AVX<double, SpT>, 8> > &a, const double b) {
+  a = a - b;
+  return a;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+operator--(Vector<VectorTag<AVX<double, SpT>, 8> > &a, int) {
+  Vector<VectorTag<AVX<double, SpT>, 8> > a0 = a;
+  a = a - 1.0;
+  return a0;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> > &
+operator--(Vector<VectorTag<AVX<double, SpT>, 8> > &a) {
+  a = a - 1.0;
+  return a;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+operator*(Vector<VectorTag<AVX<double, SpT>, 8> > const &a,
+          Vector<VectorTag<AVX<double, SpT>, 8> > const &b) {
+  return _mm512_mul_pd(a, b);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+operator*(Vector<VectorTag<AVX<double, SpT>, 8> > const &a, const double b) {
+  return a * Vector<VectorTag<AVX<double, SpT>, 8> >(b);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+operator*(const double a, Vector<VectorTag<AVX<double, SpT>, 8> > const &b) {
+  return Vector<VectorTag<AVX<double, SpT>, 8> >(a) * b;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> > &
+operator*=(Vector<VectorTag<AVX<double, SpT>, 8> > &a,
+           Vector<VectorTag<AVX<double, SpT>, 8> > const &b) {
+  a = a * b;
+  return a;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> > &
+operator*=(Vector<VectorTag<AVX<double, SpT>, 8> > &a, const double b) {
+  a = a * b;
+  return a;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+operator/(Vector<VectorTag<AVX<double, SpT>, 8> > const &a,
+          Vector<VectorTag<AVX<double, SpT>, 8> > const &b) {
+  return _mm512_div_pd(a, b);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+operator/(Vector<VectorTag<AVX<double, SpT>, 8> > const &a, const double b) {
+  return a / Vector<VectorTag<AVX<double, SpT>, 8> >(b);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+operator/(const double a, Vector<VectorTag<AVX<double, SpT>, 8> > const &b) {
+  return Vector<VectorTag<AVX<double, SpT>, 8> >(a) / b;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> > &
+operator/=(Vector<VectorTag<AVX<double, SpT>, 8> > &a,
+           Vector<VectorTag<AVX<double, SpT>, 8> > const &b) {
+  a = a / b;
+  return a;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> > &
+operator/=(Vector<VectorTag<AVX<double, SpT>, 8> > &a, const double b) {
+  a = a / b;
+  return a;
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+operator-(Vector<VectorTag<AVX<double, SpT>, 8> > const &a) {
+  return -1 * a;
+}
+
+// Fused multiply-add family: fma(a,b,c) = a*b+c, fms(a,b,c) = a*b-c,
+// fnma(a,b,c) = c-a*b.
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+fma(Vector<VectorTag<AVX<double, SpT>, 8> > const &a,
+    Vector<VectorTag<AVX<double, SpT>, 8> > const &b,
+    Vector<VectorTag<AVX<double, SpT>, 8> > const &c) {
+  return _mm512_fmadd_pd(a, b, c);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+fma(const double a, Vector<VectorTag<AVX<double, SpT>, 8> > const &b,
+    Vector<VectorTag<AVX<double, SpT>, 8> > const &c) {
+  return fma(Vector<VectorTag<AVX<double, SpT>, 8> >(a), b, c);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+fma(Vector<VectorTag<AVX<double, SpT>, 8> > const &a, const double b,
+    Vector<VectorTag<AVX<double, SpT>, 8> > const &c) {
+  return fma(a, Vector<VectorTag<AVX<double, SpT>, 8> >(b), c);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+fms(Vector<VectorTag<AVX<double, SpT>, 8> > const &a,
+    Vector<VectorTag<AVX<double, SpT>, 8> > const &b,
+    Vector<VectorTag<AVX<double, SpT>, 8> > const &c) {
+  return _mm512_fmsub_pd(a, b, c);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+fms(const double a, Vector<VectorTag<AVX<double, SpT>, 8> > const &b,
+    Vector<VectorTag<AVX<double, SpT>, 8> > const &c) {
+  return fms(Vector<VectorTag<AVX<double, SpT>, 8> >(a), b, c);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+fms(Vector<VectorTag<AVX<double, SpT>, 8> > const &a, const double b,
+    Vector<VectorTag<AVX<double, SpT>, 8> > const &c) {
+  return fms(a, Vector<VectorTag<AVX<double, SpT>, 8> >(b), c);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+fnma(Vector<VectorTag<AVX<double, SpT>, 8> > const &a,
+     Vector<VectorTag<AVX<double, SpT>, 8> > const &b,
+     Vector<VectorTag<AVX<double, SpT>, 8> > const &c) {
+  return _mm512_fnmadd_pd(a, b, c);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+fnma(const double a, Vector<VectorTag<AVX<double, SpT>, 8> > const &b,
+     Vector<VectorTag<AVX<double, SpT>, 8> > const &c) {
+  return fnma(Vector<VectorTag<AVX<double, SpT>, 8> >(a), b, c);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+fnma(Vector<VectorTag<AVX<double, SpT>, 8> > const &a, const double b,
+     Vector<VectorTag<AVX<double, SpT>, 8> > const &c) {
+  return fnma(a, Vector<VectorTag<AVX<double, SpT>, 8> >(b), c);
+}
+
+// Approximate 1/a: 14 bit estimate refined by two Newton-Raphson steps.
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+reciprocal(Vector<VectorTag<AVX<double, SpT>, 8> > const &a) {
+  const Vector<VectorTag<AVX<double, SpT>, 8> > one(1.0);
+  Vector<VectorTag<AVX<double, SpT>, 8> > x(_mm512_rcp14_pd(a));
+  x = fma(x, fnma(a, x, one), x);
+  x = fma(x, fnma(a, x, one), x);
+  return x;
+}
+
+} // Experimental
+} // Batched
+} // KokkosKernels
+
+#endif
+#endif
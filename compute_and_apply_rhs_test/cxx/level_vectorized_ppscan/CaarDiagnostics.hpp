@@ -0,0 +1,63 @@
+#ifndef HOMMEXX_CAAR_DIAGNOSTICS_HPP
+#define HOMMEXX_CAAR_DIAGNOSTICS_HPP
+
+#include "Types.hpp"
+
+namespace Homme {
+
+// The global energy and mass of the state CAAR reads (n0), integrated over
+// the elements with the spheremp weights:
+//   kinetic energy  sum of spheremp * dp3d / g * (u^2 + v^2) / 2
+//   internal energy sum of spheremp * dp3d / g * cp * T
+//   mass            sum of spheremp * dp3d / g
+// CaarFunctor computes them with the values it already has in registers
+// when Control::compute_diagonstics is set, as the value of the
+// parallel_reduce of its teams
+struct CaarDiagnostics {
+  // The column sums CaarFunctor keeps in Elements::buffers.diagnostics_buf
+  static constexpr int KINETIC_ENERGY = 0;
+  static constexpr int INTERNAL_ENERGY = 1;
+  static constexpr int MASS = 2;
+  static constexpr int NUM_DIAGNOSTICS = 3;
+
+  Real kinetic_energy;
+  Real internal_energy;
+  Real mass;
+
+  KOKKOS_INLINE_FUNCTION
+  CaarDiagnostics() : kinetic_energy(0), internal_energy(0), mass(0) {}
+
+  KOKKOS_INLINE_FUNCTION
+  CaarDiagnostics &operator+=(const CaarDiagnostics &rhs) {
+    kinetic_energy += rhs.kinetic_energy;
+    internal_energy += rhs.internal_energy;
+    mass += rhs.mass;
+    return *this;
+  }
+
+  // Kokkos joins the values of the teams through volatile references
+  KOKKOS_INLINE_FUNCTION
+  void operator+=(const volatile CaarDiagnostics &rhs) volatile {
+    kinetic_energy += rhs.kinetic_energy;
+    internal_energy += rhs.internal_energy;
+    mass += rhs.mass;
+  }
+};
+
+// The sum of the entries of pack ilev of a column that are physical levels
+// (the last pack may be padded)
+KOKKOS_INLINE_FUNCTION
+Real sum_physical_levels(const Scalar &pack, const int ilev) {
+  constexpr int last_pack_levels =
+      NUM_PHYSICAL_LEV - (NUM_LEV - 1) * VECTOR_SIZE;
+  const int num_levels = ilev == NUM_LEV - 1 ? last_pack_levels : VECTOR_SIZE;
+  Real sum = 0;
+  for (int iv = 0; iv < num_levels; ++iv) {
+    sum += pack[iv];
+  }
+  return sum;
+}
+
+} // namespace Homme
+
+#endif // HOMMEXX_CAAR_DIAGNOSTICS_HPP
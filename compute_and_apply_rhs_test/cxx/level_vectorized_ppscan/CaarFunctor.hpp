@@ -7,6 +7,7 @@
 #include "Derivative.hpp"
 #include "KernelVariables.hpp"
 #include "SphereOperators.hpp"
+#include "CaarDiagnostics.hpp"
 
 #include "Utility.hpp"
 #include "profiling.hpp"
@@ -22,6 +23,12 @@ struct CaarFunctor {
 
   static constexpr Kokkos::Impl::ALL_t ALL = Kokkos::ALL;
 
+  // The columns of a field of an element, as the sphere operators take them
+  using ElementField = ExecViewUnmanaged<const Scalar[NP][NP][NUM_LEV]>;
+
+  // The tag of the double buffered pipeline (see the operators below)
+  struct Pipelined {};
+
   CaarFunctor()
       : m_data(), m_elements(get_elements()), m_deriv(get_derivative()) {
     // Nothing to be done here
@@ -34,45 +41,106 @@ struct CaarFunctor {
     // Nothing to be done here
   }
 
+  // The state of the elements of a KernelVariables::STAGED_ field
+  KOKKOS_INLINE_FUNCTION
+  const ExecViewManaged<Scalar * [NUM_TIME_LEVELS][NP][NP][NUM_LEV]> &
+  state(const int field) const {
+    return field == KernelVariables::STAGED_U ? m_elements.m_u
+           : field == KernelVariables::STAGED_V ? m_elements.m_v
+           : field == KernelVariables::STAGED_T ? m_elements.m_t
+           : m_elements.m_dp3d;
+  }
+
+  // A KernelVariables::STAGED_ field at n0 of the element kv.ie, from team
+  // scratch when the pipeline staged it there, from the elements otherwise
+  KOKKOS_INLINE_FUNCTION
+  ElementField state_n0(const KernelVariables &kv, const int field) const {
+    if (kv.staged != nullptr) {
+      return ElementField(kv.staged + field * NP * NP * NUM_LEV);
+    }
+    return ElementField(&state(field)(kv.ie, m_data.n0, 0, 0, 0));
+  }
+
+  // Copies the columns (igp, jgp) of the fields [first, last) at n0 of
+  // kv.next_ie to kv.next_staged, with the vector lanes of the thread. The
+  // serial scans call it for their column: the lanes are idle there, and
+  // the loads do not depend on the chain of the scan, so they overlap it
+  KOKKOS_INLINE_FUNCTION
+  void stage_next_columns(const KernelVariables &kv, const int igp,
+                          const int jgp, const int first,
+                          const int last) const {
+    if (kv.next_ie < 0) {
+      return;
+    }
+    for (int field = first; field < last; ++field) {
+      const auto &field_state = state(field);
+      Scalar *const column =
+          kv.next_staged + ((field * NP + igp) * NP + jgp) * NUM_LEV;
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV),
+                           [&](const int &ilev) {
+        column[ilev] = field_state(kv.next_ie, m_data.n0, igp, jgp, ilev);
+      });
+    }
+  }
+
   // Depends on PHI (after preq_hydrostatic), PECND
   // Modifies Ephi_grad
   // Computes \nabla (E + phi) + \nabla (P) * Rgas * T_v / P
+  // With Diagnostics, also the column sums of the kinetic energy
+  template <bool Diagnostics = false>
   KOKKOS_INLINE_FUNCTION void compute_energy_grad(KernelVariables &kv) const {
+    const ElementField u = state_n0(kv, KernelVariables::STAGED_U);
+    const ElementField v = state_n0(kv, KernelVariables::STAGED_V);
+    const ElementField dp3d = state_n0(kv, KernelVariables::STAGED_DP3D);
     Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP),
                          [&](const int idx) {
       const int igp = idx / NP;
       const int jgp = idx % NP;
-      Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV),
-                           [&](const int &ilev) {
+      // Returns the kinetic energy of the level pack
+      const auto level_energy = [&](const int ilev) {
         // pre-fill energy_grad with the pressure(_grad)-temperature part
-        m_elements.buffers.energy_grad(kv.ie, 0, igp, jgp, ilev) =
+        const Scalar rgas_tv_over_p =
             PhysicalConstants::Rgas *
-            (m_elements.buffers.temperature_virt(kv.ie, igp, jgp, ilev) /
-             m_elements.buffers.pressure(kv.ie, igp, jgp, ilev)) *
+            divide(m_elements.buffers.temperature_virt(kv.ie, igp, jgp, ilev),
+                   m_elements.buffers.pressure(kv.ie, igp, jgp, ilev));
+        m_elements.buffers.energy_grad(kv.ie, 0, igp, jgp, ilev) =
+            rgas_tv_over_p *
             m_elements.buffers.pressure_grad(kv.ie, 0, igp, jgp, ilev);
-
         m_elements.buffers.energy_grad(kv.ie, 1, igp, jgp, ilev) =
-            PhysicalConstants::Rgas *
-            (m_elements.buffers.temperature_virt(kv.ie, igp, jgp, ilev) /
-             m_elements.buffers.pressure(kv.ie, igp, jgp, ilev)) *
+            rgas_tv_over_p *
             m_elements.buffers.pressure_grad(kv.ie, 1, igp, jgp, ilev);
 
         // Kinetic energy + PHI (geopotential energy) +
         // PECND (potential energy?)
-        Scalar k_energy =
-            0.5 * (m_elements.m_u(kv.ie, m_data.n0, igp, jgp, ilev) *
-                       m_elements.m_u(kv.ie, m_data.n0, igp, jgp, ilev) +
-                   m_elements.m_v(kv.ie, m_data.n0, igp, jgp, ilev) *
-                       m_elements.m_v(kv.ie, m_data.n0, igp, jgp, ilev));
+        const Scalar &u_k = u(igp, jgp, ilev);
+        const Scalar &v_k = v(igp, jgp, ilev);
+        Scalar k_energy = 0.5 * fma(u_k, u_k, v_k * v_k);
         m_elements.buffers.ephi(kv.ie, igp, jgp, ilev) =
             k_energy + (m_elements.m_phi(kv.ie, igp, jgp, ilev) +
                         m_elements.m_pecnd(kv.ie, igp, jgp, ilev));
-      });
+        return k_energy;
+      };
+      if (Diagnostics) {
+        Real kinetic_energy = 0;
+        Kokkos::parallel_reduce(Kokkos::ThreadVectorRange(kv.team, NUM_LEV),
+                                [&](const int &ilev, Real &sum) {
+          sum += sum_physical_levels(
+              level_energy(ilev) * dp3d(igp, jgp, ilev), ilev);
+        }, kinetic_energy);
+        Kokkos::single(Kokkos::PerThread(kv.team), [&]() {
+          m_elements.buffers.diagnostics_buf(
+              kv.ie, CaarDiagnostics::KINETIC_ENERGY, igp, jgp) =
+              kinetic_energy;
+        });
+      } else {
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV),
+                             [&](const int &ilev) { level_energy(ilev); });
+      }
     });
     kv.team_barrier();
 
     gradient_sphere_update(
-        kv, m_elements.m_dinv, m_deriv.get_dvv(),
+        kv, m_elements.geometry, m_deriv.get_dvv_rrearth(),
         Kokkos::subview(m_elements.buffers.ephi, kv.ie, ALL, ALL, ALL),
         m_elements.buffers.grad_buf,
         Kokkos::subview(m_elements.buffers.energy_grad, kv.ie, ALL, ALL, ALL,
@@ -98,27 +166,34 @@ struct CaarFunctor {
 
   // Depends on pressure, PHI, U_current, V_current, METDET,
   // D, DINV, U, V, FCOR, SPHEREMP, T_v, ETA_DPDN
+  // With rsplit=0, the vertical advection of T and v is fused into the
+  // temperature and velocity updates
+  template <bool Diagnostics = false>
   KOKKOS_INLINE_FUNCTION void compute_phase_3(KernelVariables &kv) const {
-    compute_eta_dpdn_rsplit(kv);
+    if (m_data.rsplit == 0) {
+      compute_eta_dpdn_no_rsplit(kv);
+    } else {
+      compute_eta_dpdn_rsplit(kv);
+    }
     compute_omega_p(kv);
     compute_temperature_np1(kv);
-    compute_velocity_np1(kv);
-    // Note this is dependent on eta_dot_dpdn from other levels and will cause
-    // issues when rsplit is 0
+    compute_velocity_np1<Diagnostics>(kv);
     compute_dp3d_np1(kv);
     check_dp3d(kv);
   } // TRIVIAL
 
   // Depends on pressure, PHI, U_current, V_current, METDET,
   // D, DINV, U, V, FCOR, SPHEREMP, T_v
+  template <bool Diagnostics = false>
   KOKKOS_INLINE_FUNCTION
   void compute_velocity_np1(KernelVariables &kv) const {
-    compute_energy_grad(kv);
+    compute_energy_grad<Diagnostics>(kv);
 
+    const ElementField u = state_n0(kv, KernelVariables::STAGED_U);
+    const ElementField v = state_n0(kv, KernelVariables::STAGED_V);
+    const ElementField dp3d = state_n0(kv, KernelVariables::STAGED_DP3D);
     vorticity_sphere(
-        kv, m_elements.m_d, m_elements.m_metdet, m_deriv.get_dvv(),
-        Kokkos::subview(m_elements.m_u, kv.ie, m_data.n0, ALL, ALL, ALL),
-        Kokkos::subview(m_elements.m_v, kv.ie, m_data.n0, ALL, ALL, ALL),
+        kv, m_elements.geometry, m_deriv.get_dvv(), u, v,
         m_elements.buffers.vort_buf,
         Kokkos::subview(m_elements.buffers.vorticity, kv.ie, ALL, ALL, ALL));
 
@@ -131,34 +206,40 @@ struct CaarFunctor {
         // Recycle vort to contain (fcor+vort)
         m_elements.buffers.vorticity(kv.ie, igp, jgp, ilev) +=
             m_elements.m_fcor(kv.ie, igp, jgp);
+        const Scalar &vort = m_elements.buffers.vorticity(kv.ie, igp, jgp, ilev);
+
+        // -energy_grad - v_vadv + (v, -u) * (fcor + vort)
+        Scalar &grad_0 = m_elements.buffers.energy_grad(kv.ie, 0, igp, jgp, ilev);
+        Scalar &grad_1 = m_elements.buffers.energy_grad(kv.ie, 1, igp, jgp, ilev);
+        grad_0 = fms(v(igp, jgp, ilev), vort, grad_0);
+        grad_1 = fnma(u(igp, jgp, ilev), vort, -grad_1);
+        if (m_data.rsplit == 0) {
+          const Scalar half_rdp = divide(0.5, dp3d(igp, jgp, ilev));
+          const Scalar eta_kp1 = next_interface(
+              m_elements.buffers.eta_dot_dpdn, kv, igp, jgp, ilev);
+          const Scalar &eta_k =
+              m_elements.buffers.eta_dot_dpdn(kv.ie, igp, jgp, ilev);
+          grad_0 -=
+              preq_vertadv(u, half_rdp, eta_k, eta_kp1, igp, jgp, ilev);
+          grad_1 -=
+              preq_vertadv(v, half_rdp, eta_k, eta_kp1, igp, jgp, ilev);
+        }
 
-        m_elements.buffers.energy_grad(kv.ie, 0, igp, jgp, ilev) *= -1;
-        m_elements.buffers.energy_grad(kv.ie, 0, igp, jgp, ilev) +=
-            /* v_vadv(igp, jgp) + */ m_elements.m_v(kv.ie, m_data.n0, igp, jgp,
-                                                    ilev) *
-            m_elements.buffers.vorticity(kv.ie, igp, jgp, ilev);
-        m_elements.buffers.energy_grad(kv.ie, 1, igp, jgp, ilev) *= -1;
-        m_elements.buffers.energy_grad(kv.ie, 1, igp, jgp, ilev) +=
-            /* v_vadv(igp, jgp) + */ -m_elements.m_u(kv.ie, m_data.n0, igp, jgp,
-                                                     ilev) *
-            m_elements.buffers.vorticity(kv.ie, igp, jgp, ilev);
-
-        m_elements.buffers.energy_grad(kv.ie, 0, igp, jgp, ilev) *= m_data.dt;
-        m_elements.buffers.energy_grad(kv.ie, 0, igp, jgp, ilev) +=
-            m_elements.m_u(kv.ie, m_data.nm1, igp, jgp, ilev);
-        m_elements.buffers.energy_grad(kv.ie, 1, igp, jgp, ilev) *= m_data.dt;
-        m_elements.buffers.energy_grad(kv.ie, 1, igp, jgp, ilev) +=
-            m_elements.m_v(kv.ie, m_data.nm1, igp, jgp, ilev);
+        grad_0 = fma(grad_0, m_data.dt,
+                     m_elements.m_u(kv.ie, m_data.nm1, igp, jgp, ilev));
+        grad_1 = fma(grad_1, m_data.dt,
+                     m_elements.m_v(kv.ie, m_data.nm1, igp, jgp, ilev));
 
         // Velocity at np1 = spheremp * buffer
-        m_elements.m_u(kv.ie, m_data.np1, igp, jgp, ilev) =
-            m_elements.m_spheremp(kv.ie, igp, jgp) *
-            m_elements.buffers.energy_grad(kv.ie, 0, igp, jgp, ilev);
-        m_elements.m_v(kv.ie, m_data.np1, igp, jgp, ilev) =
-            m_elements.m_spheremp(kv.ie, igp, jgp) *
-            m_elements.buffers.energy_grad(kv.ie, 1, igp, jgp, ilev);
+        store_scalar(m_elements.m_u(kv.ie, m_data.np1, igp, jgp, ilev),
+                     m_elements.m_spheremp(kv.ie, igp, jgp) * grad_0,
+                     m_data.streaming_stores);
+        store_scalar(m_elements.m_v(kv.ie, m_data.np1, igp, jgp, ilev),
+                     m_elements.m_spheremp(kv.ie, igp, jgp) * grad_1,
+                     m_data.streaming_stores);
       });
     });
+    streaming_store_fence(m_data.streaming_stores);
     kv.team_barrier();
   } // UNTESTED 2
 
@@ -178,36 +259,103 @@ struct CaarFunctor {
     kv.team_barrier();
   } // TRIVIAL
 
+  // eta_dot_dpdn(k) = hybi(k) * sum(div_vdp) - sum_{j<k} div_vdp(j), which
+  // vanishes at the top and bottom interfaces. preq_omega_ps leaves the
+  // partial sums in buffers.eta_dot_dpdn, with the full column sum stored at
+  // the bottom interface, so this is a single pass over the packs
   KOKKOS_INLINE_FUNCTION
   void compute_eta_dpdn_no_rsplit(KernelVariables &kv) const {
-    Kokkos::parallel_for(
-        Kokkos::TeamThreadRange(kv.team, NP * NP),
-        KOKKOS_LAMBDA(const int idx) {
-          // TODO: Compute the actual value for this if rsplit=0.
-          // Note this will be unsafe to thread over levels,
-          // so thread over points instead
-          // for (int ilev=0; ilev<NUM_INTERFACE_LEV; ++ilev) {
-          //   m_elements.eta_dot_dpdn += eta_ave_w*eta_dot_dpdn
-          // }
-        });
-  } // Unimplemented
+    constexpr int bottom_pack = NUM_PHYSICAL_LEV / VECTOR_SIZE;
+    constexpr int bottom_vec = NUM_PHYSICAL_LEV % VECTOR_SIZE;
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP),
+                         [&](const int idx) {
+      const int igp = idx / NP;
+      const int jgp = idx % NP;
+      const Real sdot_sum =
+          m_elements.buffers.eta_dot_dpdn(kv.ie, igp, jgp, bottom_pack)
+              [bottom_vec];
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV_P),
+                           [&](const int &ilev) {
+        Scalar &eta_dot_dpdn =
+            m_elements.buffers.eta_dot_dpdn(kv.ie, igp, jgp, ilev);
+        eta_dot_dpdn = fms(m_data.hybrid_b(ilev), sdot_sum, eta_dot_dpdn);
+        if (ilev == 0) {
+          eta_dot_dpdn[0] = 0;
+        }
+        if (ilev == bottom_pack) {
+          for (int iv = bottom_vec; iv < VECTOR_SIZE; ++iv) {
+            eta_dot_dpdn[iv] = 0;
+          }
+        }
+        m_elements.m_eta_dot_dpdn(kv.ie, igp, jgp, ilev) =
+            fma(m_data.eta_ave_w, eta_dot_dpdn,
+                m_elements.m_eta_dot_dpdn(kv.ie, igp, jgp, ilev));
+      });
+    });
+    kv.team_barrier();
+  } // UNTESTED 14
+
+  // The fluxes through the interfaces below the levels of pack ilev
+  KOKKOS_INLINE_FUNCTION
+  Scalar next_interface(
+      const ExecViewManaged<Scalar * [NP][NP][NUM_LEV_P]> &eta_dot_dpdn,
+      const KernelVariables &kv, const int igp, const int jgp,
+      const int ilev) const {
+    Scalar next = eta_dot_dpdn(kv.ie, igp, jgp, ilev);
+    next.shift_left(1);
+    if (ilev + 1 < NUM_LEV_P) {
+      next[VECTOR_SIZE - 1] = eta_dot_dpdn(kv.ie, igp, jgp, ilev + 1)[0];
+    }
+    return next;
+  }
+
+  // Vertical advection of field (at n0) at the levels of pack ilev
+  //   0.5/dp3d(k) * (eta_dot_dpdn(k+1) * (f(k+1) - f(k)) +
+  //                  eta_dot_dpdn(k)   * (f(k) - f(k-1)))
+  // The neighbouring levels are obtained by shifting the pack by one; what
+  // gets shifted in past the top and bottom levels is multiplied by the zero
+  // boundary fluxes
+  KOKKOS_INLINE_FUNCTION
+  Scalar preq_vertadv(const ElementField &field, const Scalar &half_rdp,
+                      const Scalar &eta_k, const Scalar &eta_kp1,
+                      const int igp, const int jgp, const int ilev) const {
+    const Scalar &f = field(igp, jgp, ilev);
+    Scalar f_next = f;
+    f_next.shift_left(1);
+    if (ilev + 1 < NUM_LEV) {
+      f_next[VECTOR_SIZE - 1] = field(igp, jgp, ilev + 1)[0];
+    }
+    Scalar f_prev = f;
+    f_prev.shift_right(1);
+    if (ilev > 0) {
+      f_prev[0] = field(igp, jgp, ilev - 1)[VECTOR_SIZE - 1];
+    }
+    return half_rdp * fma(eta_kp1, f_next - f, eta_k * (f - f_prev));
+  } // UNTESTED 13
 
   // Depends on PHIS, DP3D, PHI, pressure, T_v
   // Modifies PHI
+  // With Diagnostics, also the column sums of the internal energy
+  // Stages T and dp3d of the next element of the pipeline
+  template <bool Diagnostics = false>
   KOKKOS_INLINE_FUNCTION
   void preq_hydrostatic(KernelVariables &kv) const {
+    const ElementField t = state_n0(kv, KernelVariables::STAGED_T);
+    const ElementField dp3d_n0 = state_n0(kv, KernelVariables::STAGED_DP3D);
     Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP),
                          [&](const int loop_idx) {
+      const int igp = loop_idx / NP;
+      const int jgp = loop_idx % NP;
+      stage_next_columns(kv, igp, jgp, KernelVariables::STAGED_T,
+                         KernelVariables::NUM_STAGED_FIELDS);
       Kokkos::single(Kokkos::PerThread(kv.team), [&]() {
-        const int igp = loop_idx / NP;
-        const int jgp = loop_idx % NP;
-
         // Note: we add VECTOR_SIZE-1 rather than subtracting 1 since (0-1)%N=-1
         // while (0+N-1)%N=N-1.
         constexpr int last_lvl_last_vector_idx =
             (NUM_PHYSICAL_LEV + VECTOR_SIZE - 1) % VECTOR_SIZE;
 
         Real integration = 0;
+        Real internal_energy = 0;
         for (int ilev = NUM_LEV - 1; ilev >= 0; --ilev) {
           const int vec_start =
               (ilev == (NUM_LEV - 1) ? last_lvl_last_vector_idx
@@ -217,13 +365,12 @@ struct CaarFunctor {
           auto &phi = m_elements.m_phi(kv.ie, igp, jgp, ilev);
           const auto &t_v =
               m_elements.buffers.temperature_virt(kv.ie, igp, jgp, ilev);
-          const auto &dp3d =
-              m_elements.m_dp3d(kv.ie, m_data.n0, igp, jgp, ilev);
+          const auto &dp3d = dp3d_n0(igp, jgp, ilev);
           const auto &p = m_elements.buffers.pressure(kv.ie, igp, jgp, ilev);
 
           // Precompute this product as a SIMD operation
           const auto rgas_tv_dp_over_p =
-              PhysicalConstants::Rgas * t_v * (dp3d * 0.5 / p);
+              PhysicalConstants::Rgas * t_v * divide(dp3d * 0.5, p);
 
           // Integrate
           Scalar integration_ij;
@@ -233,8 +380,18 @@ struct CaarFunctor {
                 integration_ij[iv + 1] + rgas_tv_dp_over_p[iv + 1];
 
           // Add integral and constant terms to phi
-          phi = phis + 2.0 * integration_ij + rgas_tv_dp_over_p;
+          phi = fma(2.0, integration_ij, phis + rgas_tv_dp_over_p);
           integration = integration_ij[0] + rgas_tv_dp_over_p[0];
+
+          if (Diagnostics) {
+            internal_energy +=
+                sum_physical_levels(t(igp, jgp, ilev) * dp3d, ilev);
+          }
+        }
+        if (Diagnostics) {
+          m_elements.buffers.diagnostics_buf(
+              kv.ie, CaarDiagnostics::INTERNAL_ENERGY, igp, jgp) =
+              PhysicalConstants::cp * internal_energy;
         }
       });
     });
@@ -245,8 +402,10 @@ struct CaarFunctor {
   // omega_p
   KOKKOS_INLINE_FUNCTION
   void preq_omega_ps(KernelVariables &kv) const {
+    const ElementField u = state_n0(kv, KernelVariables::STAGED_U);
+    const ElementField v = state_n0(kv, KernelVariables::STAGED_V);
     gradient_sphere(
-        kv, m_elements.m_dinv, m_deriv.get_dvv(),
+        kv, m_elements.geometry, m_deriv.get_dvv_rrearth(),
         Kokkos::subview(m_elements.buffers.pressure, kv.ie, ALL, ALL, ALL),
         m_elements.buffers.grad_buf,
         Kokkos::subview(m_elements.buffers.pressure_grad, kv.ie, ALL, ALL, ALL,
@@ -265,11 +424,11 @@ struct CaarFunctor {
                    ? ((NUM_PHYSICAL_LEV + VECTOR_SIZE - 1) % VECTOR_SIZE)
                    : VECTOR_SIZE - 1);
 
-          const Scalar vgrad_p =
-              m_elements.m_u(kv.ie, m_data.n0, igp, jgp, ilev) *
-                  m_elements.buffers.pressure_grad(kv.ie, 0, igp, jgp, ilev) +
-              m_elements.m_v(kv.ie, m_data.n0, igp, jgp, ilev) *
-                  m_elements.buffers.pressure_grad(kv.ie, 1, igp, jgp, ilev);
+          const Scalar vgrad_p = fma(
+              u(igp, jgp, ilev),
+              m_elements.buffers.pressure_grad(kv.ie, 0, igp, jgp, ilev),
+              v(igp, jgp, ilev) *
+                  m_elements.buffers.pressure_grad(kv.ie, 1, igp, jgp, ilev));
           auto &omega_p = m_elements.buffers.omega_p(kv.ie, igp, jgp, ilev);
           const auto &p = m_elements.buffers.pressure(kv.ie, igp, jgp, ilev);
           const auto &div_vdp =
@@ -279,22 +438,39 @@ struct CaarFunctor {
           integration_ij[0] = integration;
           for (int iv = 0; iv < vector_end; ++iv)
             integration_ij[iv + 1] = integration_ij[iv] + div_vdp[iv];
-          omega_p = (vgrad_p - (integration_ij + 0.5 * div_vdp)) / p;
+          omega_p = divide(vgrad_p - fma(0.5, div_vdp, integration_ij), p);
+          if (m_data.rsplit == 0) {
+            // Partial sums for compute_eta_dpdn_no_rsplit
+            m_elements.buffers.eta_dot_dpdn(kv.ie, igp, jgp, ilev) =
+                integration_ij;
+          }
           integration = integration_ij[vector_end] + div_vdp[vector_end];
         }
+        if (m_data.rsplit == 0) {
+          m_elements.buffers.eta_dot_dpdn(kv.ie, igp, jgp,
+                                          NUM_PHYSICAL_LEV / VECTOR_SIZE)
+              [NUM_PHYSICAL_LEV % VECTOR_SIZE] = integration;
+        }
       });
     });
     kv.team_barrier();
   } // TESTED 4
 
   // Depends on DP3D
+  // With Diagnostics, also the mass of the columns, which the scan gives as
+  // the surface pressure minus the pressure at the top
+  // Stages u and v of the next element of the pipeline
+  template <bool Diagnostics = false>
   KOKKOS_INLINE_FUNCTION
   void compute_pressure(KernelVariables &kv) const {
+    const ElementField dp3d = state_n0(kv, KernelVariables::STAGED_DP3D);
     Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP),
                          [&](const int loop_idx) {
+      const int igp = loop_idx / NP;
+      const int jgp = loop_idx % NP;
+      stage_next_columns(kv, igp, jgp, KernelVariables::STAGED_U,
+                         KernelVariables::STAGED_T);
       Kokkos::single(Kokkos::PerThread(kv.team), [&]() {
-        const int igp = loop_idx / NP;
-        const int jgp = loop_idx % NP;
 
         Real dp_prev = 0;
         Real p_prev = m_data.hybrid_a(0) * m_data.ps0;
@@ -305,7 +481,7 @@ struct CaarFunctor {
                    : VECTOR_SIZE - 1);
 
           auto p = m_elements.buffers.pressure(kv.ie, igp, jgp, ilev);
-          const auto &dp = m_elements.m_dp3d(kv.ie, m_data.n0, igp, jgp, ilev);
+          const auto &dp = dp3d(igp, jgp, ilev);
 
           for (int iv = 0; iv <= vector_end; ++iv) {
             // p[k] = p[k-1] + 0.5*dp[k-1] + 0.5*dp[k]
@@ -316,6 +492,11 @@ struct CaarFunctor {
           }
           m_elements.buffers.pressure(kv.ie, igp, jgp, ilev) = p;
         };
+        if (Diagnostics) {
+          m_elements.buffers.diagnostics_buf(kv.ie, CaarDiagnostics::MASS,
+                                             igp, jgp) =
+              p_prev + 0.5 * dp_prev - m_data.hybrid_a(0) * m_data.ps0;
+        }
       });
     });
     kv.team_barrier();
@@ -323,25 +504,27 @@ struct CaarFunctor {
 
   // Depends on DP3D, PHIS, DP3D, PHI, T_v
   // Modifies pressure, PHI
+  template <bool Diagnostics = false>
   KOKKOS_INLINE_FUNCTION
   void compute_scan_properties(KernelVariables &kv) const {
     // Use this instead of Kokkos::single(Kokkos::PerTeam
     // due to Kokkos failing to execute the TeamThreadRange parallel for
     // on CUDA
-    compute_pressure(kv);
-    preq_hydrostatic(kv);
+    compute_pressure<Diagnostics>(kv);
+    preq_hydrostatic<Diagnostics>(kv);
     preq_omega_ps(kv);
   } // TRIVIAL
 
   KOKKOS_INLINE_FUNCTION
   void compute_temperature_no_tracers_helper(KernelVariables &kv) const {
+    const ElementField t = state_n0(kv, KernelVariables::STAGED_T);
     Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP),
                          [&](const int idx) {
       const int igp = idx / NP;
       const int jgp = idx % NP;
       for (int ilev = 0; ilev < NUM_LEV; ++ilev) {
         m_elements.buffers.temperature_virt(kv.ie, igp, jgp, ilev) =
-            m_elements.m_t(kv.ie, m_data.n0, igp, jgp, ilev);
+            t(igp, jgp, ilev);
       }
     });
     kv.team_barrier();
@@ -349,17 +532,19 @@ struct CaarFunctor {
 
   KOKKOS_INLINE_FUNCTION
   void compute_temperature_tracers_helper(KernelVariables &kv) const {
+    const ElementField t = state_n0(kv, KernelVariables::STAGED_T);
+    const ElementField dp3d = state_n0(kv, KernelVariables::STAGED_DP3D);
     Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP),
                          [&](const int idx) {
       const int igp = idx / NP;
       const int jgp = idx % NP;
       for (int ilev = 0; ilev < NUM_LEV; ++ilev) {
         Scalar Qt = m_elements.m_qdp(kv.ie, m_data.qn0, 0, igp, jgp, ilev) /
-                    m_elements.m_dp3d(kv.ie, m_data.n0, igp, jgp, ilev);
+                    dp3d(igp, jgp, ilev);
         Qt *= (PhysicalConstants::Rwater_vapor / PhysicalConstants::Rgas - 1.0);
         Qt += 1.0;
         m_elements.buffers.temperature_virt(kv.ie, igp, jgp, ilev) =
-            m_elements.m_t(kv.ie, m_data.n0, igp, jgp, ilev) * Qt;
+            t(igp, jgp, ilev) * Qt;
       }
     });
     kv.team_barrier();
@@ -371,30 +556,35 @@ struct CaarFunctor {
   // Requires NUM_LEV * 5 * NP * NP
   KOKKOS_INLINE_FUNCTION
   void compute_div_vdp(KernelVariables &kv) const {
+    const ElementField u = state_n0(kv, KernelVariables::STAGED_U);
+    const ElementField v = state_n0(kv, KernelVariables::STAGED_V);
+    const ElementField dp3d = state_n0(kv, KernelVariables::STAGED_DP3D);
     Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP),
                          [&](const int idx) {
       const int igp = idx / NP;
       const int jgp = idx % NP;
       for (int ilev = 0; ilev < NUM_LEV; ++ilev) {
         m_elements.buffers.vdp(kv.ie, 0, igp, jgp, ilev) =
-            m_elements.m_u(kv.ie, m_data.n0, igp, jgp, ilev) *
-            m_elements.m_dp3d(kv.ie, m_data.n0, igp, jgp, ilev);
+            u(igp, jgp, ilev) * dp3d(igp, jgp, ilev);
 
         m_elements.buffers.vdp(kv.ie, 1, igp, jgp, ilev) =
-            m_elements.m_v(kv.ie, m_data.n0, igp, jgp, ilev) *
-            m_elements.m_dp3d(kv.ie, m_data.n0, igp, jgp, ilev);
+            v(igp, jgp, ilev) * dp3d(igp, jgp, ilev);
 
-        m_elements.m_derived_un0(kv.ie, igp, jgp, ilev) +=
-            m_data.eta_ave_w * m_elements.buffers.vdp(kv.ie, 0, igp, jgp, ilev);
+        m_elements.m_derived_un0(kv.ie, igp, jgp, ilev) =
+            fma(m_data.eta_ave_w,
+                m_elements.buffers.vdp(kv.ie, 0, igp, jgp, ilev),
+                m_elements.m_derived_un0(kv.ie, igp, jgp, ilev));
 
-        m_elements.m_derived_vn0(kv.ie, igp, jgp, ilev) +=
-            m_data.eta_ave_w * m_elements.buffers.vdp(kv.ie, 1, igp, jgp, ilev);
+        m_elements.m_derived_vn0(kv.ie, igp, jgp, ilev) =
+            fma(m_data.eta_ave_w,
+                m_elements.buffers.vdp(kv.ie, 1, igp, jgp, ilev),
+                m_elements.m_derived_vn0(kv.ie, igp, jgp, ilev));
       }
     });
     kv.team_barrier();
 
     divergence_sphere(
-        kv, m_elements.m_dinv, m_elements.m_metdet, m_deriv.get_dvv(),
+        kv, m_elements.geometry, m_deriv.get_dvv(),
         Kokkos::subview(m_elements.buffers.vdp, kv.ie, ALL, ALL, ALL, ALL),
         m_elements.buffers.div_buf,
         Kokkos::subview(m_elements.buffers.div_vdp, kv.ie, ALL, ALL, ALL));
@@ -421,9 +611,10 @@ struct CaarFunctor {
       const int jgp = idx % NP;
       Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV),
                            [&](const int &ilev) {
-        m_elements.m_omega_p(kv.ie, igp, jgp, ilev) +=
-            m_data.eta_ave_w *
-            m_elements.buffers.omega_p(kv.ie, igp, jgp, ilev);
+        m_elements.m_omega_p(kv.ie, igp, jgp, ilev) =
+            fma(m_data.eta_ave_w,
+                m_elements.buffers.omega_p(kv.ie, igp, jgp, ilev),
+                m_elements.m_omega_p(kv.ie, igp, jgp, ilev));
       });
     });
     kv.team_barrier();
@@ -435,10 +626,13 @@ struct CaarFunctor {
   // block_3d_scalars
   KOKKOS_INLINE_FUNCTION
   void compute_temperature_np1(KernelVariables &kv) const {
+    const ElementField u = state_n0(kv, KernelVariables::STAGED_U);
+    const ElementField v = state_n0(kv, KernelVariables::STAGED_V);
+    const ElementField t = state_n0(kv, KernelVariables::STAGED_T);
+    const ElementField dp3d = state_n0(kv, KernelVariables::STAGED_DP3D);
 
     gradient_sphere(
-        kv, m_elements.m_dinv, m_deriv.get_dvv(),
-        Kokkos::subview(m_elements.m_t, kv.ie, m_data.n0, ALL, ALL, ALL),
+        kv, m_elements.geometry, m_deriv.get_dvv_rrearth(), t,
         m_elements.buffers.grad_buf,
         Kokkos::subview(m_elements.buffers.temperature_grad, kv.ie, ALL, ALL,
                         ALL, ALL));
@@ -450,25 +644,35 @@ struct CaarFunctor {
 
       Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV),
                            [&](const int &ilev) {
-        const Scalar vgrad_t =
-            m_elements.m_u(kv.ie, m_data.n0, igp, jgp, ilev) *
-                m_elements.buffers.temperature_grad(kv.ie, 0, igp, jgp, ilev) +
-            m_elements.m_v(kv.ie, m_data.n0, igp, jgp, ilev) *
-                m_elements.buffers.temperature_grad(kv.ie, 1, igp, jgp, ilev);
-
-        // vgrad_t + kappa * T_v * omega_p
-        const Scalar ttens =
-            -vgrad_t +
-            PhysicalConstants::kappa *
-                m_elements.buffers.temperature_virt(kv.ie, igp, jgp, ilev) *
-                m_elements.buffers.omega_p(kv.ie, igp, jgp, ilev);
-
-        Scalar temp_np1 = ttens * m_data.dt +
-                          m_elements.m_t(kv.ie, m_data.nm1, igp, jgp, ilev);
+        const Scalar vgrad_t = fma(
+            u(igp, jgp, ilev),
+            m_elements.buffers.temperature_grad(kv.ie, 0, igp, jgp, ilev),
+            v(igp, jgp, ilev) *
+                m_elements.buffers.temperature_grad(kv.ie, 1, igp, jgp, ilev));
+
+        // -vgrad_t - T_vadv + kappa * T_v * omega_p
+        Scalar ttens =
+            fms(PhysicalConstants::kappa *
+                    m_elements.buffers.temperature_virt(kv.ie, igp, jgp, ilev),
+                m_elements.buffers.omega_p(kv.ie, igp, jgp, ilev), vgrad_t);
+        if (m_data.rsplit == 0) {
+          const Scalar half_rdp = divide(0.5, dp3d(igp, jgp, ilev));
+          ttens -= preq_vertadv(
+              t, half_rdp,
+              m_elements.buffers.eta_dot_dpdn(kv.ie, igp, jgp, ilev),
+              next_interface(m_elements.buffers.eta_dot_dpdn, kv, igp, jgp,
+                             ilev),
+              igp, jgp, ilev);
+        }
+
+        Scalar temp_np1 = fma(ttens, m_data.dt,
+                              m_elements.m_t(kv.ie, m_data.nm1, igp, jgp, ilev));
         temp_np1 *= m_elements.m_spheremp(kv.ie, igp, jgp);
-        m_elements.m_t(kv.ie, m_data.np1, igp, jgp, ilev) = temp_np1;
+        store_scalar(m_elements.m_t(kv.ie, m_data.np1, igp, jgp, ilev),
+                     temp_np1, m_data.streaming_stores);
       });
     });
+    streaming_store_fence(m_data.streaming_stores);
     kv.team_barrier();
   } // TESTED 11
 
@@ -476,94 +680,252 @@ struct CaarFunctor {
   // Modifies DERIVED_UN0, DERIVED_VN0, OMEGA_P, T, and DP3D
   KOKKOS_INLINE_FUNCTION
   void compute_dp3d_np1(KernelVariables &kv) const {
+    const bool streaming_stores =
+        m_data.streaming_stores && m_data.stream_dp3d;
+    // The flux of this stage when rsplit is 0
+    const ExecViewManaged<Scalar * [NP][NP][NUM_LEV_P]> &eta_dot_dpdn =
+        (m_data.rsplit == 0 ? m_elements.buffers.eta_dot_dpdn
+                            : m_elements.m_eta_dot_dpdn);
     Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP),
                          [&](const int idx) {
       const int igp = idx / NP;
       const int jgp = idx % NP;
       Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
-        Scalar tmp = m_elements.m_eta_dot_dpdn(kv.ie, igp, jgp, ilev);
-        tmp.shift_left(1);
-        tmp[VECTOR_SIZE - 1] =
-            m_elements.m_eta_dot_dpdn(kv.ie, igp, jgp, ilev + 1)[0];
+        Scalar tmp = next_interface(eta_dot_dpdn, kv, igp, jgp, ilev);
         // Add div_vdp before subtracting the previous value to eta_dot_dpdn
         // This will hopefully reduce numeric error
         tmp += m_elements.buffers.div_vdp(kv.ie, igp, jgp, ilev);
-        tmp -= m_elements.m_eta_dot_dpdn(kv.ie, igp, jgp, ilev);
-        tmp = m_elements.m_dp3d(kv.ie, m_data.nm1, igp, jgp, ilev) -
-              tmp * m_data.dt;
+        tmp -= eta_dot_dpdn(kv.ie, igp, jgp, ilev);
+        tmp = fnma(tmp, m_data.dt,
+                   m_elements.m_dp3d(kv.ie, m_data.nm1, igp, jgp, ilev));
 
-        m_elements.m_dp3d(kv.ie, m_data.np1, igp, jgp, ilev) =
-            m_elements.m_spheremp(kv.ie, igp, jgp) * tmp;
+        store_scalar(m_elements.m_dp3d(kv.ie, m_data.np1, igp, jgp, ilev),
+                     m_elements.m_spheremp(kv.ie, igp, jgp) * tmp,
+                     streaming_stores);
       });
     });
+    streaming_store_fence(streaming_stores);
     kv.team_barrier();
   } // TESTED 12
 
-  // Computes the vertical advection of T and v
-  // Not currently used
+  // Prefetches the fields CAAR reads for the element the team evaluates
+  // m_data.prefetch_distance elements after kv.ie, so that they arrive while
+  // this one is computed. The host backends of Kokkos give each team a
+  // contiguous block of the league (HostThreadTeamData::set_work_partition),
+  // and the pipeline a contiguous range, so that element is
+  // kv.ie + prefetch_distance unless it is past end, the end of the
+  // elements of the team when it is known. The threads of the team share
+  // the fields
   KOKKOS_INLINE_FUNCTION
-  void preq_vertadv(
-      const TeamMember &,
-      const ExecViewUnmanaged<const Scalar[NUM_LEV][NP][NP]> T,
-      const ExecViewUnmanaged<const Scalar[NUM_LEV][2][NP][NP]> v,
-      const ExecViewUnmanaged<const Scalar[NUM_LEV_P][NP][NP]> eta_dp_deta,
-      const ExecViewUnmanaged<const Scalar[NUM_LEV][NP][NP]> rpdel,
-      ExecViewUnmanaged<Scalar[NUM_LEV][NP][NP]> T_vadv,
-      ExecViewUnmanaged<Scalar[NUM_LEV][2][NP][NP]> v_vadv) {
-    constexpr const int k_0 = 0;
-    for (int j = 0; j < NP; ++j) {
-      for (int i = 0; i < NP; ++i) {
-        Scalar facp = 0.5 * rpdel(k_0, j, i) * eta_dp_deta(k_0 + 1, j, i);
-        T_vadv(k_0, j, i) = facp * (T(k_0 + 1, j, i) - T(k_0, j, i));
-        for (int h = 0; h < 2; ++h) {
-          v_vadv(k_0, h, j, i) = facp * (v(k_0 + 1, h, j, i) - v(k_0, h, j, i));
-        }
-      }
+  void prefetch_next_element(KernelVariables &kv) const {
+    prefetch_next_element(kv, m_data.nete);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void prefetch_next_element(KernelVariables &kv, const int end) const {
+    if (m_data.prefetch_distance <= 0) {
+      return;
     }
-    constexpr const int k_f = NUM_LEV - 1;
-    for (int k = k_0 + 1; k < k_f; ++k) {
-      for (int j = 0; j < NP; ++j) {
-        for (int i = 0; i < NP; ++i) {
-          Scalar facp = 0.5 * rpdel(k, j, i) * eta_dp_deta(k + 1, j, i);
-          Scalar facm = 0.5 * rpdel(k, j, i) * eta_dp_deta(k, j, i);
-          T_vadv(k, j, i) = facp * (T(k + 1, j, i) - T(k, j, i)) +
-                            facm * (T(k, j, i) - T(k - 1, j, i));
-          for (int h = 0; h < 2; ++h) {
-            v_vadv(k, h, j, i) = facp * (v(k + 1, h, j, i) - v(k, h, j, i)) +
-                                 facm * (v(k, h, j, i) - v(k - 1, h, j, i));
+    const int ie = kv.ie + m_data.prefetch_distance;
+    if (ie >= end) {
+      return;
+    }
+    constexpr size_t column_bytes = NP * NP * NUM_LEV * sizeof(Scalar);
+    constexpr size_t geometry_bytes = 2 * 2 * NP * NP * sizeof(Real);
+    constexpr int num_state = 8;
+    constexpr int num_fields = num_state + 10;
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, num_fields),
+                         [&](const int field) {
+      const void *p = nullptr;
+      size_t bytes = column_bytes;
+      if (field < num_state) {
+        // u, v, T and dp3d at n0 and nm1
+        const int tl = field % 2 == 0 ? m_data.n0 : m_data.nm1;
+        const int ifield = field / 2;
+        const auto &state = ifield == 0 ? m_elements.m_u
+                            : ifield == 1 ? m_elements.m_v
+                            : ifield == 2 ? m_elements.m_t
+                            : m_elements.m_dp3d;
+        p = &state(ie, tl, 0, 0, 0);
+      } else {
+        switch (field - num_state) {
+        case 0: p = &m_elements.m_phi(ie, 0, 0, 0); break;
+        case 1: p = &m_elements.m_pecnd(ie, 0, 0, 0); break;
+        case 2: p = &m_elements.m_omega_p(ie, 0, 0, 0); break;
+        case 3: p = &m_elements.m_derived_un0(ie, 0, 0, 0); break;
+        case 4: p = &m_elements.m_derived_vn0(ie, 0, 0, 0); break;
+        case 5:
+          // Only read for the virtual temperature of moist runs
+          if (m_data.qn0 >= 0) {
+            p = &m_elements.m_qdp(ie, m_data.qn0, 0, 0, 0, 0);
           }
+          break;
+        case 6:
+          p = &m_elements.m_eta_dot_dpdn(ie, 0, 0, 0);
+          bytes = NP * NP * NUM_LEV_P * sizeof(Scalar);
+          break;
+        case 7:
+          p = &m_elements.geometry.contravariant(ie, 0, 0, 0, 0);
+          bytes = geometry_bytes;
+          break;
+        case 8:
+          p = &m_elements.geometry.contravariant_metdet(ie, 0, 0, 0, 0);
+          bytes = geometry_bytes;
+          break;
+        default:
+          p = &m_elements.geometry.covariant(ie, 0, 0, 0, 0);
+          bytes = geometry_bytes;
+          break;
         }
       }
-    }
-    for (int j = 0; j < NP; ++j) {
-      for (int i = 0; i < NP; ++i) {
-        Scalar facm = 0.5 * rpdel(k_f, j, i) * eta_dp_deta(k_f, j, i);
-        T_vadv(k_f, j, i) = facm * (T(k_f, j, i) - T(k_f - 1, j, i));
-        for (int h = 0; h < 2; ++h) {
-          v_vadv(k_f, h, j, i) = facm * (v(k_f, h, j, i) - v(k_f - 1, h, j, i));
-        }
+      if (p != nullptr) {
+        prefetch(p, bytes, m_data.prefetch_locality);
+      }
+    });
+  }
+
+  // The CAAR of the element kv.ie. With Diagnostics, the phases also leave
+  // the column sums of the diagnostics in buffers.diagnostics_buf, from the
+  // values they load anyway; without, they are the same code as before
+  template <bool Diagnostics = false>
+  KOKKOS_INLINE_FUNCTION void compute(KernelVariables &kv) const {
+    compute_temperature_div_vdp(kv);
+    kv.team.team_barrier();
+
+    compute_scan_properties<Diagnostics>(kv);
+    kv.team.team_barrier();
+
+    compute_phase_3<Diagnostics>(kv);
+  }
+
+  // The diagnostics of the element kv.ie, from the column sums of
+  // compute<true>
+  KOKKOS_INLINE_FUNCTION
+  CaarDiagnostics element_diagnostics(KernelVariables &kv) const {
+    CaarDiagnostics diagnostics;
+    for (int igp = 0; igp < NP; ++igp) {
+      for (int jgp = 0; jgp < NP; ++jgp) {
+        const Real weight =
+            m_elements.m_spheremp(kv.ie, igp, jgp) / PhysicalConstants::g;
+        const auto column =
+            Kokkos::subview(m_elements.buffers.diagnostics_buf, kv.ie, ALL,
+                            igp, jgp);
+        diagnostics.kinetic_energy +=
+            weight * column(CaarDiagnostics::KINETIC_ENERGY);
+        diagnostics.internal_energy +=
+            weight * column(CaarDiagnostics::INTERNAL_ENERGY);
+        diagnostics.mass += weight * column(CaarDiagnostics::MASS);
       }
     }
-  } // UNTESTED 13
+    return diagnostics;
+  }
 
   KOKKOS_INLINE_FUNCTION
   void operator()(const TeamMember &team) const {
     start_timer("caar compute");
+    KernelVariables kv(team, m_data.nets);
+    prefetch_next_element(kv);
+    compute(kv);
+    stop_timer("caar compute");
+  }
+
+  // CAAR as a parallel_reduce of the diagnostics over the teams, when
+  // m_data.compute_diagonstics is set. Each team sums the columns of its
+  // element once they are all written, and Kokkos sums the teams
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const TeamMember &team, CaarDiagnostics &diagnostics) const {
+    start_timer("caar compute");
+    KernelVariables kv(team, m_data.nets);
+    prefetch_next_element(kv);
+    compute<true>(kv);
+    kv.team_barrier();
+    Kokkos::single(Kokkos::PerTeam(kv.team),
+                   [&]() { diagnostics += element_diagnostics(kv); });
+    stop_timer("caar compute");
+  }
+
+  // The elements of a team of the pipeline, with two buffers in team
+  // scratch for their state at n0. The team computes each element from one
+  // buffer while its scans stage the next element in the other, so that
+  // the loads of the next element are done by the time it is computed
+  template <bool Diagnostics>
+  KOKKOS_INLINE_FUNCTION
+  void compute_pipelined(const TeamMember &team,
+                         CaarDiagnostics &diagnostics) const {
     KernelVariables kv(team);
+    // Team scratch is not aligned to a pack: allocate one more to align the
+    // buffers
+    Scalar *const scratch =
+        kv.allocate_team<Scalar,
+                         Scalar[2 * KernelVariables::STAGED_SIZE + 1]>();
+    constexpr size_t pack_bytes = alignof(Scalar);
+    Scalar *const buffers = reinterpret_cast<Scalar *>(
+        (reinterpret_cast<size_t>(scratch) + pack_bytes - 1) / pack_bytes *
+        pack_bytes);
+
+    // A contiguous range of [nets, nete) per team
+    const int num_elems = m_data.nete - m_data.nets;
+    const int begin =
+        m_data.nets + num_elems * team.league_rank() / team.league_size();
+    const int end = m_data.nets +
+                    num_elems * (team.league_rank() + 1) / team.league_size();
+    if (begin == end) {
+      return;
+    }
 
-    compute_temperature_div_vdp(kv);
-    kv.team.team_barrier();
+    // Stage the first element before computing anything
+    kv.next_ie = begin;
+    kv.next_staged = buffers;
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP),
+                         [&](const int idx) {
+      stage_next_columns(kv, idx / NP, idx % NP, KernelVariables::STAGED_U,
+                         KernelVariables::NUM_STAGED_FIELDS);
+    });
+    kv.team_barrier();
 
-    compute_scan_properties(kv);
-    kv.team.team_barrier();
+    for (int ie = begin; ie < end; ++ie) {
+      const int buffer = (ie - begin) % 2;
+      kv.ie = ie;
+      kv.staged = buffers + buffer * KernelVariables::STAGED_SIZE;
+      kv.next_ie = ie + 1 < end ? ie + 1 : -1;
+      kv.next_staged = buffers + (1 - buffer) * KernelVariables::STAGED_SIZE;
+      prefetch_next_element(kv, end);
+      compute<Diagnostics>(kv);
+      // The next element overwrites the buffer of this one
+      kv.team_barrier();
+      if (Diagnostics) {
+        Kokkos::single(Kokkos::PerTeam(kv.team),
+                       [&]() { diagnostics += element_diagnostics(kv); });
+      }
+    }
+  }
 
-    compute_phase_3(kv);
+  // CAAR with the pipeline, launched over m_data.pipeline_teams teams with
+  // a TeamPolicy tagged Pipelined and the team scratch of shmem_size
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const Pipelined &, const TeamMember &team) const {
+    start_timer("caar compute");
+    CaarDiagnostics diagnostics;
+    compute_pipelined<false>(team, diagnostics);
+    stop_timer("caar compute");
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const Pipelined &, const TeamMember &team,
+                  CaarDiagnostics &diagnostics) const {
+    start_timer("caar compute");
+    compute_pipelined<true>(team, diagnostics);
     stop_timer("caar compute");
   }
 
+  // With the pipeline, the two buffers of the state of its elements
   KOKKOS_INLINE_FUNCTION
   size_t shmem_size(const int team_size) const {
-    return KernelVariables::shmem_size(team_size);
+    const size_t staged_bytes =
+        m_data.pipeline_teams > 0
+            ? (2 * KernelVariables::STAGED_SIZE + 1) * sizeof(Scalar)
+            : 0;
+    return KernelVariables::shmem_size(team_size) + staged_bytes;
   }
 };
 
@@ -0,0 +1,119 @@
+#include "CacheMissCounter.hpp"
+
+#if defined(__linux__) && !defined(HOMMEXX_CUDA_SPACE) &&                     \
+    !(defined(HOMMEXX_DEFAULT_SPACE) && defined(KOKKOS_ENABLE_CUDA))
+#define HOMMEXX_PERF_EVENTS
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <set>
+#endif
+
+namespace Homme {
+
+#ifdef HOMMEXX_PERF_EVENTS
+
+namespace {
+
+int open_counter(const pid_t tid, const unsigned int type,
+                 const unsigned long long config) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return syscall(__NR_perf_event_open, &attr, tid, -1, -1, 0);
+}
+
+// The data TLB loads with the given result
+constexpr unsigned long long dtlb_loads(const unsigned long long result) {
+  return PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+         (result << 16);
+}
+
+} // namespace
+
+CacheMissCounter::CacheMissCounter(const CountedCache cache)
+    : m_references(0), m_misses(0) {
+  const bool tlb = cache == CountedCache::DATA_TLB;
+  const unsigned int type = tlb ? PERF_TYPE_HW_CACHE : PERF_TYPE_HARDWARE;
+  const unsigned long long references_config =
+      tlb ? dtlb_loads(PERF_COUNT_HW_CACHE_RESULT_ACCESS)
+          : PERF_COUNT_HW_CACHE_REFERENCES;
+  const unsigned long long misses_config =
+      tlb ? dtlb_loads(PERF_COUNT_HW_CACHE_RESULT_MISS)
+          : PERF_COUNT_HW_CACHE_MISSES;
+
+  // Each thread of the execution space gets an iteration of a range as long
+  // as the concurrency (the main thread is one of them)
+  const int concurrency = ExecSpace::concurrency();
+  HostViewManaged<pid_t *> tids("thread ids", concurrency);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecSpace>(0, concurrency),
+      KOKKOS_LAMBDA(const int i) { tids(i) = syscall(SYS_gettid); });
+  ExecSpace::fence();
+
+  const std::set<pid_t> threads(tids.data(), tids.data() + concurrency);
+  for (const pid_t tid : threads) {
+    const int references = open_counter(tid, type, references_config);
+    const int misses = open_counter(tid, type, misses_config);
+    if (references < 0 || misses < 0) {
+      for (int fd : {references, misses}) {
+        if (fd >= 0) {
+          close(fd);
+        }
+      }
+      for (int fd : m_fds) {
+        close(fd);
+      }
+      m_fds.clear();
+      return;
+    }
+    m_fds.push_back(references);
+    m_fds.push_back(misses);
+  }
+}
+
+CacheMissCounter::~CacheMissCounter() {
+  for (int fd : m_fds) {
+    close(fd);
+  }
+}
+
+void CacheMissCounter::start() {
+  for (int fd : m_fds) {
+    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+  }
+}
+
+void CacheMissCounter::stop() {
+  for (size_t i = 0; i < m_fds.size(); ++i) {
+    ioctl(m_fds[i], PERF_EVENT_IOC_DISABLE, 0);
+    long long count = 0;
+    if (read(m_fds[i], &count, sizeof(count)) == sizeof(count)) {
+      (i % 2 == 0 ? m_references : m_misses) += count;
+    }
+  }
+}
+
+#else
+
+CacheMissCounter::CacheMissCounter(const CountedCache)
+    : m_references(0), m_misses(0) {}
+
+CacheMissCounter::~CacheMissCounter() {}
+
+void CacheMissCounter::start() {}
+
+void CacheMissCounter::stop() {}
+
+#endif // HOMMEXX_PERF_EVENTS
+
+} // namespace Homme
@@ -0,0 +1,52 @@
+#ifndef HOMMEXX_CACHE_MISS_COUNTER_HPP
+#define HOMMEXX_CACHE_MISS_COUNTER_HPP
+
+#include "Types.hpp"
+
+#include <vector>
+
+namespace Homme {
+
+// The caches a CacheMissCounter counts: the last level cache, or the data
+// TLB (the cache of the page translations; its references are the loads)
+enum class CountedCache { LAST_LEVEL, DATA_TLB };
+
+/* References and misses of a cache by all the threads of the execution
+ * space, from the hardware counters of the Linux perf events. Create it
+ * after Kokkos::initialize, so that the threads exist.
+ *
+ * The counters may not be accessible (not Linux, a GPU execution space, a
+ * virtual machine, perf_event_paranoid > 2): available() is then false and
+ * the counts are 0. */
+class CacheMissCounter {
+public:
+  explicit CacheMissCounter(
+      const CountedCache cache = CountedCache::LAST_LEVEL);
+  ~CacheMissCounter();
+
+  CacheMissCounter(const CacheMissCounter &) = delete;
+  CacheMissCounter &operator=(const CacheMissCounter &) = delete;
+
+  bool available() const { return !m_fds.empty(); }
+
+  // Counts between start and stop are accumulated
+  void start();
+  void stop();
+
+  long long references() const { return m_references; }
+  long long misses() const { return m_misses; }
+  double miss_rate() const {
+    return m_references > 0 ? static_cast<double>(m_misses) / m_references
+                            : 0.0;
+  }
+
+private:
+  // A reference and a miss counter per thread
+  std::vector<int> m_fds;
+  long long m_references;
+  long long m_misses;
+};
+
+} // namespace Homme
+
+#endif // HOMMEXX_CACHE_MISS_COUNTER_HPP
@@ -5,9 +5,10 @@ namespace Homme {
 void Control::init(const int nets_in, const int nete_in,
                    const int num_elems_in, const int nm1_in,
                    const int n0_in, const int np1_in, const int qn0_in,
-                   const Real dt_in, const Real ps0_in,
+                   const int qsize_in, const Real dt_in, const Real ps0_in,
                    const bool compute_diagonstics_in,
-                   const Real eta_ave_w_in, CRCPtr hybrid_a_ptr) {
+                   const Real eta_ave_w_in, const int rsplit_in,
+                   CRCPtr hybrid_a_ptr, CRCPtr hybrid_b_ptr) {
   nets = nets_in;
   nete = nete_in;
   num_elems = num_elems_in;
@@ -15,15 +16,28 @@ void Control::init(const int nets_in, const int nete_in,
   nm1 = nm1_in;
   np1 = np1_in;
   qn0 = qn0_in;
+  n0_qdp = qn0 >= 0 ? qn0 : 0;
+  np1_qdp = (n0_qdp + 1) % Q_NUM_TIME_LEVELS;
+  qsize = qsize_in;
   dt  = dt_in;
   ps0 = ps0_in;
   compute_diagonstics = compute_diagonstics_in;
   eta_ave_w = eta_ave_w_in;
+  rsplit = rsplit_in;
   hybrid_a = ExecViewManaged<Real[NUM_LEV_P]>(
       "Hybrid coordinates; translates between pressure and velocity");
 
   HostViewUnmanaged<const Real[NUM_LEV_P]> host_hybrid_a(hybrid_a_ptr);
   Kokkos::deep_copy(hybrid_a, host_hybrid_a);
+
+  hybrid_b = ExecViewManaged<Scalar[NUM_LEV_P]>("Hybrid b at the interfaces");
+  ExecViewManaged<Scalar[NUM_LEV_P]>::HostMirror host_hybrid_b =
+      Kokkos::create_mirror_view(hybrid_b);
+  for (int ilevel = 0; ilevel < NUM_INTERFACE_LEV; ++ilevel) {
+    host_hybrid_b(ilevel / VECTOR_SIZE)[ilevel % VECTOR_SIZE] =
+        hybrid_b_ptr[ilevel];
+  }
+  Kokkos::deep_copy(hybrid_b, host_hybrid_b);
 }
 
 Control &get_control() {
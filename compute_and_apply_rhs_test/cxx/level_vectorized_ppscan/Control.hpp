@@ -12,9 +12,10 @@ struct Control {
   // This constructor should only be used by the host
   void init (const int nets, const int nete, const int num_elems,
              const int nm1,  const int n0,   const int np1,
-             const int qn0,  const Real dt2, const Real ps0,
+             const int qn0,  const int qsize,
+             const Real dt2, const Real ps0,
              const bool compute_diagonstics, const Real eta_ave_w,
-             CRCPtr hybrid_a_ptr);
+             const int rsplit, CRCPtr hybrid_a_ptr, CRCPtr hybrid_b_ptr);
 
   // Range of element indices to be handled by this thread is [nets,nete)
   int nets;
@@ -31,6 +32,10 @@ struct Control {
   // Tracers timelevel, inclusive range of 0-1
   int qn0;
 
+  // Tracer time levels read and written by the Euler step
+  int n0_qdp;
+  int np1_qdp;
+
   // Number of tracers (may be lower than QSIZE_D)
   int qsize;
 
@@ -40,6 +45,8 @@ struct Control {
   // Weight for eta_dot_dpdn mean flux
   Real eta_ave_w;
 
+  // Compute the energy and mass diagnostics (CaarDiagnostics) in CAAR,
+  // launched as a parallel_reduce over the elements
   int compute_diagonstics;
 
   int ps0;
@@ -48,8 +55,31 @@ struct Control {
   // apply remap every rsplit tracer timesteps
   int rsplit;
 
+  // Write the np1 state of CAAR with streaming (non-temporal) stores
+  // (HOMMEXX_STREAMING_STORES=1 in the benchmark). dp3d(np1) keeps regular
+  // stores without stream_dp3d: StepFunctor clears it, since its Euler step
+  // reads dp3d(np1) right after CAAR, from the cache a streaming store
+  // would have bypassed
+  bool streaming_stores = false;
+  bool stream_dp3d = true;
+
+  // Prefetch the inputs of the element a team will evaluate
+  // prefetch_distance elements later (0: no prefetch), with the locality of
+  // __builtin_prefetch (3: all levels of the cache, 0: non temporal)
+  int prefetch_distance = 0;
+  int prefetch_locality = 2;
+
+  // Evaluate CAAR with the double buffered pipeline of CaarFunctor, over
+  // pipeline_teams teams each with a contiguous range of the elements
+  // (HOMMEXX_PIPELINE=1 in the benchmark; 0: a team per element)
+  int pipeline_teams = 0;
+
   // hybryd a
   ExecViewManaged<Real[NUM_LEV_P]> hybrid_a;
+
+  // hybrid b at the interfaces, packed like eta_dot_dpdn
+  // (only needed when rsplit is 0)
+  ExecViewManaged<Scalar[NUM_LEV_P]> hybrid_b;
 };
 
 Control& get_control ();
@@ -1,9 +1,10 @@
 #include "Derivative.hpp"
+#include "PhysicalConstants.hpp"
 
 namespace Homme {
 
 Derivative::Derivative()
-    : m_dvv_exec("dvv")
+    : m_dvv_exec("dvv"), m_dvv_rrearth_exec("dvv * rrearth")
 {
   // Nothing to be done here
 }
@@ -20,6 +21,7 @@ void Derivative::init(CF90Ptr &dvv_ptr) {
   }
 
   Kokkos::deep_copy(m_dvv_exec, dvv_host);
+  compute_dvv_rrearth();
 }
 
 void Derivative::random_init(std::mt19937_64 &engine) {
@@ -32,6 +34,22 @@ void Derivative::random_init(std::mt19937_64 &engine) {
     }
   }
   Kokkos::deep_copy(m_dvv_exec, dvv_host);
+  compute_dvv_rrearth();
+}
+
+void Derivative::compute_dvv_rrearth() {
+  ExecViewManaged<Real[NP][NP]>::HostMirror dvv_host =
+      Kokkos::create_mirror_view(m_dvv_exec);
+  ExecViewManaged<Real[NP][NP]>::HostMirror dvv_rrearth_host =
+      Kokkos::create_mirror_view(m_dvv_rrearth_exec);
+  Kokkos::deep_copy(dvv_host, m_dvv_exec);
+  for (int igp = 0; igp < NP; ++igp) {
+    for (int jgp = 0; jgp < NP; ++jgp) {
+      dvv_rrearth_host(igp, jgp) =
+          dvv_host(igp, jgp) * PhysicalConstants::rrearth;
+    }
+  }
+  Kokkos::deep_copy(m_dvv_rrearth_exec, dvv_rrearth_host);
 }
 
 void Derivative::dvv(Real *dvv_ptr) {
@@ -20,8 +20,17 @@ public:
   KOKKOS_INLINE_FUNCTION
   ExecViewUnmanaged<const Real[NP][NP]> get_dvv() const { return m_dvv_exec; }
 
+  // dvv with the 1/rearth scaling of the gradient folded in
+  KOKKOS_INLINE_FUNCTION
+  ExecViewUnmanaged<const Real[NP][NP]> get_dvv_rrearth() const {
+    return m_dvv_rrearth_exec;
+  }
+
 private:
+  void compute_dvv_rrearth();
+
   ExecViewManaged<Real[NP][NP]> m_dvv_exec;
+  ExecViewManaged<Real[NP][NP]> m_dvv_rrearth_exec;
 };
 
 Derivative &get_derivative();
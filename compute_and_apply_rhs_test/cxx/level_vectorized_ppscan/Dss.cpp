@@ -0,0 +1,174 @@
+#include "Dss.hpp"
+#include "CubedSphere.hpp"
+
+#include <assert.h>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace Homme {
+
+constexpr int Dss::NUM_PERIMETER_POINTS;
+constexpr int Dss::MAX_SHARING;
+constexpr int Dss::NUM_STATE_FIELDS;
+
+void Dss::init(const CubedSphere &mesh, const Elements &elements) {
+  std::vector<int> elems(elements.num_elems());
+  for (int ie = 0; ie < elements.num_elems(); ++ie) {
+    elems[ie] = ie;
+  }
+  init(mesh, elements, elems);
+}
+
+void Dss::init(const CubedSphere &mesh, const Elements &elements,
+               const std::vector<int> &elems) {
+  const int num_elems = elements.num_elems();
+  std::vector<int> rows(num_elems);
+  std::map<int, int> assembled;
+  for (int ie = 0; ie < num_elems; ++ie) {
+    rows[ie] = ie;
+    assembled[elems[ie]] = ie;
+  }
+  m_own_buffer = ExecViewManaged<Scalar * * [NUM_PERIMETER_POINTS][NUM_LEV]>(
+      "DSS buffer", num_elems, NUM_STATE_FIELDS + elements.qsize());
+  m_buffer = m_own_buffer;
+  init_connectivity(mesh, elements, elems, rows, assembled);
+}
+
+void Dss::init(const CubedSphere &mesh, const Elements &elements,
+               const std::vector<int> &elems, Scalar *shared_buffer) {
+  std::map<int, int> assembled;
+  for (int elem = 0; elem < mesh.num_elems(); ++elem) {
+    assembled[elem] = elem;
+  }
+  m_buffer = ExecViewUnmanaged<Scalar * * [NUM_PERIMETER_POINTS][NUM_LEV]>(
+      shared_buffer, mesh.num_elems(), NUM_STATE_FIELDS + elements.qsize());
+  init_connectivity(mesh, elements, elems, elems, assembled);
+}
+
+size_t Dss::buffer_size(const CubedSphere &mesh, const int qsize) {
+  return static_cast<size_t>(mesh.num_elems()) * (NUM_STATE_FIELDS + qsize) *
+         NUM_PERIMETER_POINTS * NUM_LEV * sizeof(Scalar);
+}
+
+void Dss::init_connectivity(const CubedSphere &mesh, const Elements &elements,
+                            const std::vector<int> &elems,
+                            const std::vector<int> &rows,
+                            const std::map<int, int> &assembled) {
+  const int num_elems = elements.num_elems();
+  assert(static_cast<int>(elems.size()) == num_elems);
+  assert(num_elems <= mesh.num_elems());
+
+  // Mesh element and buffer slot of the copies of each shared point, in
+  // increasing mesh element order
+  std::map<int, std::vector<std::pair<int, int> > > point_slots;
+  for (const std::pair<const int, int> &elem_row : assembled) {
+    const int elem = elem_row.first;
+    for (int igp = 0; igp < NP; ++igp) {
+      for (int jgp = 0; jgp < NP; ++jgp) {
+        const int k = perimeter_index(igp, jgp);
+        if (k >= 0) {
+          point_slots[mesh.m_gids[(elem * NP + igp) * NP + jgp]].push_back(
+              std::make_pair(elem, elem_row.second * NUM_PERIMETER_POINTS + k));
+        }
+      }
+    }
+  }
+
+  m_sources = ExecViewManaged<int * [NUM_PERIMETER_POINTS][MAX_SHARING]>(
+      "DSS sources", num_elems);
+  m_rspheremp = ExecViewManaged<Real * [NP][NP]>("RSPHEREMP", num_elems);
+  m_rows = ExecViewManaged<int *>("DSS buffer rows", num_elems);
+
+  ExecViewManaged<int *[NUM_PERIMETER_POINTS][MAX_SHARING]>::HostMirror
+  h_sources = Kokkos::create_mirror_view(m_sources);
+  ExecViewManaged<Real *[NP][NP]>::HostMirror h_rspheremp =
+      Kokkos::create_mirror_view(m_rspheremp);
+  ExecViewManaged<int *>::HostMirror h_rows =
+      Kokkos::create_mirror_view(m_rows);
+
+  // The spheremp of the elements of other processes comes from the mesh
+  auto spheremp = [&mesh](const int elem, const int igp, const int jgp) {
+    return mesh.m_spheremp[(elem * NP + igp) * NP + jgp];
+  };
+
+  for (int ie = 0; ie < num_elems; ++ie) {
+    const int elem = elems[ie];
+    h_rows(ie) = rows[ie];
+    for (int igp = 0; igp < NP; ++igp) {
+      for (int jgp = 0; jgp < NP; ++jgp) {
+        const int k = perimeter_index(igp, jgp);
+        if (k < 0) {
+          h_rspheremp(ie, igp, jgp) = 1.0 / spheremp(elem, igp, jgp);
+          continue;
+        }
+        // Assembled in the same order as the fields
+        const std::vector<std::pair<int, int> > &slots =
+            point_slots[mesh.m_gids[(elem * NP + igp) * NP + jgp]];
+        assert(static_cast<int>(slots.size()) <= MAX_SHARING);
+        Real assembled_spheremp = 0.0;
+        for (int is = 0; is < MAX_SHARING; ++is) {
+          if (is < static_cast<int>(slots.size())) {
+            const int slot = slots[is].second;
+            int igp_slot, jgp_slot;
+            perimeter_point(slot % NUM_PERIMETER_POINTS, igp_slot, jgp_slot);
+            const Real value = spheremp(slots[is].first, igp_slot, jgp_slot);
+            assembled_spheremp = is == 0 ? value : assembled_spheremp + value;
+            h_sources(ie, k, is) = slot;
+          } else {
+            h_sources(ie, k, is) = -1;
+          }
+        }
+        h_rspheremp(ie, igp, jgp) = 1.0 / assembled_spheremp;
+      }
+    }
+  }
+  Kokkos::deep_copy(m_sources, h_sources);
+  Kokkos::deep_copy(m_rspheremp, h_rspheremp);
+  Kokkos::deep_copy(m_rows, h_rows);
+}
+
+void Dss::exchange(const Elements &elements, const int tl,
+                   const int qn) const {
+  pack(elements, tl, qn, 0, elements.num_elems());
+  unpack(elements, tl, qn);
+}
+
+void Dss::pack(const Elements &elements, const int tl, const int qn,
+               const int nets, const int nete) const {
+  if (nete <= nets) {
+    return;
+  }
+  Kokkos::TeamPolicy<ExecSpace> policy(nete - nets, Kokkos::AUTO, 1);
+  Kokkos::parallel_for(policy, DssPackFunctor(elements, *this, tl, qn,
+                                              num_fields(elements, qn), nets));
+  ExecSpace::fence();
+}
+
+void Dss::pack_host(const Elements &elements, const int tl, const int qn,
+                    const int nets, const int nete) const {
+  const DssPackFunctor functor(elements, *this, tl, qn,
+                               num_fields(elements, qn), nets);
+  for (int ie = nets; ie < nete; ++ie) {
+    const int row = m_rows(ie);
+    for (int ifield = 0; ifield < functor.m_num_fields; ++ifield) {
+      for (int k = 0; k < NUM_PERIMETER_POINTS; ++k) {
+        int igp, jgp;
+        perimeter_point(k, igp, jgp);
+        for (int ilev = 0; ilev < NUM_LEV; ++ilev) {
+          m_buffer(row, ifield, k, ilev) =
+              functor.field(ie, ifield, igp, jgp, ilev);
+        }
+      }
+    }
+  }
+}
+
+void Dss::unpack(const Elements &elements, const int tl, const int qn) const {
+  Kokkos::TeamPolicy<ExecSpace> policy(elements.num_elems(), Kokkos::AUTO, 1);
+  Kokkos::parallel_for(policy, DssUnpackFunctor(elements, *this, tl, qn,
+                                                num_fields(elements, qn)));
+  ExecSpace::fence();
+}
+
+} // namespace Homme
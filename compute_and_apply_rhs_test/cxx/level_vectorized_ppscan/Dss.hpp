@@ -0,0 +1,245 @@
+#ifndef HOMMEXX_DSS_HPP
+#define HOMMEXX_DSS_HPP
+
+#include "Types.hpp"
+#include "Elements.hpp"
+#include "KernelVariables.hpp"
+
+#include <map>
+#include <vector>
+
+namespace Homme {
+
+class CubedSphere;
+
+// GLL points on the boundary of an element, counterclockwise from the
+// south-west corner. Returns -1 for an interior point
+KOKKOS_INLINE_FUNCTION int perimeter_index(const int igp, const int jgp) {
+  return igp == 0 ? jgp
+         : jgp == NP - 1 ? (NP - 1) + igp
+         : igp == NP - 1 ? 2 * (NP - 1) + (NP - 1 - jgp)
+         : jgp == 0 ? 3 * (NP - 1) + (NP - 1 - igp)
+         : -1;
+}
+
+// The point at index k of the boundary of an element
+KOKKOS_INLINE_FUNCTION void perimeter_point(const int k, int &igp, int &jgp) {
+  const int offset = k % (NP - 1);
+  switch (k / (NP - 1)) {
+  case 0:
+    igp = 0;
+    jgp = offset;
+    break;
+  case 1:
+    igp = offset;
+    jgp = NP - 1;
+    break;
+  case 2:
+    igp = NP - 1;
+    jgp = NP - 1 - offset;
+    break;
+  default:
+    igp = NP - 1 - offset;
+    jgp = 0;
+    break;
+  }
+}
+
+/* Direct stiffness summation of the prognostic variables: the values at the
+ * GLL points shared by several elements are summed, and all the points are
+ * then multiplied by rspheremp. This is the assembly that follows each CAAR
+ * call in HOMME (edgeVpack, bndry_exchangeV, edgeVunpack).
+ *
+ * The boundary points of every element are first packed into a contiguous
+ * buffer, with the level packs innermost. The sum at a point then reads the
+ * buffer slots of all the elements that share it in increasing element
+ * order, so that every copy of a shared point gets bitwise the same value.
+ *
+ * The buffer has a row per element of the mesh, so it can also be shared by
+ * several processes that each own a part of the mesh: once they all packed
+ * their elements, each of them can assemble its own. */
+class Dss {
+public:
+  static constexpr int NUM_PERIMETER_POINTS = 4 * (NP - 1);
+  // Elements sharing a point of a quadrilateral mesh
+  static constexpr int MAX_SHARING = 4;
+  // u, v, T and dp3d
+  static constexpr int NUM_STATE_FIELDS = 4;
+
+  Dss() = default;
+
+  // Connectivity of the first elements.num_elems() elements of the mesh.
+  // Contributions of the elements past those (other processes) are not
+  // included
+  void init(const CubedSphere &mesh, const Elements &elements);
+
+  // Same, for elements that hold the elements elems of the mesh, in any
+  // order. The sums do not depend on that order
+  void init(const CubedSphere &mesh, const Elements &elements,
+            const std::vector<int> &elems);
+
+  // Connectivity of all the elements of the mesh, of which elements holds
+  // elems (e.g. from CubedSphere::partition). The other ones are packed by
+  // other processes into shared_buffer, of buffer_size(mesh, qsize) bytes
+  void init(const CubedSphere &mesh, const Elements &elements,
+            const std::vector<int> &elems, Scalar *shared_buffer);
+
+  static size_t buffer_size(const CubedSphere &mesh, const int qsize);
+
+  // Assembles u, v, T and dp3d at time level tl and, if qn is not negative,
+  // the tracers at time level qn
+  void exchange(const Elements &elements, const int tl, const int qn) const;
+
+  // The two halves of exchange: pack the elements [nets, nete) into the
+  // buffer, and assemble all the elements once everything is packed
+  void pack(const Elements &elements, const int tl, const int qn,
+            const int nets, const int nete) const;
+  void unpack(const Elements &elements, const int tl, const int qn) const;
+
+  // Same as pack, on the calling thread instead of in a kernel, so that it
+  // can run while a kernel computes other elements (host memory only)
+  void pack_host(const Elements &elements, const int tl, const int qn,
+                 const int nets, const int nete) const;
+
+  // 1 / the assembled spheremp
+  ExecViewManaged<Real * [NP][NP]> m_rspheremp;
+
+  // Buffer slots (buffer row * NUM_PERIMETER_POINTS + k) of the elements
+  // that share each boundary point, in increasing order of their mesh
+  // element; -1 past the last one
+  ExecViewManaged<int * [NUM_PERIMETER_POINTS][MAX_SHARING]> m_sources;
+
+  // Buffer row of each element: its mesh element in a shared buffer, itself
+  // otherwise
+  ExecViewManaged<int *> m_rows;
+
+  // Boundary values of the elements, field by field
+  ExecViewUnmanaged<Scalar ** [NUM_PERIMETER_POINTS][NUM_LEV]> m_buffer;
+
+private:
+  // Sums the contributions of the mesh elements in assembled, at the given
+  // buffer rows
+  void init_connectivity(const CubedSphere &mesh, const Elements &elements,
+                         const std::vector<int> &elems,
+                         const std::vector<int> &rows,
+                         const std::map<int, int> &assembled);
+
+  int num_fields(const Elements &elements, const int qn) const {
+    return NUM_STATE_FIELDS + (qn >= 0 ? elements.qsize() : 0);
+  }
+
+  ExecViewManaged<Scalar ** [NUM_PERIMETER_POINTS][NUM_LEV]> m_own_buffer;
+};
+
+// Copies the boundary points of the fields of the elements [nets, nete)
+// into the buffer
+struct DssPackFunctor {
+  const Elements m_elements;
+  const ExecViewManaged<int *> m_rows;
+  const ExecViewUnmanaged<Scalar ** [Dss::NUM_PERIMETER_POINTS][NUM_LEV]>
+  m_buffer;
+  const int m_tl;
+  const int m_qn;
+  const int m_num_fields;
+  const int m_nets;
+
+  DssPackFunctor(const Elements &elements, const Dss &dss, const int tl,
+                 const int qn, const int num_fields, const int nets = 0)
+      : m_elements(elements), m_rows(dss.m_rows), m_buffer(dss.m_buffer),
+        m_tl(tl), m_qn(qn), m_num_fields(num_fields), m_nets(nets) {}
+
+  KOKKOS_INLINE_FUNCTION
+  Scalar &field(const int ie, const int ifield, const int igp, const int jgp,
+                const int ilev) const {
+    switch (ifield) {
+    case 0:
+      return m_elements.m_u(ie, m_tl, igp, jgp, ilev);
+    case 1:
+      return m_elements.m_v(ie, m_tl, igp, jgp, ilev);
+    case 2:
+      return m_elements.m_t(ie, m_tl, igp, jgp, ilev);
+    case 3:
+      return m_elements.m_dp3d(ie, m_tl, igp, jgp, ilev);
+    default:
+      return m_elements.m_qdp(ie, m_qn, ifield - Dss::NUM_STATE_FIELDS, igp,
+                              jgp, ilev);
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const TeamMember &team) const {
+    KernelVariables kv(team, m_nets);
+    const int row = m_rows(kv.ie);
+    Kokkos::parallel_for(
+        Kokkos::TeamThreadRange(kv.team, m_num_fields * NP * NP),
+        [&](const int idx) {
+      const int ifield = idx / (NP * NP);
+      const int igp = (idx / NP) % NP;
+      const int jgp = idx % NP;
+      const int k = perimeter_index(igp, jgp);
+      if (k < 0) {
+        return;
+      }
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV),
+                           [&](const int &ilev) {
+        m_buffer(row, ifield, k, ilev) =
+            field(kv.ie, ifield, igp, jgp, ilev);
+      });
+    });
+  }
+};
+
+// Sums the buffer slots of each shared point, and scales all the points by
+// rspheremp
+struct DssUnpackFunctor {
+  const DssPackFunctor m_fields;
+  const ExecViewManaged<Real * [NP][NP]> m_rspheremp;
+  const ExecViewManaged<int * [Dss::NUM_PERIMETER_POINTS][Dss::MAX_SHARING]>
+  m_sources;
+
+  DssUnpackFunctor(const Elements &elements, const Dss &dss, const int tl,
+                   const int qn, const int num_fields)
+      : m_fields(elements, dss, tl, qn, num_fields),
+        m_rspheremp(dss.m_rspheremp), m_sources(dss.m_sources) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const TeamMember &team) const {
+    KernelVariables kv(team);
+    Kokkos::parallel_for(
+        Kokkos::TeamThreadRange(kv.team, m_fields.m_num_fields * NP * NP),
+        [&](const int idx) {
+      const int ifield = idx / (NP * NP);
+      const int igp = (idx / NP) % NP;
+      const int jgp = idx % NP;
+      const int k = perimeter_index(igp, jgp);
+      const Real rspheremp = m_rspheremp(kv.ie, igp, jgp);
+      if (k < 0) {
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV),
+                             [&](const int &ilev) {
+          m_fields.field(kv.ie, ifield, igp, jgp, ilev) *= rspheremp;
+        });
+        return;
+      }
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV),
+                           [&](const int &ilev) {
+        const int first = m_sources(kv.ie, k, 0);
+        Scalar sum =
+            m_fields.m_buffer(first / Dss::NUM_PERIMETER_POINTS, ifield,
+                              first % Dss::NUM_PERIMETER_POINTS, ilev);
+        for (int is = 1; is < Dss::MAX_SHARING; ++is) {
+          const int slot = m_sources(kv.ie, k, is);
+          if (slot < 0) {
+            break;
+          }
+          sum += m_fields.m_buffer(slot / Dss::NUM_PERIMETER_POINTS, ifield,
+                                   slot % Dss::NUM_PERIMETER_POINTS, ilev);
+        }
+        m_fields.field(kv.ie, ifield, igp, jgp, ilev) = sum * rspheremp;
+      });
+    });
+  }
+};
+
+} // namespace Homme
+
+#endif // HOMMEXX_DSS_HPP
@@ -1,48 +1,111 @@
 #include "Elements.hpp"
 #include "Utility.hpp"
+#include "PhysicalConstants.hpp"
 
+#include <algorithm>
 #include <assert.h>
 
 namespace Homme {
 
-void Elements::init(const int num_elems) {
+namespace {
+
+// Element ie of view becomes the element order[ie]. The element is the
+// slowest index of all the views (LayoutRight), so it is a contiguous block
+template <typename ViewType>
+void permute_elements(const ViewType &view, const std::vector<int> &order) {
+  if (view.size() == 0) {
+    return;
+  }
+  typename ViewType::HostMirror h_original = Kokkos::create_mirror(view);
+  typename ViewType::HostMirror h_permuted = Kokkos::create_mirror_view(view);
+  Kokkos::deep_copy(h_original, view);
+  const size_t elem_size = view.size() / view.extent(0);
+  for (size_t ie = 0; ie < order.size(); ++ie) {
+    std::copy(h_original.data() + order[ie] * elem_size,
+              h_original.data() + (order[ie] + 1) * elem_size,
+              h_permuted.data() + ie * elem_size);
+  }
+  Kokkos::deep_copy(view, h_permuted);
+}
+
+} // namespace
+
+PagePolicy ElementsStorage::page_policy() const {
+  return m_slab ? m_slab->policy() : PagePolicy::DEFAULT;
+}
+
+size_t ElementsStorage::slab_size() const {
+  return m_slab ? m_slab->size() : 0;
+}
+
+void Elements::init(const int num_elems, const int qsize) {
+  assert(qsize >= 0 && qsize <= QSIZE_D);
   m_num_elems = num_elems;
+  m_qsize = qsize;
+  allocate_views(nullptr);
+}
 
-  buffers.init(num_elems);
-
-  m_fcor = ExecViewManaged<Real * [NP][NP]>("FCOR", m_num_elems);
-  m_spheremp = ExecViewManaged<Real * [NP][NP]>("SPHEREMP", m_num_elems);
-  m_metdet = ExecViewManaged<Real * [NP][NP]>("METDET", m_num_elems);
-  m_phis = ExecViewManaged<Real * [NP][NP]>("PHIS", m_num_elems);
-
-  m_d =
-      ExecViewManaged<Real * [2][2][NP][NP]>("D - metric tensor", m_num_elems);
-  m_dinv = ExecViewManaged<Real * [2][2][NP][NP]>(
-      "DInv - inverse metric tensor", m_num_elems);
-
-  m_omega_p =
-      ExecViewManaged<Scalar * [NP][NP][NUM_LEV]>("Omega P", m_num_elems);
-  m_pecnd = ExecViewManaged<Scalar * [NP][NP][NUM_LEV]>("PECND", m_num_elems);
-  m_phi = ExecViewManaged<Scalar * [NP][NP][NUM_LEV]>("PHI", m_num_elems);
-  m_derived_un0 = ExecViewManaged<Scalar * [NP][NP][NUM_LEV]>(
-      "Derived Lateral Velocity 1", m_num_elems);
-  m_derived_vn0 = ExecViewManaged<Scalar * [NP][NP][NUM_LEV]>(
-      "Derived Lateral Velocity 2", m_num_elems);
-
-  m_u = ExecViewManaged<Scalar * [NUM_TIME_LEVELS][NP][NP][NUM_LEV]>(
-      "Lateral Velocity 1", m_num_elems);
-  m_v = ExecViewManaged<Scalar * [NUM_TIME_LEVELS][NP][NP][NUM_LEV]>(
-      "Lateral Velocity 2", m_num_elems);
-  m_t = ExecViewManaged<Scalar * [NUM_TIME_LEVELS][NP][NP][NUM_LEV]>(
-      "Temperature", m_num_elems);
-  m_dp3d = ExecViewManaged<Scalar * [NUM_TIME_LEVELS][NP][NP][NUM_LEV]>(
-      "DP3D", m_num_elems);
-
-  m_qdp =
-      ExecViewManaged<Scalar * [Q_NUM_TIME_LEVELS][QSIZE_D][NP][NP][NUM_LEV]>(
-          "qdp", m_num_elems);
-  m_eta_dot_dpdn = ExecViewManaged<Scalar * [NP][NP][NUM_LEV_P]>("eta_dot_dpdn",
-                                                                 m_num_elems);
+void Elements::init(const int num_elems, const int qsize,
+                    const PagePolicy pages, ElementsStorage &storage) {
+  assert(qsize >= 0 && qsize <= QSIZE_D);
+  m_num_elems = num_elems;
+  m_qsize = qsize;
+  storage.m_original_order.clear();
+
+  storage.m_slab.reset();
+  if (pages != PagePolicy::DEFAULT) {
+    // A first pass through the views adds up the size of the slab
+    PageSlab sizes;
+    allocate_views(&sizes);
+    storage.m_slab.reset(new PageSlab(sizes.carved(), pages));
+    if (!storage.m_slab->mapped()) {
+      storage.m_slab.reset();
+    }
+  }
+  allocate_views(storage.m_slab.get());
+}
+
+void Elements::allocate_views(PageSlab *slab) {
+  buffers.init(m_num_elems, m_qsize, slab);
+  geometry.init(m_num_elems, slab);
+
+  m_fcor = allocate_view<ExecViewManaged<Real * [NP][NP]> >(slab, "FCOR",
+                                                            m_num_elems);
+  m_spheremp = allocate_view<ExecViewManaged<Real * [NP][NP]> >(
+      slab, "SPHEREMP", m_num_elems);
+  m_metdet = allocate_view<ExecViewManaged<Real * [NP][NP]> >(slab, "METDET",
+                                                              m_num_elems);
+  m_phis = allocate_view<ExecViewManaged<Real * [NP][NP]> >(slab, "PHIS",
+                                                            m_num_elems);
+
+  m_d = allocate_view<ExecViewManaged<Real * [2][2][NP][NP]> >(
+      slab, "D - metric tensor", m_num_elems);
+  m_dinv = allocate_view<ExecViewManaged<Real * [2][2][NP][NP]> >(
+      slab, "DInv - inverse metric tensor", m_num_elems);
+
+  m_omega_p = allocate_view<ExecViewManaged<Scalar * [NP][NP][NUM_LEV]> >(
+      slab, "Omega P", m_num_elems);
+  m_pecnd = allocate_view<ExecViewManaged<Scalar * [NP][NP][NUM_LEV]> >(
+      slab, "PECND", m_num_elems);
+  m_phi = allocate_view<ExecViewManaged<Scalar * [NP][NP][NUM_LEV]> >(
+      slab, "PHI", m_num_elems);
+  m_derived_un0 = allocate_view<ExecViewManaged<Scalar * [NP][NP][NUM_LEV]> >(
+      slab, "Derived Lateral Velocity 1", m_num_elems);
+  m_derived_vn0 = allocate_view<ExecViewManaged<Scalar * [NP][NP][NUM_LEV]> >(
+      slab, "Derived Lateral Velocity 2", m_num_elems);
+
+  using StateView =
+      ExecViewManaged<Scalar * [NUM_TIME_LEVELS][NP][NP][NUM_LEV]>;
+  m_u = allocate_view<StateView>(slab, "Lateral Velocity 1", m_num_elems);
+  m_v = allocate_view<StateView>(slab, "Lateral Velocity 2", m_num_elems);
+  m_t = allocate_view<StateView>(slab, "Temperature", m_num_elems);
+  m_dp3d = allocate_view<StateView>(slab, "DP3D", m_num_elems);
+
+  m_qdp = allocate_view<ExecViewManaged<Scalar * * * [NP][NP][NUM_LEV]> >(
+      slab, "qdp", m_num_elems, Q_NUM_TIME_LEVELS, m_qsize);
+  m_eta_dot_dpdn =
+      allocate_view<ExecViewManaged<Scalar * [NP][NP][NUM_LEV_P]> >(
+          slab, "eta_dot_dpdn", m_num_elems);
 }
 
 void Elements::init_2d(CF90Ptr &D, CF90Ptr &Dinv, CF90Ptr &fcor,
@@ -96,10 +159,24 @@ void Elements::init_2d(CF90Ptr &D, CF90Ptr &Dinv, CF90Ptr &fcor,
 
   Kokkos::deep_copy(m_d, h_d);
   Kokkos::deep_copy(m_dinv, h_dinv);
+
+  geometry.compute(m_d, m_dinv, m_metdet);
 }
 
-void Elements::random_init(const int num_elems, std::mt19937_64 &engine) {
-  init(num_elems);
+void Elements::random_init(const int num_elems, const int qsize,
+                           std::mt19937_64 &engine) {
+  init(num_elems, qsize);
+  random_fill(engine);
+}
+
+void Elements::random_init(const int num_elems, const int qsize,
+                           std::mt19937_64 &engine, const PagePolicy pages,
+                           ElementsStorage &storage) {
+  init(num_elems, qsize, pages, storage);
+  random_fill(engine);
+}
+
+void Elements::random_fill(std::mt19937_64 &engine) {
   constexpr const Real min_value = 0.015625;
   std::uniform_real_distribution<Real> random_dist(min_value, 1.0);
 
@@ -148,6 +225,8 @@ void Elements::random_init(const int num_elems, std::mt19937_64 &engine) {
   }
 
   Kokkos::deep_copy(m_dinv, h_dinv);
+
+  geometry.compute(m_d, m_dinv, m_metdet);
   return;
 }
 
@@ -269,13 +348,15 @@ void Elements::pull_eta_dot(CF90Ptr &derived_eta_dot_dpdn) {
   Kokkos::deep_copy(m_eta_dot_dpdn, h_eta_dot_dpdn);
 }
 
+// The F90 array is always dimensioned for QSIZE_D tracers;
+// the slots past qsize are skipped
 void Elements::pull_qdp(CF90Ptr &state_qdp) {
-  ExecViewManaged<
-      Scalar *[Q_NUM_TIME_LEVELS][QSIZE_D][NP][NP][NUM_LEV]>::HostMirror h_qdp =
+  ExecViewManaged<Scalar ***[NP][NP][NUM_LEV]>::HostMirror h_qdp =
       Kokkos::create_mirror_view(m_qdp);
+  const int unused_qdp = (QSIZE_D - m_qsize) * NUM_PHYSICAL_LEV * NP * NP;
   for (int ie = 0, k_qdp = 0; ie < m_num_elems; ++ie) {
-    for (int qni = 0; qni < Q_NUM_TIME_LEVELS; ++qni) {
-      for (int iq = 0; iq < QSIZE_D; ++iq) {
+    for (int qni = 0; qni < Q_NUM_TIME_LEVELS; ++qni, k_qdp += unused_qdp) {
+      for (int iq = 0; iq < m_qsize; ++iq) {
         for (int ilevel = 0; ilevel < NUM_PHYSICAL_LEV; ++ilevel) {
           int ilev = ilevel / VECTOR_SIZE;
           int ivector = ilevel % VECTOR_SIZE;
@@ -413,13 +494,13 @@ void Elements::push_eta_dot(F90Ptr &derived_eta_dot_dpdn) const {
 }
 
 void Elements::push_qdp(F90Ptr &state_qdp) const {
-  ExecViewManaged<
-      Scalar *[Q_NUM_TIME_LEVELS][QSIZE_D][NP][NP][NUM_LEV]>::HostMirror h_qdp =
+  ExecViewManaged<Scalar ***[NP][NP][NUM_LEV]>::HostMirror h_qdp =
       Kokkos::create_mirror_view(m_qdp);
-  Kokkos::deep_copy(m_qdp, h_qdp);
+  Kokkos::deep_copy(h_qdp, m_qdp);
+  const int unused_qdp = (QSIZE_D - m_qsize) * NUM_PHYSICAL_LEV * NP * NP;
   for (int ie = 0, k_qdp = 0; ie < m_num_elems; ++ie) {
-    for (int qni = 0; qni < Q_NUM_TIME_LEVELS; ++qni) {
-      for (int iq = 0; iq < QSIZE_D; ++iq) {
+    for (int qni = 0; qni < Q_NUM_TIME_LEVELS; ++qni, k_qdp += unused_qdp) {
+      for (int iq = 0; iq < m_qsize; ++iq) {
         for (int ilevel = 0; ilevel < NUM_PHYSICAL_LEV; ++ilevel) {
           int ilev = ilevel / VECTOR_SIZE;
           int ivector = ilevel % VECTOR_SIZE;
@@ -459,42 +540,138 @@ void Elements::dinv(Real *dinv_ptr, int ie) const {
   Kokkos::deep_copy(dinv_host, dinv_device);
 }
 
-void Elements::BufferViews::init(int num_elems) {
-  pressure =
-      ExecViewManaged<Scalar * [NP][NP][NUM_LEV]>("Pressure buffer", num_elems);
-  pressure_grad = ExecViewManaged<Scalar * [2][NP][NP][NUM_LEV]>(
-      "Gradient of pressure", num_elems);
-  temperature_virt = ExecViewManaged<Scalar * [NP][NP][NUM_LEV]>(
-      "Virtual Temperature", num_elems);
-  temperature_grad = ExecViewManaged<Scalar * [2][NP][NP][NUM_LEV]>(
-      "Gradient of temperature", num_elems);
-  omega_p = ExecViewManaged<Scalar * [NP][NP][NUM_LEV]>(
-      "Omega_P why two named the same thing???", num_elems);
-  vdp = ExecViewManaged<Scalar * [2][NP][NP][NUM_LEV]>("vdp???", num_elems);
-  div_vdp = ExecViewManaged<Scalar * [NP][NP][NUM_LEV]>(
-      "Divergence of dp3d * u", num_elems);
-  ephi = ExecViewManaged<Scalar * [NP][NP][NUM_LEV]>(
-      "Kinetic Energy + Geopotential Energy", num_elems);
-  energy_grad = ExecViewManaged<Scalar * [2][NP][NP][NUM_LEV]>(
-      "Gradient of ephi", num_elems);
-  vorticity =
-      ExecViewManaged<Scalar * [NP][NP][NUM_LEV]>("Vorticity", num_elems);
-
-  qtens = ExecViewManaged<Scalar * [QSIZE_D][NP][NP][NUM_LEV]>(
-      "buffer for tracers", num_elems);
-  vstar = ExecViewManaged<Scalar * [2][NP][NP][NUM_LEV]>("buffer for v/dp",
-                                                         num_elems);
-  vstar_qdp = ExecViewManaged<Scalar * [QSIZE_D][2][NP][NP][NUM_LEV]>(
-      "buffer for vstar*qdp", num_elems);
-
-  preq_buf = ExecViewManaged<Real * [NP][NP]>("Preq Buffer", num_elems);
-
-  div_buf = ExecViewManaged<Scalar * [2][NP][NP][NUM_LEV]>("Divergence Buffer",
-                                                           num_elems);
-  grad_buf = ExecViewManaged<Scalar * [2][NP][NP][NUM_LEV]>("Gradient Buffer",
-                                                            num_elems);
-  vort_buf = ExecViewManaged<Scalar * [2][NP][NP][NUM_LEV]>("Vorticity Buffer",
-                                                            num_elems);
+void Elements::reorder(const std::vector<int> &order,
+                       ElementsStorage &storage) {
+  assert(static_cast<int>(order.size()) == m_num_elems);
+
+  permute_elements(m_fcor, order);
+  permute_elements(m_spheremp, order);
+  permute_elements(m_metdet, order);
+  permute_elements(m_phis, order);
+  // Also covariant and contravariant, which are the same views
+  permute_elements(m_d, order);
+  permute_elements(m_dinv, order);
+  permute_elements(geometry.contravariant_metdet, order);
+  permute_elements(geometry.rmetdet, order);
+
+  permute_elements(m_omega_p, order);
+  permute_elements(m_pecnd, order);
+  permute_elements(m_phi, order);
+  permute_elements(m_derived_un0, order);
+  permute_elements(m_derived_vn0, order);
+  permute_elements(m_u, order);
+  permute_elements(m_v, order);
+  permute_elements(m_t, order);
+  permute_elements(m_dp3d, order);
+  permute_elements(m_qdp, order);
+  permute_elements(m_eta_dot_dpdn, order);
+
+  std::vector<int> &original_order = storage.m_original_order;
+  if (original_order.empty()) {
+    original_order = order;
+  } else {
+    std::vector<int> reordered(m_num_elems);
+    for (int ie = 0; ie < m_num_elems; ++ie) {
+      reordered[ie] = original_order[order[ie]];
+    }
+    original_order = reordered;
+  }
+}
+
+void Elements::restore_order(ElementsStorage &storage) {
+  const std::vector<int> &original_order = storage.m_original_order;
+  if (original_order.empty()) {
+    return;
+  }
+  std::vector<int> order(m_num_elems);
+  for (int ie = 0; ie < m_num_elems; ++ie) {
+    order[original_order[ie]] = ie;
+  }
+  reorder(order, storage);
+}
+
+void Elements::GeometryFactors::init(const int num_elems, PageSlab *slab) {
+  contravariant_metdet = allocate_view<ExecViewManaged<Real * [2][2][NP][NP]> >(
+      slab, "metdet * DInv^T - divergence transform", num_elems);
+  rmetdet = allocate_view<ExecViewManaged<Real * [NP][NP]> >(
+      slab, "rrearth / metdet", num_elems);
+}
+
+void Elements::GeometryFactors::compute(
+    const ExecViewManaged<Real * [2][2][NP][NP]> &d,
+    const ExecViewManaged<Real * [2][2][NP][NP]> &dinv,
+    const ExecViewManaged<Real * [NP][NP]> &metdet) {
+  covariant = d;
+  contravariant = dinv;
+
+  ExecViewManaged<Real *[2][2][NP][NP]>::HostMirror h_dinv =
+      Kokkos::create_mirror_view(dinv);
+  ExecViewManaged<Real *[NP][NP]>::HostMirror h_metdet =
+      Kokkos::create_mirror_view(metdet);
+  Kokkos::deep_copy(h_dinv, dinv);
+  Kokkos::deep_copy(h_metdet, metdet);
+
+  ExecViewManaged<Real *[2][2][NP][NP]>::HostMirror h_contravariant_metdet =
+      Kokkos::create_mirror_view(contravariant_metdet);
+  ExecViewManaged<Real *[NP][NP]>::HostMirror h_rmetdet =
+      Kokkos::create_mirror_view(rmetdet);
+  for (int ie = 0; ie < h_metdet.extent_int(0); ++ie) {
+    for (int igp = 0; igp < NP; ++igp) {
+      for (int jgp = 0; jgp < NP; ++jgp) {
+        for (int idim = 0; idim < 2; ++idim) {
+          for (int jdim = 0; jdim < 2; ++jdim) {
+            h_contravariant_metdet(ie, idim, jdim, igp, jgp) =
+                h_dinv(ie, jdim, idim, igp, jgp) * h_metdet(ie, igp, jgp);
+          }
+        }
+        h_rmetdet(ie, igp, jgp) =
+            1.0 / h_metdet(ie, igp, jgp) * PhysicalConstants::rrearth;
+      }
+    }
+  }
+  Kokkos::deep_copy(contravariant_metdet, h_contravariant_metdet);
+  Kokkos::deep_copy(rmetdet, h_rmetdet);
+}
+
+void Elements::BufferViews::init(const int num_elems, const int qsize,
+                                 PageSlab *slab) {
+  using LevelView = ExecViewManaged<Scalar * [NP][NP][NUM_LEV]>;
+  using VectorView = ExecViewManaged<Scalar * [2][NP][NP][NUM_LEV]>;
+  pressure = allocate_view<LevelView>(slab, "Pressure buffer", num_elems);
+  pressure_grad =
+      allocate_view<VectorView>(slab, "Gradient of pressure", num_elems);
+  temperature_virt =
+      allocate_view<LevelView>(slab, "Virtual Temperature", num_elems);
+  temperature_grad =
+      allocate_view<VectorView>(slab, "Gradient of temperature", num_elems);
+  omega_p = allocate_view<LevelView>(
+      slab, "Omega_P why two named the same thing???", num_elems);
+  vdp = allocate_view<VectorView>(slab, "vdp???", num_elems);
+  div_vdp = allocate_view<LevelView>(slab, "Divergence of dp3d * u", num_elems);
+  ephi = allocate_view<LevelView>(
+      slab, "Kinetic Energy + Geopotential Energy", num_elems);
+  energy_grad = allocate_view<VectorView>(slab, "Gradient of ephi", num_elems);
+  vorticity = allocate_view<LevelView>(slab, "Vorticity", num_elems);
+  eta_dot_dpdn =
+      allocate_view<ExecViewManaged<Scalar * [NP][NP][NUM_LEV_P]> >(
+          slab, "Flux through the interfaces", num_elems);
+
+  qtens = allocate_view<ExecViewManaged<Scalar * * [NP][NP][NUM_LEV]> >(
+      slab, "buffer for tracers", num_elems, qsize);
+  vstar = allocate_view<VectorView>(slab, "buffer for v/dp", num_elems);
+  vstar_qdp =
+      allocate_view<ExecViewManaged<Scalar * * [2][NP][NP][NUM_LEV]> >(
+          slab, "buffer for vstar*qdp", num_elems, qsize);
+
+  preq_buf = allocate_view<ExecViewManaged<Real * [NP][NP]> >(
+      slab, "Preq Buffer", num_elems);
+  diagnostics_buf = allocate_view<
+      ExecViewManaged<Real * [CaarDiagnostics::NUM_DIAGNOSTICS][NP][NP]> >(
+      slab, "Column sums of the CAAR diagnostics", num_elems);
+
+  div_buf = allocate_view<VectorView>(slab, "Divergence Buffer", num_elems);
+  grad_buf = allocate_view<VectorView>(slab, "Gradient Buffer", num_elems);
+  vort_buf = allocate_view<VectorView>(slab, "Vorticity Buffer", num_elems);
 }
 
 Elements &get_elements() {
@@ -3,13 +3,39 @@
 
 #include "Types.hpp"
 #include "Utility.hpp"
+#include "PageSlab.hpp"
+#include "CaarDiagnostics.hpp"
 
 #include <Kokkos_Core.hpp>
 
+#include <memory>
 #include <random>
+#include <vector>
 
 namespace Homme {
 
+/* What a set of Elements keeps on the host besides its views: the slab of
+ * huge pages they are carved from and the order in which they were
+ * initialized. Elements is copied by value into every kernel functor, so it
+ * only holds views; the drivers own this next to it, for as long as the
+ * elements are used */
+class ElementsStorage {
+public:
+  // The pages the views got (DEFAULT if they are not in a slab), and the
+  // bytes of the slab
+  PagePolicy page_policy() const;
+  size_t slab_size() const;
+
+  // Index of each element in the order in which they were initialized
+  // (empty until Elements::reorder: the order of initialization)
+  const std::vector<int> &original_order() const { return m_original_order; }
+
+private:
+  friend class Elements;
+  std::unique_ptr<PageSlab> m_slab;
+  std::vector<int> m_original_order;
+};
+
 /* Per element data - specific velocity, temperature, pressure, etc. */
 class Elements {
 public:
@@ -45,17 +71,41 @@ public:
   ExecViewManaged<Scalar * [NUM_TIME_LEVELS][NP][NP][NUM_LEV]> m_dp3d;
 
   // q is the specific humidity
-  ExecViewManaged<Scalar * [Q_NUM_TIME_LEVELS][QSIZE_D][NP][NP][NUM_LEV]> m_qdp;
+  // Sized (num_elems, Q_NUM_TIME_LEVELS, qsize); qsize <= QSIZE_D
+  ExecViewManaged<Scalar *** [NP][NP][NUM_LEV]> m_qdp;
   // eta is the vertical coordinate
   // eta dot is the flux through the vertical level interface
   //    (note there are NUM_LEV_P of them)
   // dpdn is the derivative of pressure with respect to eta
   ExecViewManaged<Scalar * [NP][NP][NUM_LEV_P]> m_eta_dot_dpdn;
 
+  // Factors of the sphere operators that only depend on the geometry above,
+  // which never changes after init_2d/random_init. They are computed once
+  // there, so that the operators do not redo these multiplies and divisions
+  // for every level of every step
+  struct GeometryFactors {
+
+    GeometryFactors() = default;
+    void init(const int num_elems, PageSlab *slab);
+    void compute(const ExecViewManaged<Real * [2][2][NP][NP]> &d,
+                 const ExecViewManaged<Real * [2][2][NP][NP]> &dinv,
+                 const ExecViewManaged<Real * [NP][NP]> &metdet);
+
+    // Covariant transform of the vorticity (same view as m_d)
+    ExecViewManaged<Real * [2][2][NP][NP]> covariant;
+    // Contravariant transform of the gradient (same view as m_dinv)
+    ExecViewManaged<Real * [2][2][NP][NP]> contravariant;
+    // Contravariant transform of the divergence, metdet * dinv(jdim, idim):
+    // component idim of the result is sum_jdim (idim, jdim) * v(jdim)
+    ExecViewManaged<Real * [2][2][NP][NP]> contravariant_metdet;
+    // rrearth / metdet
+    ExecViewManaged<Real * [NP][NP]> rmetdet;
+  } geometry;
+
   struct BufferViews {
 
     BufferViews() = default;
-    void init(const int num_elems);
+    void init(const int num_elems, const int qsize, PageSlab *slab);
     ExecViewManaged<Scalar*    [NP][NP][NUM_LEV]> pressure;
     ExecViewManaged<Scalar* [2][NP][NP][NUM_LEV]> pressure_grad;
     ExecViewManaged<Scalar*    [NP][NP][NUM_LEV]> temperature_virt;
@@ -67,13 +117,18 @@ public:
     ExecViewManaged<Scalar*    [NP][NP][NUM_LEV]> ephi;
     ExecViewManaged<Scalar* [2][NP][NP][NUM_LEV]> energy_grad;
     ExecViewManaged<Scalar*    [NP][NP][NUM_LEV]> vorticity;
+    // Interface flux of this stage, only used when rsplit is 0
+    ExecViewManaged<Scalar*    [NP][NP][NUM_LEV_P]> eta_dot_dpdn;
 
     // Buffers for EulerStepFunctor
     ExecViewManaged<Scalar*          [2][NP][NP][NUM_LEV]>  vstar;
-    ExecViewManaged<Scalar* [QSIZE_D]   [NP][NP][NUM_LEV]>  qtens;
-    ExecViewManaged<Scalar* [QSIZE_D][2][NP][NP][NUM_LEV]>  vstar_qdp;
+    ExecViewManaged<Scalar**            [NP][NP][NUM_LEV]>  qtens;
+    ExecViewManaged<Scalar**         [2][NP][NP][NUM_LEV]>  vstar_qdp;
 
     ExecViewManaged<Real* [NP][NP]> preq_buf;
+    // Column sums of the CAAR diagnostics (see CaarDiagnostics)
+    ExecViewManaged<Real* [CaarDiagnostics::NUM_DIAGNOSTICS][NP][NP]>
+        diagnostics_buf;
     // Buffers for spherical operators
     ExecViewManaged<Scalar* [2][NP][NP][NUM_LEV]> div_buf;
     ExecViewManaged<Scalar* [2][NP][NP][NUM_LEV]> grad_buf;
@@ -82,11 +137,19 @@ public:
 
   Elements() = default;
 
-  void init(const int num_elems);
+  void init(const int num_elems, const int qsize);
+  // With a page policy other than DEFAULT, all the views (the buffers and
+  // the geometry factors too) are carved from one slab of huge pages, which
+  // storage owns
+  void init(const int num_elems, const int qsize, const PagePolicy pages,
+            ElementsStorage &storage);
 
-  void random_init(int num_elems, std::mt19937_64 &engine);
+  void random_init(int num_elems, int qsize, std::mt19937_64 &engine);
+  void random_init(int num_elems, int qsize, std::mt19937_64 &engine,
+                   const PagePolicy pages, ElementsStorage &storage);
 
   int num_elems() const { return m_num_elems; }
+  int qsize() const { return m_qsize; }
 
   // Fill the exec space views with data coming from F90 pointers
   void init_2d(CF90Ptr &D, CF90Ptr &Dinv, CF90Ptr &fcor, CF90Ptr &spheremp,
@@ -119,8 +182,23 @@ public:
   void d(Real *d_ptr, int ie) const;
   void dinv(Real *dinv_ptr, int ie) const;
 
+  // Permutes the elements, so that element ie is the one that was at
+  // order[ie] (e.g. along a space filling curve, to improve the locality of
+  // the accesses to the neighbours). All the views but the buffers are
+  // permuted, and storage records the order of initialization
+  void reorder(const std::vector<int> &order, ElementsStorage &storage);
+  // Puts the elements back in the order in which they were initialized, e.g.
+  // before pushing them to the F90 pointers
+  void restore_order(ElementsStorage &storage);
+
 private:
+  // Allocates all the views, in slab if it is not null
+  void allocate_views(PageSlab *slab);
+  // Fills the views allocated by init with random numbers
+  void random_fill(std::mt19937_64 &engine);
+
   int m_num_elems;
+  int m_qsize;
 };
 
 // TODO: DON'T USE SINGLETONS
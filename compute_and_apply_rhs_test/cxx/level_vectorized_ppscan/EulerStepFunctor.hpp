@@ -1,72 +1,137 @@
 #ifndef HOMMEXX_EULER_STEP_FUNCTOR_HPP
 #define HOMMEXX_EULER_STEP_FUNCTOR_HPP
 
+#include "Types.hpp"
+#include "Control.hpp"
 #include "Elements.hpp"
 #include "Derivative.hpp"
-#include "Control.hpp"
+#include "KernelVariables.hpp"
 #include "SphereOperators.hpp"
 
-namespace Homme
-{
+#include "Utility.hpp"
+#include "profiling.hpp"
+
+namespace Homme {
 
-struct EulerStepFunctor
-{
-  const Control     m_data;
-  const Elements      m_elements;
-  const Derivative  m_deriv;
+// Advects the tracers with the mean mass flux of the last CAAR call:
+//   qdp(np1_qdp) = spheremp * (qdp(n0_qdp) - dt * div(vn0 / dp3d(np1) * qdp))
+// which is the horizontal part of euler_step in HOMME, before its DSS
+struct EulerStepFunctor {
+  const Control m_data;
+  const Elements m_elements;
+  const Derivative m_deriv;
 
-  EulerStepFunctor (const Control& data)
-   : m_data    (data)
-   , m_elements  (get_elements())
-   , m_deriv   (get_derivative())
-  {
+  static constexpr Kokkos::Impl::ALL_t ALL = Kokkos::ALL;
+
+  KOKKOS_INLINE_FUNCTION
+  EulerStepFunctor(const Control &data, const Elements &elements,
+                   const Derivative &deriv)
+      : m_data(data), m_elements(elements), m_deriv(deriv) {
     // Nothing to be done here
   }
 
-  KOKKOS_INLINE_FUNCTION
-  static size_t shmem_size(int /*team_size*/) {
-    // One scalar buffer and two vector buffers
-    return 0;
+  // Computes vstar = (un0, vn0) / dp3d(np1), the only input of the tracers
+  // that CAAR computes
+  KOKKOS_INLINE_FUNCTION void compute_vstar(KernelVariables &kv) const {
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP),
+                         [&](const int idx) {
+      const int igp = idx / NP;
+      const int jgp = idx % NP;
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV),
+                           [&](const int &ilev) {
+        const Scalar &dp =
+            m_elements.m_dp3d(kv.ie, m_data.np1, igp, jgp, ilev);
+        m_elements.buffers.vstar(kv.ie, 0, igp, jgp, ilev) =
+            divide(m_elements.m_derived_un0(kv.ie, igp, jgp, ilev), dp);
+        m_elements.buffers.vstar(kv.ie, 1, igp, jgp, ilev) =
+            divide(m_elements.m_derived_vn0(kv.ie, igp, jgp, ilev), dp);
+      });
+    });
+    kv.team_barrier();
+  }
+
+  // Computes vstar * qdp(n0_qdp) for all the tracers
+  KOKKOS_INLINE_FUNCTION void compute_vstar_qdp(KernelVariables &kv) const {
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP),
+                         [&](const int idx) {
+      const int igp = idx / NP;
+      const int jgp = idx % NP;
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV),
+                           [&](const int &ilev) {
+        const Scalar &vstar_u =
+            m_elements.buffers.vstar(kv.ie, 0, igp, jgp, ilev);
+        const Scalar &vstar_v =
+            m_elements.buffers.vstar(kv.ie, 1, igp, jgp, ilev);
+        for (int iq = 0; iq < m_data.qsize; ++iq) {
+          const Scalar &qdp =
+              m_elements.m_qdp(kv.ie, m_data.n0_qdp, iq, igp, jgp, ilev);
+          m_elements.buffers.vstar_qdp(kv.ie, iq, 0, igp, jgp, ilev) =
+              vstar_u * qdp;
+          m_elements.buffers.vstar_qdp(kv.ie, iq, 1, igp, jgp, ilev) =
+              vstar_v * qdp;
+        }
+      });
+    });
+    kv.team_barrier();
+  }
+
+  // The divergences share div_buf, so the tracers are done one at a time
+  KOKKOS_INLINE_FUNCTION void compute_qtens(KernelVariables &kv) const {
+    for (int iq = 0; iq < m_data.qsize; ++iq) {
+      divergence_sphere(
+          kv, m_elements.geometry, m_deriv.get_dvv(),
+          Kokkos::subview(m_elements.buffers.vstar_qdp, kv.ie, iq, ALL, ALL,
+                          ALL, ALL),
+          m_elements.buffers.div_buf,
+          Kokkos::subview(m_elements.buffers.qtens, kv.ie, iq, ALL, ALL, ALL));
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION void compute_qdp_np1(KernelVariables &kv) const {
+    Kokkos::parallel_for(
+        Kokkos::TeamThreadRange(kv.team, m_data.qsize * NP * NP),
+        [&](const int idx) {
+      const int iq = idx / (NP * NP);
+      const int igp = (idx / NP) % NP;
+      const int jgp = idx % NP;
+      const Real spheremp = m_elements.m_spheremp(kv.ie, igp, jgp);
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV),
+                           [&](const int &ilev) {
+        Scalar &qtens = m_elements.buffers.qtens(kv.ie, iq, igp, jgp, ilev);
+        qtens = m_elements.m_qdp(kv.ie, m_data.n0_qdp, iq, igp, jgp, ilev) -
+                m_data.dt * qtens;
+        m_elements.m_qdp(kv.ie, m_data.np1_qdp, iq, igp, jgp, ilev) =
+            spheremp * qtens;
+      });
+    });
+    kv.team_barrier();
+  }
+
+  // The tracer update of the element kv.ie, once its vstar is computed
+  KOKKOS_INLINE_FUNCTION void compute_tracers(KernelVariables &kv) const {
+    compute_vstar_qdp(kv);
+    compute_qtens(kv);
+    compute_qdp_np1(kv);
+  }
+
+  // The Euler step of the element kv.ie, once its CAAR is done
+  KOKKOS_INLINE_FUNCTION void compute(KernelVariables &kv) const {
+    compute_vstar(kv);
+    compute_tracers(kv);
   }
 
   KOKKOS_INLINE_FUNCTION
-  void operator() (TeamMember team) const
-  {
-    KernelVariables kv(team);
-
-    ExecViewUnmanaged<const Real[2][2][NP][NP]> dinv   = Homme::subview(m_elements.m_dinv,kv.ie);
-    ExecViewUnmanaged<const Real[NP][NP]>       metdet = Homme::subview(m_elements.m_metdet,kv.ie);
-
-    Kokkos::parallel_for (
-      Kokkos::TeamThreadRange(team,NUM_LEV*m_data.qsize),
-      [&] (const int lev_q)
-      {
-        const int iq   = lev_q / NUM_LEV;
-        kv.ilev = lev_q % NUM_LEV;
-
-        ExecViewUnmanaged<const Scalar[NUM_LEV][NP][NP]> qdp   = Homme::subview(m_elements.m_qdp,kv.ie,m_data.qn0,iq);
-        ExecViewUnmanaged<Scalar[NUM_LEV][NP][NP]>       q_buf = Homme::subview(m_elements.buffers.qtens,kv.ie,iq);
-        ExecViewUnmanaged<Scalar[NUM_LEV][2][NP][NP]>    v_buf = Homme::subview(m_elements.buffers.vstar_qdp,kv.ie,iq);
-
-        Kokkos::parallel_for (
-          Kokkos::ThreadVectorRange (team, NP*NP),
-          [&] (const int idx)
-          {
-            const int igp = idx / NP;
-            const int jgp = idx % NP;
-
-            v_buf(0,kv.ilev,igp,jgp) = m_elements.buffers.vstar(kv.ie,kv.ilev,0,igp,jgp) * qdp(kv.ilev,igp,jgp);
-            v_buf(1,kv.ilev,igp,jgp) = m_elements.buffers.vstar(kv.ie,kv.ilev,1,igp,jgp) * qdp(kv.ilev,igp,jgp);
-            q_buf(kv.ilev,igp,jgp) = qdp(kv.ilev,igp,jgp);
-          }
-        );
-
-        divergence_sphere_update(kv, -m_data.dt, 1.0, dinv, metdet,
-                                 m_deriv.get_dvv(), v_buf, q_buf);
-      }
-    );
+  void operator()(const TeamMember &team) const {
+    start_timer("euler step compute");
+    KernelVariables kv(team, m_data.nets);
+    compute(kv);
+    stop_timer("euler step compute");
   }
 
+  KOKKOS_INLINE_FUNCTION
+  size_t shmem_size(const int team_size) const {
+    return KernelVariables::shmem_size(team_size);
+  }
 };
 
 } // namespace Homme
@@ -6,11 +6,27 @@
 namespace Homme {
 
 struct KernelVariables {
+  // The fields of the state at n0 the pipelined CaarFunctor stages in team
+  // scratch, each NP x NP x NUM_LEV packs, in this order
+  static constexpr int STAGED_U = 0;
+  static constexpr int STAGED_V = 1;
+  static constexpr int STAGED_T = 2;
+  static constexpr int STAGED_DP3D = 3;
+  static constexpr int NUM_STAGED_FIELDS = 4;
+  static constexpr int STAGED_SIZE = NUM_STAGED_FIELDS * NP * NP * NUM_LEV;
+
   KOKKOS_INLINE_FUNCTION
   KernelVariables(const TeamMember &team_in)
-      : team(team_in), ie(team.league_rank()), ilev(-1) {
+      : team(team_in), ie(team.league_rank()), ilev(-1), staged(nullptr),
+        next_ie(-1), next_staged(nullptr) {
   } //, igp(-1), jgp(-1) {}
 
+  // For a league over the elements [nets, nete)
+  KOKKOS_INLINE_FUNCTION
+  KernelVariables(const TeamMember &team_in, const int nets)
+      : team(team_in), ie(nets + team.league_rank()), ilev(-1),
+        staged(nullptr), next_ie(-1), next_staged(nullptr) {}
+
   template <typename Primitive, typename Data>
   KOKKOS_INLINE_FUNCTION Primitive *allocate_team() const {
     ScratchView<Data> view(team.team_scratch(0));
@@ -36,6 +52,13 @@ struct KernelVariables {
   }
 
   int ie, ilev;
+
+  // The state at n0 of ie in team scratch (STAGED_SIZE packs), or null if
+  // it is read from the elements
+  Scalar *staged;
+  // The element staged while ie is computed, in next_staged (-1 if none)
+  int next_ie;
+  Scalar *next_staged;
 }; // KernelVariables
 
 } // Homme
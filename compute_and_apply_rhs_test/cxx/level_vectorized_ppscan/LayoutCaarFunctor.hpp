@@ -0,0 +1,306 @@
+#ifndef HOMMEXX_LAYOUT_CAAR_FUNCTOR_HPP
+#define HOMMEXX_LAYOUT_CAAR_FUNCTOR_HPP
+
+#include "Types.hpp"
+#include "Control.hpp"
+#include "Elements.hpp"
+#include "Derivative.hpp"
+#include "KernelVariables.hpp"
+#include "PhysicalConstants.hpp"
+#include "StateLayout.hpp"
+
+#include "profiling.hpp"
+
+namespace Homme {
+
+// The fields CAAR reads and accumulates besides the state, and its
+// temporaries, all in the loop order of Layout
+template <typename Layout> struct LayoutCaarFields {
+  LayoutCaarFields() = default;
+  explicit LayoutCaarFields(const int num_elems)
+      : phi("phi", num_elems), pecnd("pecnd", num_elems),
+        omega_p("omega_p", num_elems), un0("un0", num_elems),
+        vn0("vn0", num_elems), pressure("pressure", num_elems),
+        div_vdp("div_vdp", num_elems), omega("omega", num_elems),
+        vgrad_t("vgrad_t", num_elems), ephi("ephi", num_elems),
+        vorticity("vorticity", num_elems), gv("gv", num_elems),
+        vcov("vcov", num_elems), energy_grad("energy_grad", num_elems) {}
+
+  PointField<Layout> phi;
+  PointField<Layout> pecnd;
+  PointField<Layout> omega_p;
+  PointField<Layout> un0;
+  PointField<Layout> vn0;
+
+  PointField<Layout> pressure;
+  PointField<Layout> div_vdp;
+  // v . grad(p), and then omega_p of this call
+  PointField<Layout> omega;
+  PointField<Layout> vgrad_t;
+  PointField<Layout> ephi;
+  PointField<Layout> vorticity;
+  // Contravariant vdp, for the divergence
+  PointField<Layout, 2> gv;
+  // Covariant v, for the vorticity
+  PointField<Layout, 2> vcov;
+  PointField<Layout, 2> energy_grad;
+};
+
+/* CAAR against a state array stored in any StateLayout, for comparing the
+ * layouts with the same arithmetic. It computes what CaarFunctor does for
+ * rsplit > 0 without tracers, level by level on Reals. Whether a team's
+ * threads split the levels or the points of a level only depends on which
+ * of them are contiguous in the layout; every value is computed by the same
+ * operations in the same order in all the layouts, so their results are
+ * bitwise identical as long as the compiler does not contract them into
+ * FMAs (which it does differently for each loop order). */
+template <typename Layout> struct LayoutCaarFunctor {
+  const Control m_data;
+  const Elements m_elements;
+  const Derivative m_deriv;
+  const State<Layout> m_state;
+  const LayoutCaarFields<Layout> m_fields;
+
+  LayoutCaarFunctor(const Control &data, const Elements &elements,
+                    const Derivative &deriv, const State<Layout> &state,
+                    const LayoutCaarFields<Layout> &fields)
+      : m_data(data), m_elements(elements), m_deriv(deriv), m_state(state),
+        m_fields(fields) {}
+
+  // f(ilev, igp, jgp) for all the points of all the levels of the element
+  template <typename Lambda>
+  KOKKOS_INLINE_FUNCTION void for_each_point(const KernelVariables &kv,
+                                             const Lambda &f) const {
+    if (Layout::levels_innermost) {
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP),
+                           [&](const int idx) {
+        const int igp = idx / NP;
+        const int jgp = idx % NP;
+        Kokkos::parallel_for(
+            Kokkos::ThreadVectorRange(kv.team, NUM_PHYSICAL_LEV),
+            [&](const int &ilev) { f(ilev, igp, jgp); });
+      });
+    } else {
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NUM_PHYSICAL_LEV),
+                           [&](const int ilev) {
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NP * NP),
+                             [&](const int &idx) {
+          f(ilev, idx / NP, idx % NP);
+        });
+      });
+    }
+    kv.team_barrier();
+  }
+
+  // f(igp, jgp) for all the columns of the element, for the vertical scans
+  template <typename Lambda>
+  KOKKOS_INLINE_FUNCTION void for_each_column(const KernelVariables &kv,
+                                              const Lambda &f) const {
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP),
+                         [&](const int idx) {
+      Kokkos::single(Kokkos::PerThread(kv.team),
+                     [&]() { f(idx / NP, idx % NP); });
+    });
+    kv.team_barrier();
+  }
+
+  // vdp, its mean flux and its contravariant components; the covariant v
+  KOKKOS_INLINE_FUNCTION void compute_vdp(const KernelVariables &kv) const {
+    const auto &dinv_metdet = m_elements.geometry.contravariant_metdet;
+    const auto &d = m_elements.geometry.covariant;
+    for_each_point(kv, [&](const int ilev, const int igp, const int jgp) {
+      const Real u = m_state(kv.ie, m_data.n0, U_FIELD, ilev, igp, jgp);
+      const Real v = m_state(kv.ie, m_data.n0, V_FIELD, ilev, igp, jgp);
+      const Real dp = m_state(kv.ie, m_data.n0, DP3D_FIELD, ilev, igp, jgp);
+      const Real vdp_0 = u * dp;
+      const Real vdp_1 = v * dp;
+      m_fields.un0(kv.ie, ilev, igp, jgp) += m_data.eta_ave_w * vdp_0;
+      m_fields.vn0(kv.ie, ilev, igp, jgp) += m_data.eta_ave_w * vdp_1;
+      m_fields.gv(kv.ie, ilev, igp, jgp, 0) =
+          dinv_metdet(kv.ie, 0, 0, igp, jgp) * vdp_0 +
+          dinv_metdet(kv.ie, 0, 1, igp, jgp) * vdp_1;
+      m_fields.gv(kv.ie, ilev, igp, jgp, 1) =
+          dinv_metdet(kv.ie, 1, 0, igp, jgp) * vdp_0 +
+          dinv_metdet(kv.ie, 1, 1, igp, jgp) * vdp_1;
+      m_fields.vcov(kv.ie, ilev, igp, jgp, 0) =
+          d(kv.ie, 0, 0, igp, jgp) * u + d(kv.ie, 0, 1, igp, jgp) * v;
+      m_fields.vcov(kv.ie, ilev, igp, jgp, 1) =
+          d(kv.ie, 1, 0, igp, jgp) * u + d(kv.ie, 1, 1, igp, jgp) * v;
+    });
+  }
+
+  // div_vdp and the vorticity
+  KOKKOS_INLINE_FUNCTION void
+  compute_div_vort(const KernelVariables &kv) const {
+    const auto dvv = m_deriv.get_dvv();
+    const auto &rmetdet = m_elements.geometry.rmetdet;
+    for_each_point(kv, [&](const int ilev, const int igp, const int jgp) {
+      Real dudx = 0, dvdy = 0, dvdx = 0, dudy = 0;
+      for (int kgp = 0; kgp < NP; ++kgp) {
+        dudx += dvv(jgp, kgp) * m_fields.gv(kv.ie, ilev, igp, kgp, 0);
+        dvdy += dvv(igp, kgp) * m_fields.gv(kv.ie, ilev, kgp, jgp, 1);
+        dvdx += dvv(jgp, kgp) * m_fields.vcov(kv.ie, ilev, igp, kgp, 1);
+        dudy += dvv(igp, kgp) * m_fields.vcov(kv.ie, ilev, kgp, jgp, 0);
+      }
+      m_fields.div_vdp(kv.ie, ilev, igp, jgp) =
+          (dudx + dvdy) * rmetdet(kv.ie, igp, jgp);
+      m_fields.vorticity(kv.ie, ilev, igp, jgp) =
+          (dvdx - dudy) * rmetdet(kv.ie, igp, jgp);
+    });
+  }
+
+  // The pressure and phi, from the top and from the bottom
+  KOKKOS_INLINE_FUNCTION void
+  compute_pressure_phi(const KernelVariables &kv) const {
+    for_each_column(kv, [&](const int igp, const int jgp) {
+      Real p_prev = m_data.hybrid_a(0) * m_data.ps0;
+      Real dp_prev = 0;
+      for (int ilev = 0; ilev < NUM_PHYSICAL_LEV; ++ilev) {
+        const Real dp = m_state(kv.ie, m_data.n0, DP3D_FIELD, ilev, igp, jgp);
+        p_prev = p_prev + 0.5 * dp_prev + 0.5 * dp;
+        dp_prev = dp;
+        m_fields.pressure(kv.ie, ilev, igp, jgp) = p_prev;
+      }
+
+      const Real phis = m_elements.m_phis(kv.ie, igp, jgp);
+      Real integration = 0;
+      for (int ilev = NUM_PHYSICAL_LEV - 1; ilev >= 0; --ilev) {
+        const Real rgas_tv_dp_over_p =
+            PhysicalConstants::Rgas *
+            m_state(kv.ie, m_data.n0, T_FIELD, ilev, igp, jgp) *
+            (m_state(kv.ie, m_data.n0, DP3D_FIELD, ilev, igp, jgp) * 0.5 /
+             m_fields.pressure(kv.ie, ilev, igp, jgp));
+        m_fields.phi(kv.ie, ilev, igp, jgp) =
+            2.0 * integration + (phis + rgas_tv_dp_over_p);
+        integration += rgas_tv_dp_over_p;
+      }
+    });
+  }
+
+  // The gradients of the pressure and the temperature, and what of the
+  // velocity update only depends on the pressure
+  KOKKOS_INLINE_FUNCTION void
+  compute_gradients(const KernelVariables &kv) const {
+    const auto dvv_rrearth = m_deriv.get_dvv_rrearth();
+    const auto &dinv = m_elements.geometry.contravariant;
+    for_each_point(kv, [&](const int ilev, const int igp, const int jgp) {
+      Real dpdx = 0, dpdy = 0, dtdx = 0, dtdy = 0;
+      for (int kgp = 0; kgp < NP; ++kgp) {
+        dpdx +=
+            dvv_rrearth(jgp, kgp) * m_fields.pressure(kv.ie, ilev, igp, kgp);
+        dpdy +=
+            dvv_rrearth(igp, kgp) * m_fields.pressure(kv.ie, ilev, kgp, jgp);
+        dtdx += dvv_rrearth(jgp, kgp) *
+                m_state(kv.ie, m_data.n0, T_FIELD, ilev, igp, kgp);
+        dtdy += dvv_rrearth(igp, kgp) *
+                m_state(kv.ie, m_data.n0, T_FIELD, ilev, kgp, jgp);
+      }
+      const Real dinv_00 = dinv(kv.ie, 0, 0, igp, jgp);
+      const Real dinv_01 = dinv(kv.ie, 0, 1, igp, jgp);
+      const Real dinv_10 = dinv(kv.ie, 1, 0, igp, jgp);
+      const Real dinv_11 = dinv(kv.ie, 1, 1, igp, jgp);
+      const Real grad_p_0 = dinv_00 * dpdx + dinv_01 * dpdy;
+      const Real grad_p_1 = dinv_10 * dpdx + dinv_11 * dpdy;
+      const Real grad_t_0 = dinv_00 * dtdx + dinv_01 * dtdy;
+      const Real grad_t_1 = dinv_10 * dtdx + dinv_11 * dtdy;
+
+      const Real u = m_state(kv.ie, m_data.n0, U_FIELD, ilev, igp, jgp);
+      const Real v = m_state(kv.ie, m_data.n0, V_FIELD, ilev, igp, jgp);
+      const Real t = m_state(kv.ie, m_data.n0, T_FIELD, ilev, igp, jgp);
+      m_fields.omega(kv.ie, ilev, igp, jgp) = u * grad_p_0 + v * grad_p_1;
+      m_fields.vgrad_t(kv.ie, ilev, igp, jgp) = u * grad_t_0 + v * grad_t_1;
+
+      const Real rgas_tv_over_p = PhysicalConstants::Rgas * t /
+                                  m_fields.pressure(kv.ie, ilev, igp, jgp);
+      m_fields.energy_grad(kv.ie, ilev, igp, jgp, 0) =
+          rgas_tv_over_p * grad_p_0;
+      m_fields.energy_grad(kv.ie, ilev, igp, jgp, 1) =
+          rgas_tv_over_p * grad_p_1;
+      m_fields.ephi(kv.ie, ilev, igp, jgp) =
+          0.5 * (u * u + v * v) + (m_fields.phi(kv.ie, ilev, igp, jgp) +
+                                   m_fields.pecnd(kv.ie, ilev, igp, jgp));
+    });
+  }
+
+  // omega_p, from the top
+  KOKKOS_INLINE_FUNCTION void compute_omega_p(const KernelVariables &kv) const {
+    for_each_column(kv, [&](const int igp, const int jgp) {
+      Real integration = 0;
+      for (int ilev = 0; ilev < NUM_PHYSICAL_LEV; ++ilev) {
+        const Real div_vdp = m_fields.div_vdp(kv.ie, ilev, igp, jgp);
+        Real &omega = m_fields.omega(kv.ie, ilev, igp, jgp);
+        omega = (omega - (0.5 * div_vdp + integration)) /
+                m_fields.pressure(kv.ie, ilev, igp, jgp);
+        integration += div_vdp;
+        m_fields.omega_p(kv.ie, ilev, igp, jgp) += m_data.eta_ave_w * omega;
+      }
+    });
+  }
+
+  // T, v and dp3d at np1
+  KOKKOS_INLINE_FUNCTION void compute_np1(const KernelVariables &kv) const {
+    const auto dvv_rrearth = m_deriv.get_dvv_rrearth();
+    const auto &dinv = m_elements.geometry.contravariant;
+    for_each_point(kv, [&](const int ilev, const int igp, const int jgp) {
+      const Real spheremp = m_elements.m_spheremp(kv.ie, igp, jgp);
+
+      const Real ttens =
+          PhysicalConstants::kappa *
+              m_state(kv.ie, m_data.n0, T_FIELD, ilev, igp, jgp) *
+              m_fields.omega(kv.ie, ilev, igp, jgp) -
+          m_fields.vgrad_t(kv.ie, ilev, igp, jgp);
+      m_state(kv.ie, m_data.np1, T_FIELD, ilev, igp, jgp) =
+          spheremp *
+          (ttens * m_data.dt +
+           m_state(kv.ie, m_data.nm1, T_FIELD, ilev, igp, jgp));
+
+      m_state(kv.ie, m_data.np1, DP3D_FIELD, ilev, igp, jgp) =
+          spheremp * (m_state(kv.ie, m_data.nm1, DP3D_FIELD, ilev, igp, jgp) -
+                      m_fields.div_vdp(kv.ie, ilev, igp, jgp) * m_data.dt);
+
+      Real dedx = 0, dedy = 0;
+      for (int kgp = 0; kgp < NP; ++kgp) {
+        dedx += dvv_rrearth(jgp, kgp) * m_fields.ephi(kv.ie, ilev, igp, kgp);
+        dedy += dvv_rrearth(igp, kgp) * m_fields.ephi(kv.ie, ilev, kgp, jgp);
+      }
+      const Real grad_0 = dinv(kv.ie, 0, 0, igp, jgp) * dedx +
+                          dinv(kv.ie, 0, 1, igp, jgp) * dedy +
+                          m_fields.energy_grad(kv.ie, ilev, igp, jgp, 0);
+      const Real grad_1 = dinv(kv.ie, 1, 0, igp, jgp) * dedx +
+                          dinv(kv.ie, 1, 1, igp, jgp) * dedy +
+                          m_fields.energy_grad(kv.ie, ilev, igp, jgp, 1);
+      const Real vort = m_fields.vorticity(kv.ie, ilev, igp, jgp) +
+                        m_elements.m_fcor(kv.ie, igp, jgp);
+      const Real u = m_state(kv.ie, m_data.n0, U_FIELD, ilev, igp, jgp);
+      const Real v = m_state(kv.ie, m_data.n0, V_FIELD, ilev, igp, jgp);
+      m_state(kv.ie, m_data.np1, U_FIELD, ilev, igp, jgp) =
+          spheremp * ((v * vort - grad_0) * m_data.dt +
+                      m_state(kv.ie, m_data.nm1, U_FIELD, ilev, igp, jgp));
+      m_state(kv.ie, m_data.np1, V_FIELD, ilev, igp, jgp) =
+          spheremp * ((-u * vort - grad_1) * m_data.dt +
+                      m_state(kv.ie, m_data.nm1, V_FIELD, ilev, igp, jgp));
+    });
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const TeamMember &team) const {
+    start_timer("layout caar compute");
+    KernelVariables kv(team, m_data.nets);
+    compute_vdp(kv);
+    compute_div_vort(kv);
+    compute_pressure_phi(kv);
+    compute_gradients(kv);
+    compute_omega_p(kv);
+    compute_np1(kv);
+    stop_timer("layout caar compute");
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  size_t shmem_size(const int team_size) const {
+    return KernelVariables::shmem_size(team_size);
+  }
+};
+
+} // namespace Homme
+
+#endif // HOMMEXX_LAYOUT_CAAR_FUNCTOR_HPP
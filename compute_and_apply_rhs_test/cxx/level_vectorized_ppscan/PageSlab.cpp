@@ -0,0 +1,154 @@
+#include "PageSlab.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#if defined(__linux__) && !defined(HOMMEXX_CUDA_SPACE) &&                     \
+    !(defined(HOMMEXX_DEFAULT_SPACE) && defined(KOKKOS_ENABLE_CUDA))
+#define HOMMEXX_HOST_SLAB
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <string>
+#endif
+
+namespace Homme {
+
+namespace {
+
+constexpr size_t cache_line = 64;
+
+size_t round_up(const size_t bytes, const size_t alignment) {
+  return (bytes + alignment - 1) / alignment * alignment;
+}
+
+#ifdef HOMMEXX_HOST_SLAB
+
+// The default huge page size, from /proc/meminfo (2 MB if it is not there)
+size_t huge_page_size() {
+  std::ifstream meminfo("/proc/meminfo");
+  std::string key;
+  size_t kb = 0;
+  while (meminfo >> key) {
+    if (key == "Hugepagesize:" && meminfo >> kb) {
+      return kb * 1024;
+    }
+  }
+  return 2 * 1024 * 1024;
+}
+
+void *map_anonymous(const size_t bytes, const int flags) {
+  void *p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+  return p == MAP_FAILED ? nullptr : p;
+}
+
+#endif // HOMMEXX_HOST_SLAB
+
+} // namespace
+
+const char *page_policy_name(const PagePolicy policy) {
+  switch (policy) {
+  case PagePolicy::TRANSPARENT_HUGE:
+    return "transparent huge pages";
+  case PagePolicy::HUGETLB:
+    return "hugetlbfs pages";
+  default:
+    return "base pages";
+  }
+}
+
+bool parse_page_policy(const char *name, PagePolicy &policy) {
+  if (std::strcmp(name, "none") == 0) {
+    policy = PagePolicy::DEFAULT;
+  } else if (std::strcmp(name, "thp") == 0) {
+    policy = PagePolicy::TRANSPARENT_HUGE;
+  } else if (std::strcmp(name, "hugetlb") == 0) {
+    policy = PagePolicy::HUGETLB;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+PageSlab::PageSlab()
+    : m_mapping(nullptr), m_mapping_size(0), m_data(nullptr), m_size(0),
+      m_page_size(0), m_offset(0), m_policy(PagePolicy::DEFAULT) {}
+
+PageSlab::PageSlab(const size_t bytes, const PagePolicy policy)
+    : PageSlab() {
+#ifdef HOMMEXX_HOST_SLAB
+  if (policy == PagePolicy::DEFAULT || bytes == 0) {
+    return;
+  }
+  const size_t huge_page = huge_page_size();
+  m_size = round_up(bytes, huge_page);
+
+  if (policy == PagePolicy::HUGETLB) {
+    m_mapping = map_anonymous(m_size, MAP_HUGETLB);
+    if (m_mapping != nullptr) {
+      m_mapping_size = m_size;
+      m_data = static_cast<char *>(m_mapping);
+      m_page_size = huge_page;
+      m_policy = PagePolicy::HUGETLB;
+    }
+  }
+
+  if (m_mapping == nullptr) {
+    // One more huge page to align the slab to one
+    m_mapping_size = m_size + huge_page;
+    m_mapping = map_anonymous(m_mapping_size, 0);
+    if (m_mapping == nullptr) {
+      std::cerr << "Error! Could not map a slab of " << m_size
+                << " bytes for the elements\n";
+      std::abort();
+    }
+    m_data = reinterpret_cast<char *>(
+        round_up(reinterpret_cast<size_t>(m_mapping), huge_page));
+#ifdef MADV_HUGEPAGE
+    if (madvise(m_data, m_size, MADV_HUGEPAGE) == 0) {
+      m_page_size = huge_page;
+      m_policy = PagePolicy::TRANSPARENT_HUGE;
+    }
+#endif
+    if (m_policy == PagePolicy::DEFAULT) {
+      m_page_size = sysconf(_SC_PAGESIZE);
+    }
+  }
+
+  // Fault the pages in from all the threads, as Kokkos initializes the
+  // views it allocates, so that they are spread over the NUMA nodes
+  char *const data = m_data;
+  const size_t page_size = m_page_size;
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecSpace>(0, m_size / m_page_size),
+      KOKKOS_LAMBDA(const int page) { data[page * page_size] = 0; });
+  ExecSpace::fence();
+#else
+  (void)bytes;
+  (void)policy;
+#endif // HOMMEXX_HOST_SLAB
+}
+
+PageSlab::~PageSlab() {
+#ifdef HOMMEXX_HOST_SLAB
+  if (m_mapping != nullptr) {
+    munmap(m_mapping, m_mapping_size);
+  }
+#endif
+}
+
+void *PageSlab::carve(const size_t bytes) {
+  char *p = m_data == nullptr ? nullptr : m_data + m_offset;
+  m_offset += round_up(bytes, cache_line);
+  if (m_data != nullptr && m_offset > m_size) {
+    std::cerr << "Error! The views need more than the " << m_size
+              << " bytes of the slab\n";
+    std::abort();
+  }
+  return p;
+}
+
+} // namespace Homme
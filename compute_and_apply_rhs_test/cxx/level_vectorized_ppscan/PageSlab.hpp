@@ -0,0 +1,86 @@
+#ifndef HOMMEXX_PAGE_SLAB_HPP
+#define HOMMEXX_PAGE_SLAB_HPP
+
+#include "Types.hpp"
+
+#include <cstddef>
+
+namespace Homme {
+
+// How the memory of the views of Elements is paged
+enum class PagePolicy {
+  // A Kokkos allocation per view, with the base pages of the system
+  DEFAULT,
+  // One slab for all the views, aligned to a huge page and advised with
+  // madvise(MADV_HUGEPAGE), so that the kernel backs it with transparent
+  // huge pages
+  TRANSPARENT_HUGE,
+  // One slab for all the views, mapped from the hugetlbfs pool
+  // (MAP_HUGETLB; the pool is reserved with vm.nr_hugepages)
+  HUGETLB
+};
+
+const char *page_policy_name(const PagePolicy policy);
+
+// "none", "thp" or "hugetlb"; false if name is none of them
+bool parse_page_policy(const char *name, PagePolicy &policy);
+
+/* One contiguous mapping of host memory, carved into views so that a few
+ * huge pages cover all of them, instead of a TLB entry per 4 KB page of
+ * each view.
+ *
+ * A policy that cannot be honored falls back to the next one (HUGETLB to
+ * TRANSPARENT_HUGE when the pool is empty, TRANSPARENT_HUGE to base pages
+ * when madvise fails), and policy() is the one obtained. There is no slab
+ * (mapped() is false, policy() is DEFAULT) when the execution space is not
+ * the host or the platform is not Linux.
+ *
+ * A default constructed slab maps nothing: carve only adds up the bytes,
+ * to size the slab of a set of views. */
+class PageSlab {
+public:
+  PageSlab();
+  PageSlab(const size_t bytes, const PagePolicy policy);
+  ~PageSlab();
+
+  PageSlab(const PageSlab &) = delete;
+  PageSlab &operator=(const PageSlab &) = delete;
+
+  bool mapped() const { return m_data != nullptr; }
+  PagePolicy policy() const { return m_policy; }
+  size_t size() const { return m_size; }
+  size_t page_size() const { return m_page_size; }
+
+  // The next bytes of the slab, aligned to a cache line (nullptr for a slab
+  // that maps nothing)
+  void *carve(const size_t bytes);
+  // Bytes carved so far, alignment included
+  size_t carved() const { return m_offset; }
+
+private:
+  void *m_mapping;
+  size_t m_mapping_size;
+  char *m_data;
+  size_t m_size;
+  size_t m_page_size;
+  size_t m_offset;
+  PagePolicy m_policy;
+};
+
+// A view of the shape given by dims, carved from slab, or in its own Kokkos
+// allocation labeled label if slab is null
+template <typename ViewType, typename... Dims>
+ViewType allocate_view(PageSlab *slab, const char *label, const Dims... dims) {
+  if (slab == nullptr) {
+    return ViewType(label, dims...);
+  }
+  using pointer_type = typename ViewType::pointer_type;
+  const ViewType shape(static_cast<pointer_type>(nullptr), dims...);
+  const size_t bytes =
+      shape.span() * sizeof(typename ViewType::non_const_value_type);
+  return ViewType(static_cast<pointer_type>(slab->carve(bytes)), dims...);
+}
+
+} // namespace Homme
+
+#endif // HOMMEXX_PAGE_SLAB_HPP
@@ -0,0 +1,61 @@
+#include "SharedMemoryComm.hpp"
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <iostream>
+
+namespace Homme {
+
+SharedMemoryComm::SharedMemoryComm(const int num_ranks,
+                                   const size_t buffer_size)
+    : m_rank(0), m_size(num_ranks) {
+  // The barrier lives in the first page of the mapping, before the buffer
+  const size_t page_size = sysconf(_SC_PAGESIZE);
+  m_mapping_size = page_size + buffer_size;
+  m_mapping = mmap(nullptr, m_mapping_size, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (m_mapping == MAP_FAILED) {
+    std::cerr << "Error! Cannot map " << m_mapping_size
+              << " bytes of shared memory.\n";
+    std::abort();
+  }
+  m_barrier = static_cast<pthread_barrier_t *>(m_mapping);
+  m_buffer = static_cast<char *>(m_mapping) + page_size;
+
+  pthread_barrierattr_t attr;
+  pthread_barrierattr_init(&attr);
+  pthread_barrierattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+  pthread_barrier_init(m_barrier, &attr, num_ranks);
+  pthread_barrierattr_destroy(&attr);
+
+  for (int rank = 1; rank < num_ranks; ++rank) {
+    const pid_t pid = fork();
+    if (pid < 0) {
+      std::cerr << "Error! Cannot fork rank " << rank << ".\n";
+      std::abort();
+    }
+    if (pid == 0) {
+      m_rank = rank;
+      m_children.clear();
+      break;
+    }
+    m_children.push_back(pid);
+  }
+}
+
+SharedMemoryComm::~SharedMemoryComm() {
+  for (pid_t pid : m_children) {
+    waitpid(pid, nullptr, 0);
+  }
+  if (m_rank == 0) {
+    pthread_barrier_destroy(m_barrier);
+  }
+  munmap(m_mapping, m_mapping_size);
+}
+
+void SharedMemoryComm::barrier() const { pthread_barrier_wait(m_barrier); }
+
+} // namespace Homme
@@ -0,0 +1,49 @@
+#ifndef HOMMEXX_SHARED_MEMORY_COMM_HPP
+#define HOMMEXX_SHARED_MEMORY_COMM_HPP
+
+#include <pthread.h>
+#include <sys/types.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace Homme {
+
+/* A stand-in for MPI on a single node: the benchmark forks into num_ranks
+ * processes, which exchange data through an anonymous shared mapping and
+ * synchronize with a process-shared barrier.
+ *
+ * It has to be created before Kokkos::initialize, since the threads of the
+ * parent (e.g. the OpenMP ones) are not duplicated by fork. */
+class SharedMemoryComm {
+public:
+  // Forks, and maps buffer_size bytes shared by all the ranks
+  SharedMemoryComm(const int num_ranks, const size_t buffer_size);
+  // Rank 0 waits for the other ranks to exit
+  ~SharedMemoryComm();
+
+  SharedMemoryComm(const SharedMemoryComm &) = delete;
+  SharedMemoryComm &operator=(const SharedMemoryComm &) = delete;
+
+  int rank() const { return m_rank; }
+  int size() const { return m_size; }
+
+  // Aligned to a page
+  void *buffer() const { return m_buffer; }
+
+  // Returns once all the ranks called it
+  void barrier() const;
+
+private:
+  int m_rank;
+  int m_size;
+  size_t m_mapping_size;
+  void *m_mapping;
+  pthread_barrier_t *m_barrier;
+  void *m_buffer;
+  std::vector<pid_t> m_children;
+};
+
+} // namespace Homme
+
+#endif // HOMMEXX_SHARED_MEMORY_COMM_HPP
@@ -6,6 +6,7 @@
 #include "Dimensions.hpp"
 #include "KernelVariables.hpp"
 #include "PhysicalConstants.hpp"
+#include "SphereOperatorsGemm.hpp"
 
 #include <Kokkos_Core.hpp>
 
@@ -241,8 +242,8 @@ gradient_sphere(const KernelVariables &kv,
     Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
       Scalar dsdx, dsdy;
       for (int kgp = 0; kgp < NP; ++kgp) {
-        dsdx += dvv(jgp, kgp) * scalar(igp, kgp, ilev);
-        dsdy += dvv(jgp, kgp) * scalar(kgp, igp, ilev);
+        dsdx = fma(dvv(jgp, kgp), scalar(igp, kgp, ilev), dsdx);
+        dsdy = fma(dvv(jgp, kgp), scalar(kgp, igp, ilev), dsdy);
       }
       v_buf(kv.ie, 0, igp, jgp, ilev) = dsdx * PhysicalConstants::rrearth;
       v_buf(kv.ie, 1, jgp, igp, ilev) = dsdy * PhysicalConstants::rrearth;
@@ -258,11 +259,11 @@ gradient_sphere(const KernelVariables &kv,
     const int jgp = loop_idx % NP;
     Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
       grad_s(0, igp, jgp, ilev) =
-          dinv(kv.ie, 0, 0, igp, jgp) * v_buf(kv.ie, 0, igp, jgp, ilev) +
-          dinv(kv.ie, 0, 1, igp, jgp) * v_buf(kv.ie, 1, igp, jgp, ilev);
+          fma(dinv(kv.ie, 0, 0, igp, jgp), v_buf(kv.ie, 0, igp, jgp, ilev),
+              dinv(kv.ie, 0, 1, igp, jgp) * v_buf(kv.ie, 1, igp, jgp, ilev));
       grad_s(1, igp, jgp, ilev) =
-          dinv(kv.ie, 1, 0, igp, jgp) * v_buf(kv.ie, 0, igp, jgp, ilev) +
-          dinv(kv.ie, 1, 1, igp, jgp) * v_buf(kv.ie, 1, igp, jgp, ilev);
+          fma(dinv(kv.ie, 1, 0, igp, jgp), v_buf(kv.ie, 0, igp, jgp, ilev),
+              dinv(kv.ie, 1, 1, igp, jgp) * v_buf(kv.ie, 1, igp, jgp, ilev));
     });
   });
   kv.team_barrier();
@@ -284,8 +285,8 @@ KOKKOS_INLINE_FUNCTION void gradient_sphere_update(
     Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
       Scalar dsdx, dsdy;
       for (int kgp = 0; kgp < NP; ++kgp) {
-        dsdx += dvv(jgp, kgp) * scalar(igp, kgp, ilev);
-        dsdy += dvv(jgp, kgp) * scalar(kgp, igp, ilev);
+        dsdx = fma(dvv(jgp, kgp), scalar(igp, kgp, ilev), dsdx);
+        dsdy = fma(dvv(jgp, kgp), scalar(kgp, igp, ilev), dsdy);
       }
       v_buf(kv.ie, 0, igp, jgp, ilev) = dsdx * PhysicalConstants::rrearth;
       v_buf(kv.ie, 1, jgp, igp, ilev) = dsdy * PhysicalConstants::rrearth;
@@ -300,12 +301,14 @@ KOKKOS_INLINE_FUNCTION void gradient_sphere_update(
     const int igp = loop_idx / NP;
     const int jgp = loop_idx % NP;
     Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
-      grad_s(0, igp, jgp, ilev) +=
-          dinv(kv.ie, 0, 0, igp, jgp) * v_buf(kv.ie, 0, igp, jgp, ilev) +
-          dinv(kv.ie, 0, 1, igp, jgp) * v_buf(kv.ie, 1, igp, jgp, ilev);
-      grad_s(1, igp, jgp, ilev) +=
-          dinv(kv.ie, 1, 0, igp, jgp) * v_buf(kv.ie, 0, igp, jgp, ilev) +
-          dinv(kv.ie, 1, 1, igp, jgp) * v_buf(kv.ie, 1, igp, jgp, ilev);
+      grad_s(0, igp, jgp, ilev) =
+          fma(dinv(kv.ie, 0, 0, igp, jgp), v_buf(kv.ie, 0, igp, jgp, ilev),
+              fma(dinv(kv.ie, 0, 1, igp, jgp), v_buf(kv.ie, 1, igp, jgp, ilev),
+                  grad_s(0, igp, jgp, ilev)));
+      grad_s(1, igp, jgp, ilev) =
+          fma(dinv(kv.ie, 1, 0, igp, jgp), v_buf(kv.ie, 0, igp, jgp, ilev),
+              fma(dinv(kv.ie, 1, 1, igp, jgp), v_buf(kv.ie, 1, igp, jgp, ilev),
+                  grad_s(1, igp, jgp, ilev)));
     });
   });
   kv.team_barrier();
@@ -327,12 +330,12 @@ divergence_sphere(const KernelVariables &kv,
     const int jgp = loop_idx % NP;
     Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
       gv_buf(kv.ie, 0, igp, jgp, ilev) =
-          (dinv(kv.ie, 0, 0, igp, jgp) * v(0, igp, jgp, ilev) +
-           dinv(kv.ie, 1, 0, igp, jgp) * v(1, igp, jgp, ilev)) *
+          fma(dinv(kv.ie, 0, 0, igp, jgp), v(0, igp, jgp, ilev),
+              dinv(kv.ie, 1, 0, igp, jgp) * v(1, igp, jgp, ilev)) *
           metdet(kv.ie, igp, jgp);
       gv_buf(kv.ie, 1, igp, jgp, ilev) =
-          (dinv(kv.ie, 0, 1, igp, jgp) * v(0, igp, jgp, ilev) +
-           dinv(kv.ie, 1, 1, igp, jgp) * v(1, igp, jgp, ilev)) *
+          fma(dinv(kv.ie, 0, 1, igp, jgp), v(0, igp, jgp, ilev),
+              dinv(kv.ie, 1, 1, igp, jgp) * v(1, igp, jgp, ilev)) *
           metdet(kv.ie, igp, jgp);
     });
   });
@@ -344,14 +347,16 @@ divergence_sphere(const KernelVariables &kv,
                        [&](const int loop_idx) {
     const int igp = loop_idx / NP;
     const int jgp = loop_idx % NP;
+    // One scalar division per point rather than one per level pack
+    const Real rmetdet =
+        1.0 / metdet(kv.ie, igp, jgp) * PhysicalConstants::rrearth;
     Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
       Scalar dudx, dvdy;
       for (int kgp = 0; kgp < NP; ++kgp) {
-        dudx += dvv(jgp, kgp) * gv_buf(kv.ie, 0, igp, kgp, ilev);
-        dvdy += dvv(igp, kgp) * gv_buf(kv.ie, 1, kgp, jgp, ilev);
+        dudx = fma(dvv(jgp, kgp), gv_buf(kv.ie, 0, igp, kgp, ilev), dudx);
+        dvdy = fma(dvv(igp, kgp), gv_buf(kv.ie, 1, kgp, jgp, ilev), dvdy);
       }
-      div_v(igp, jgp, ilev) =
-          (dudx + dvdy) * (1.0 / metdet(kv.ie, igp, jgp) * PhysicalConstants::rrearth);
+      div_v(igp, jgp, ilev) = (dudx + dvdy) * rmetdet;
     });
   });
   kv.team_barrier();
@@ -375,10 +380,10 @@ divergence_sphere_update(const KernelVariables &kv,
     const int igp = loop_idx / NP;
     const int jgp = loop_idx % NP;
     Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
-      gv(kv.ie, 0, igp, jgp, ilev) = (dinv(0,0,igp,jgp)*v(0, igp, jgp, ilev) +
-                                      dinv(1,0,igp,jgp)*v(1,igp,jgp,ilev)) * metdet(igp,jgp);
-      gv(kv.ie, 1, igp, jgp, ilev) = (dinv(0,1,igp,jgp)*v(0, igp, jgp, ilev) +
-                                      dinv(1,1,igp,jgp)*v(1,igp,jgp,ilev)) * metdet(igp,jgp);
+      gv(kv.ie, 0, igp, jgp, ilev) = fma(dinv(0,0,igp,jgp), v(0, igp, jgp, ilev),
+                                         dinv(1,0,igp,jgp)*v(1,igp,jgp,ilev)) * metdet(igp,jgp);
+      gv(kv.ie, 1, igp, jgp, ilev) = fma(dinv(0,1,igp,jgp), v(0, igp, jgp, ilev),
+                                         dinv(1,1,igp,jgp)*v(1,igp,jgp,ilev)) * metdet(igp,jgp);
     });
   });
   kv.team_barrier();
@@ -388,15 +393,16 @@ divergence_sphere_update(const KernelVariables &kv,
                        [&](const int loop_idx) {
     const int igp = loop_idx / NP;
     const int jgp = loop_idx % NP;
+    const Real alpha_rmetdet =
+        alpha * (1.0 / metdet(igp,jgp) * PhysicalConstants::rrearth);
     Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
       Scalar dudx, dvdy;
       for (int kgp = 0; kgp < NP; ++kgp) {
-        dudx += dvv(jgp, kgp) * gv(kv.ie, 0, igp, kgp, ilev);
-        dvdy += dvv(igp, kgp) * gv(kv.ie, 1, kgp, jgp, ilev);
+        dudx = fma(dvv(jgp, kgp), gv(kv.ie, 0, igp, kgp, ilev), dudx);
+        dvdy = fma(dvv(igp, kgp), gv(kv.ie, 1, kgp, jgp, ilev), dvdy);
       }
 
-      div_v(igp,jgp,ilev) *= beta;
-      div_v(igp,jgp,ilev) += alpha*((dudx + dvdy) * (1.0 / metdet(igp,jgp) * PhysicalConstants::rrearth));
+      div_v(igp,jgp,ilev) = fma(beta, div_v(igp,jgp,ilev), (dudx + dvdy) * alpha_rmetdet);
     });
   });
   kv.team_barrier();
@@ -419,11 +425,11 @@ vorticity_sphere(const KernelVariables &kv,
     const int jgp = loop_idx % NP;
     Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
       vcov_buf(kv.ie, 0, jgp, igp, ilev) =
-          d(kv.ie, 0, 0, jgp, igp) * u(jgp, igp, ilev) +
-          d(kv.ie, 0, 1, jgp, igp) * v(jgp, igp, ilev);
+          fma(d(kv.ie, 0, 0, jgp, igp), u(jgp, igp, ilev),
+              d(kv.ie, 0, 1, jgp, igp) * v(jgp, igp, ilev));
       vcov_buf(kv.ie, 1, jgp, igp, ilev) =
-          d(kv.ie, 1, 0, jgp, igp) * u(jgp, igp, ilev) +
-          d(kv.ie, 1, 1, jgp, igp) * v(jgp, igp, ilev);
+          fma(d(kv.ie, 1, 0, jgp, igp), u(jgp, igp, ilev),
+              d(kv.ie, 1, 1, jgp, igp) * v(jgp, igp, ilev));
     });
   });
   kv.team_barrier();
@@ -433,14 +439,15 @@ vorticity_sphere(const KernelVariables &kv,
                        [&](const int loop_idx) {
     const int igp = loop_idx / NP;
     const int jgp = loop_idx % NP;
+    const Real rmetdet =
+        1.0 / metdet(kv.ie, igp, jgp) * PhysicalConstants::rrearth;
     Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
       Scalar dudy, dvdx;
       for (int kgp = 0; kgp < NP; ++kgp) {
-        dvdx += dvv(jgp, kgp) * vcov_buf(kv.ie, 1, igp, kgp, ilev);
-        dudy += dvv(igp, kgp) * vcov_buf(kv.ie, 0, kgp, jgp, ilev);
+        dvdx = fma(dvv(jgp, kgp), vcov_buf(kv.ie, 1, igp, kgp, ilev), dvdx);
+        dudy = fma(dvv(igp, kgp), vcov_buf(kv.ie, 0, kgp, jgp, ilev), dudy);
       }
-      vort(igp, jgp, ilev) = (dvdx - dudy) * (1.0 / metdet(kv.ie, igp, jgp) *
-                                              PhysicalConstants::rrearth);
+      vort(igp, jgp, ilev) = (dvdx - dudy) * rmetdet;
     });
   });
   kv.team_barrier();
@@ -463,10 +470,10 @@ vorticity_sphere_vector(const KernelVariables &kv,
     const int igp = loop_idx / NP;
     const int jgp = loop_idx % NP;
     Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
-      sphere_buf(kv.ie,0,igp,jgp,ilev) = d(kv.ie,0,0,igp,jgp) * v(0,igp,jgp,ilev)
-                                       + d(kv.ie,0,1,igp,jgp) * v(1,igp,jgp,ilev);
-      sphere_buf(kv.ie,1,igp,jgp,ilev) = d(kv.ie,1,0,igp,jgp) * v(0,igp,jgp,ilev)
-                                       + d(kv.ie,1,1,igp,jgp) * v(1,igp,jgp,ilev);
+      sphere_buf(kv.ie,0,igp,jgp,ilev) = fma(d(kv.ie,0,0,igp,jgp), v(0,igp,jgp,ilev),
+                                             d(kv.ie,0,1,igp,jgp) * v(1,igp,jgp,ilev));
+      sphere_buf(kv.ie,1,igp,jgp,ilev) = fma(d(kv.ie,1,0,igp,jgp), v(0,igp,jgp,ilev),
+                                             d(kv.ie,1,1,igp,jgp) * v(1,igp,jgp,ilev));
     });
   });
   kv.team_barrier();
@@ -476,14 +483,15 @@ vorticity_sphere_vector(const KernelVariables &kv,
                        [&](const int loop_idx) {
     const int igp = loop_idx / NP;
     const int jgp = loop_idx % NP;
+    const Real rmetdet =
+        1.0 / metdet(kv.ie, igp, jgp) * PhysicalConstants::rrearth;
     Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
       Scalar dudy, dvdx;
       for (int kgp = 0; kgp < NP; ++kgp) {
-        dvdx += dvv(jgp, kgp) * sphere_buf(kv.ie, 1, igp, kgp, ilev);
-        dudy += dvv(igp, kgp) * sphere_buf(kv.ie, 0, kgp, jgp, ilev);
+        dvdx = fma(dvv(jgp, kgp), sphere_buf(kv.ie, 1, igp, kgp, ilev), dvdx);
+        dudy = fma(dvv(igp, kgp), sphere_buf(kv.ie, 0, kgp, jgp, ilev), dudy);
       }
-      vort(igp, jgp, ilev) = (dvdx - dudy) * (1.0 / metdet(kv.ie, igp, jgp) *
-                                              PhysicalConstants::rrearth);
+      vort(igp, jgp, ilev) = (dvdx - dudy) * rmetdet;
     });
   });
   kv.team_barrier();
@@ -505,10 +513,10 @@ divergence_sphere_wk(const KernelVariables &kv,
     const int igp = loop_idx / NP;
     const int jgp = loop_idx % NP;
     Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
-      sphere_buf(kv.ie,0,igp,jgp,ilev) = dinv(kv.ie, 0, 0, igp, jgp) * v(0, igp, jgp, ilev)
-                                       + dinv(kv.ie, 1, 0, igp, jgp) * v(1, igp, jgp, ilev);
-      sphere_buf(kv.ie,1,igp,jgp,ilev) = dinv(kv.ie, 0, 1, igp, jgp) * v(0, igp, jgp, ilev)
-                                       + dinv(kv.ie, 1, 1, igp, jgp) * v(1, igp, jgp, ilev);
+      sphere_buf(kv.ie,0,igp,jgp,ilev) = fma(dinv(kv.ie, 0, 0, igp, jgp), v(0, igp, jgp, ilev),
+                                             dinv(kv.ie, 1, 0, igp, jgp) * v(1, igp, jgp, ilev));
+      sphere_buf(kv.ie,1,igp,jgp,ilev) = fma(dinv(kv.ie, 0, 1, igp, jgp), v(0, igp, jgp, ilev),
+                                             dinv(kv.ie, 1, 1, igp, jgp) * v(1, igp, jgp, ilev));
     });
   });
   kv.team_barrier();
@@ -520,13 +528,11 @@ divergence_sphere_wk(const KernelVariables &kv,
     const int ngp = loop_idx % NP;
     Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
       Scalar dd;
-      // TODO: move multiplication by rrearth outside the loop
       for (int jgp = 0; jgp < NP; ++jgp) {
-        dd -= (spheremp(kv.ie, ngp, jgp) * sphere_buf(kv.ie, 0, ngp, jgp, ilev) * dvv(jgp, mgp) +
-               spheremp(kv.ie, jgp, mgp) * sphere_buf(kv.ie, 1, jgp, mgp, ilev) * dvv(jgp, ngp)) *
-              PhysicalConstants::rrearth;
+        dd = fma(spheremp(kv.ie, ngp, jgp) * dvv(jgp, mgp), sphere_buf(kv.ie, 0, ngp, jgp, ilev), dd);
+        dd = fma(spheremp(kv.ie, jgp, mgp) * dvv(jgp, ngp), sphere_buf(kv.ie, 1, jgp, mgp, ilev), dd);
       }
-      div_v(ngp, mgp, ilev) = dd;
+      div_v(ngp, mgp, ilev) = -PhysicalConstants::rrearth * dd;
     });
   });
   kv.team_barrier();
@@ -992,6 +998,205 @@ vlaplace_sphere_wk_contra(const KernelVariables &kv,
    kv.team_barrier();
 }//end of vlaplace_sphere_wk_contra
 
+// ============== PRECOMPUTED-GEOMETRY IMPLEMENTATION ===================== //
+// These take the metric terms Elements::GeometryFactors builds at init, so
+// the per-call metdet multiplies and reciprocals drop out of the kernels.
+// The gradients expect Derivative::get_dvv_rrearth() in place of dvv.
+// Configuring with HOMMEXX_GEMM_OPERATORS makes them forward to the batched
+// small-GEMM versions of SphereOperatorsGemm.hpp.
+
+KOKKOS_INLINE_FUNCTION void
+gradient_sphere(const KernelVariables &kv,
+                const Elements::GeometryFactors &geometry,
+                const ExecViewUnmanaged<const Real         [NP][NP]>          dvv_rrearth,
+                const ExecViewUnmanaged<const Scalar       [NP][NP][NUM_LEV]> scalar,
+                      ExecViewUnmanaged<      Scalar*   [2][NP][NP][NUM_LEV]> v_buf,
+                      ExecViewUnmanaged<      Scalar    [2][NP][NP][NUM_LEV]> grad_s)
+{
+#ifdef HOMMEXX_GEMM_OPERATORS
+  gradient_sphere_gemm(kv, geometry, dvv_rrearth, scalar, v_buf, grad_s);
+  return;
+#endif
+  const auto &dinv = geometry.contravariant;
+  constexpr int contra_iters = NP * NP;
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, contra_iters),
+                       [&](const int loop_idx) {
+    const int igp = loop_idx / NP;
+    const int jgp = loop_idx % NP;
+    Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
+      Scalar dsdx, dsdy;
+      for (int kgp = 0; kgp < NP; ++kgp) {
+        dsdx = fma(dvv_rrearth(jgp, kgp), scalar(igp, kgp, ilev), dsdx);
+        dsdy = fma(dvv_rrearth(jgp, kgp), scalar(kgp, igp, ilev), dsdy);
+      }
+      v_buf(kv.ie, 0, igp, jgp, ilev) = dsdx;
+      v_buf(kv.ie, 1, jgp, igp, ilev) = dsdy;
+    });
+  });
+  kv.team_barrier();
+
+  constexpr int grad_iters = NP * NP;
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, grad_iters),
+                       [&](const int loop_idx) {
+    const int igp = loop_idx / NP;
+    const int jgp = loop_idx % NP;
+    Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
+      grad_s(0, igp, jgp, ilev) =
+          fma(dinv(kv.ie, 0, 0, igp, jgp), v_buf(kv.ie, 0, igp, jgp, ilev),
+              dinv(kv.ie, 0, 1, igp, jgp) * v_buf(kv.ie, 1, igp, jgp, ilev));
+      grad_s(1, igp, jgp, ilev) =
+          fma(dinv(kv.ie, 1, 0, igp, jgp), v_buf(kv.ie, 0, igp, jgp, ilev),
+              dinv(kv.ie, 1, 1, igp, jgp) * v_buf(kv.ie, 1, igp, jgp, ilev));
+    });
+  });
+  kv.team_barrier();
+}
+
+KOKKOS_INLINE_FUNCTION void gradient_sphere_update(
+    const KernelVariables &kv,
+    const Elements::GeometryFactors &geometry,
+    const ExecViewUnmanaged<const Real         [NP][NP]>          dvv_rrearth,
+    const ExecViewUnmanaged<const Scalar       [NP][NP][NUM_LEV]> scalar,
+          ExecViewUnmanaged<      Scalar*   [2][NP][NP][NUM_LEV]> v_buf,
+          ExecViewUnmanaged<      Scalar    [2][NP][NP][NUM_LEV]> grad_s)
+{
+#ifdef HOMMEXX_GEMM_OPERATORS
+  gradient_sphere_update_gemm(kv, geometry, dvv_rrearth, scalar, v_buf,
+                              grad_s);
+  return;
+#endif
+  const auto &dinv = geometry.contravariant;
+  constexpr int contra_iters = NP * NP;
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, contra_iters),
+                       [&](const int loop_idx) {
+    const int igp = loop_idx / NP;
+    const int jgp = loop_idx % NP;
+    Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
+      Scalar dsdx, dsdy;
+      for (int kgp = 0; kgp < NP; ++kgp) {
+        dsdx = fma(dvv_rrearth(jgp, kgp), scalar(igp, kgp, ilev), dsdx);
+        dsdy = fma(dvv_rrearth(jgp, kgp), scalar(kgp, igp, ilev), dsdy);
+      }
+      v_buf(kv.ie, 0, igp, jgp, ilev) = dsdx;
+      v_buf(kv.ie, 1, jgp, igp, ilev) = dsdy;
+    });
+  });
+  kv.team_barrier();
+
+  constexpr int grad_iters = NP * NP;
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, grad_iters),
+                       [&](const int loop_idx) {
+    const int igp = loop_idx / NP;
+    const int jgp = loop_idx % NP;
+    Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
+      grad_s(0, igp, jgp, ilev) =
+          fma(dinv(kv.ie, 0, 0, igp, jgp), v_buf(kv.ie, 0, igp, jgp, ilev),
+              fma(dinv(kv.ie, 0, 1, igp, jgp), v_buf(kv.ie, 1, igp, jgp, ilev),
+                  grad_s(0, igp, jgp, ilev)));
+      grad_s(1, igp, jgp, ilev) =
+          fma(dinv(kv.ie, 1, 0, igp, jgp), v_buf(kv.ie, 0, igp, jgp, ilev),
+              fma(dinv(kv.ie, 1, 1, igp, jgp), v_buf(kv.ie, 1, igp, jgp, ilev),
+                  grad_s(1, igp, jgp, ilev)));
+    });
+  });
+  kv.team_barrier();
+}
+
+KOKKOS_INLINE_FUNCTION void
+divergence_sphere(const KernelVariables &kv,
+                  const Elements::GeometryFactors &geometry,
+                  const ExecViewUnmanaged<const Real        [NP][NP]>          dvv,
+                  const ExecViewUnmanaged<const Scalar   [2][NP][NP][NUM_LEV]> v,
+                        ExecViewUnmanaged<      Scalar*  [2][NP][NP][NUM_LEV]> gv_buf,
+                        ExecViewUnmanaged<      Scalar      [NP][NP][NUM_LEV]> div_v)
+{
+#ifdef HOMMEXX_GEMM_OPERATORS
+  divergence_sphere_gemm(kv, geometry, dvv, v, gv_buf, div_v);
+  return;
+#endif
+  const auto &dinv_metdet = geometry.contravariant_metdet;
+  const auto &rmetdet = geometry.rmetdet;
+  constexpr int contra_iters = NP * NP;
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, contra_iters),
+                       [&](const int loop_idx) {
+    const int igp = loop_idx / NP;
+    const int jgp = loop_idx % NP;
+    Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
+      gv_buf(kv.ie, 0, igp, jgp, ilev) =
+          fma(dinv_metdet(kv.ie, 0, 0, igp, jgp), v(0, igp, jgp, ilev),
+              dinv_metdet(kv.ie, 0, 1, igp, jgp) * v(1, igp, jgp, ilev));
+      gv_buf(kv.ie, 1, igp, jgp, ilev) =
+          fma(dinv_metdet(kv.ie, 1, 0, igp, jgp), v(0, igp, jgp, ilev),
+              dinv_metdet(kv.ie, 1, 1, igp, jgp) * v(1, igp, jgp, ilev));
+    });
+  });
+  kv.team_barrier();
+
+  constexpr int div_iters = NP * NP;
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, div_iters),
+                       [&](const int loop_idx) {
+    const int igp = loop_idx / NP;
+    const int jgp = loop_idx % NP;
+    Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
+      Scalar dudx, dvdy;
+      for (int kgp = 0; kgp < NP; ++kgp) {
+        dudx = fma(dvv(jgp, kgp), gv_buf(kv.ie, 0, igp, kgp, ilev), dudx);
+        dvdy = fma(dvv(igp, kgp), gv_buf(kv.ie, 1, kgp, jgp, ilev), dvdy);
+      }
+      div_v(igp, jgp, ilev) = (dudx + dvdy) * rmetdet(kv.ie, igp, jgp);
+    });
+  });
+  kv.team_barrier();
+}
+
+KOKKOS_INLINE_FUNCTION void
+vorticity_sphere(const KernelVariables &kv,
+                 const Elements::GeometryFactors &geometry,
+                 const ExecViewUnmanaged<const Real         [NP][NP]>          dvv,
+                 const ExecViewUnmanaged<const Scalar       [NP][NP][NUM_LEV]> u,
+                 const ExecViewUnmanaged<const Scalar       [NP][NP][NUM_LEV]> v,
+                       ExecViewUnmanaged<      Scalar*   [2][NP][NP][NUM_LEV]> vcov_buf,
+                       ExecViewUnmanaged<      Scalar       [NP][NP][NUM_LEV]> vort)
+{
+#ifdef HOMMEXX_GEMM_OPERATORS
+  vorticity_sphere_gemm(kv, geometry, dvv, u, v, vcov_buf, vort);
+  return;
+#endif
+  const auto &d = geometry.covariant;
+  const auto &rmetdet = geometry.rmetdet;
+  constexpr int covar_iters = NP * NP;
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, covar_iters),
+                       [&](const int loop_idx) {
+    const int igp = loop_idx / NP;
+    const int jgp = loop_idx % NP;
+    Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
+      vcov_buf(kv.ie, 0, jgp, igp, ilev) =
+          fma(d(kv.ie, 0, 0, jgp, igp), u(jgp, igp, ilev),
+              d(kv.ie, 0, 1, jgp, igp) * v(jgp, igp, ilev));
+      vcov_buf(kv.ie, 1, jgp, igp, ilev) =
+          fma(d(kv.ie, 1, 0, jgp, igp), u(jgp, igp, ilev),
+              d(kv.ie, 1, 1, jgp, igp) * v(jgp, igp, ilev));
+    });
+  });
+  kv.team_barrier();
+
+  constexpr int vort_iters = NP * NP;
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, vort_iters),
+                       [&](const int loop_idx) {
+    const int igp = loop_idx / NP;
+    const int jgp = loop_idx % NP;
+    Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
+      Scalar dudy, dvdx;
+      for (int kgp = 0; kgp < NP; ++kgp) {
+        dvdx = fma(dvv(jgp, kgp), vcov_buf(kv.ie, 1, igp, kgp, ilev), dvdx);
+        dudy = fma(dvv(igp, kgp), vcov_buf(kv.ie, 0, kgp, jgp, ilev), dudy);
+      }
+      vort(igp, jgp, ilev) = (dvdx - dudy) * rmetdet(kv.ie, igp, jgp);
+    });
+  });
+  kv.team_barrier();
+}
+
 } // namespace Homme
 
 #endif // HOMMEXX_SPHERE_OPERATORS_HPP
@@ -0,0 +1,276 @@
+#ifndef HOMMEXX_SPHERE_OPERATORS_GEMM_HPP
+#define HOMMEXX_SPHERE_OPERATORS_GEMM_HPP
+
+#include "Types.hpp"
+#include "Elements.hpp"
+#include "Dimensions.hpp"
+#include "KernelVariables.hpp"
+
+#include <Kokkos_Core.hpp>
+
+namespace Homme {
+
+// ================ BATCHED SMALL-GEMM IMPLEMENTATION ===================== //
+// The dvv contractions of the operators, stacked over the levels and the
+// points, are products of the NP x NP dvv with NP x N panels of the
+// level-packed fields:
+//   along the first index,  out(igp, jgp, :) = sum_k dvv(igp, k) f(k, jgp, :)
+//     is one panel per element, rows f(k, :, :) of N = NP * NUM_LEV packs;
+//   along the second index, out(igp, jgp, :) = sum_k dvv(jgp, k) f(igp, k, :)
+//     is one panel per igp, rows f(igp, k, :) of N = NUM_LEV packs.
+// The team splits the columns of the panels into blocks of GEMM_BLOCK packs,
+// and a register-blocked micro-kernel computes the NP rows of a block at
+// once, so that each pack of the panel is loaded once for the NP rows
+// (instead of once per output point as in the per-level operators). The
+// metric terms are then applied to the block in an epilogue. The operators
+// give the same results as the precomputed-geometry ones, bit for bit.
+// The threads do not split the packs of a block: this is a CPU backend.
+
+constexpr int GEMM_BLOCK = 2;
+
+// C(m, c) = sum_k dvv(m, k) B(k, c) for the columns [c0, c0 + Width) of a
+// panel with rows ldb packs apart; epilogue(m, c, C(m, c)) consumes them
+template <int Width, typename Epilogue>
+KOKKOS_INLINE_FUNCTION void dvv_micro_kernel(const Real (&dvv)[NP][NP],
+                                             const Scalar *const panel,
+                                             const int ldb, const int c0,
+                                             const Epilogue &epilogue) {
+  Scalar acc[NP][Width];
+  for (int k = 0; k < NP; ++k) {
+    for (int w = 0; w < Width; ++w) {
+      const Scalar b = panel[k * ldb + c0 + w];
+      for (int m = 0; m < NP; ++m) {
+        acc[m][w] = fma(dvv[m][k], b, acc[m][w]);
+      }
+    }
+  }
+  for (int m = 0; m < NP; ++m) {
+    for (int w = 0; w < Width; ++w) {
+      epilogue(m, c0 + w, acc[m][w]);
+    }
+  }
+}
+
+// The products of dvv with num_panels panels of NP rows of ncols packs,
+// panel p starting panel_stride packs after panel p - 1; the epilogue is
+// called as epilogue(p, m, c, C_p(m, c)). Each block reads its columns of
+// all the rows before it writes any output, so the output may overwrite
+// the columns of the block in the panel
+template <typename Epilogue>
+KOKKOS_INLINE_FUNCTION void
+dvv_panel_gemm(const KernelVariables &kv,
+               const ExecViewUnmanaged<const Real[NP][NP]> dvv_view,
+               const Scalar *const panels, const int num_panels,
+               const int panel_stride, const int ldb, const int ncols,
+               const Epilogue &epilogue) {
+  Real dvv[NP][NP];
+  for (int m = 0; m < NP; ++m) {
+    for (int k = 0; k < NP; ++k) {
+      dvv[m][k] = dvv_view(m, k);
+    }
+  }
+  const int num_blocks = (ncols + GEMM_BLOCK - 1) / GEMM_BLOCK;
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team,
+                                               num_panels * num_blocks),
+                       [&](const int loop_idx) {
+    const int p = loop_idx / num_blocks;
+    const int c0 = (loop_idx % num_blocks) * GEMM_BLOCK;
+    const Scalar *const panel = panels + p * panel_stride;
+    const auto panel_epilogue = [&](const int m, const int c,
+                                    const Scalar &value) {
+      epilogue(p, m, c, value);
+    };
+    if (c0 + GEMM_BLOCK <= ncols) {
+      dvv_micro_kernel<GEMM_BLOCK>(dvv, panel, ldb, c0, panel_epilogue);
+    } else {
+      for (int c = c0; c < ncols; ++c) {
+        dvv_micro_kernel<1>(dvv, panel, ldb, c, panel_epilogue);
+      }
+    }
+  });
+}
+
+// Contraction along the first index, a single panel of the field:
+// epilogue(igp, jgp, ilev, sum_k dvv(igp, k) f(k, jgp, ilev))
+template <typename Epilogue>
+KOKKOS_INLINE_FUNCTION void
+dvv_gemm_first(const KernelVariables &kv,
+               const ExecViewUnmanaged<const Real[NP][NP]> dvv,
+               const Scalar *const field, const Epilogue &epilogue) {
+  dvv_panel_gemm(kv, dvv, field, 1, 0, NP * NUM_LEV, NP * NUM_LEV,
+                 [&](const int, const int igp, const int c,
+                     const Scalar &value) {
+    epilogue(igp, c / NUM_LEV, c % NUM_LEV, value);
+  });
+}
+
+// Contraction along the second index, a panel per igp:
+// epilogue(igp, jgp, ilev, sum_k dvv(jgp, k) f(igp, k, ilev))
+template <typename Epilogue>
+KOKKOS_INLINE_FUNCTION void
+dvv_gemm_second(const KernelVariables &kv,
+                const ExecViewUnmanaged<const Real[NP][NP]> dvv,
+                const Scalar *const field, const Epilogue &epilogue) {
+  dvv_panel_gemm(kv, dvv, field, NP, NP * NUM_LEV, NUM_LEV, NUM_LEV,
+                 [&](const int igp, const int jgp, const int ilev,
+                     const Scalar &value) {
+    epilogue(igp, jgp, ilev, value);
+  });
+}
+
+// The derivative along the first index goes to v_buf(1), then the one
+// along the second index is combined with it and dinv in the epilogue
+KOKKOS_INLINE_FUNCTION void
+gradient_sphere_gemm(const KernelVariables &kv,
+                     const Elements::GeometryFactors &geometry,
+                     const ExecViewUnmanaged<const Real         [NP][NP]>          dvv_rrearth,
+                     const ExecViewUnmanaged<const Scalar       [NP][NP][NUM_LEV]> scalar,
+                           ExecViewUnmanaged<      Scalar*   [2][NP][NP][NUM_LEV]> v_buf,
+                           ExecViewUnmanaged<      Scalar    [2][NP][NP][NUM_LEV]> grad_s)
+{
+  const auto &dinv = geometry.contravariant;
+  dvv_gemm_first(kv, dvv_rrearth, scalar.data(),
+                 [&](const int igp, const int jgp, const int ilev,
+                     const Scalar &dsdy) {
+    v_buf(kv.ie, 1, igp, jgp, ilev) = dsdy;
+  });
+  kv.team_barrier();
+
+  dvv_gemm_second(kv, dvv_rrearth, scalar.data(),
+                  [&](const int igp, const int jgp, const int ilev,
+                      const Scalar &dsdx) {
+    grad_s(0, igp, jgp, ilev) =
+        fma(dinv(kv.ie, 0, 0, igp, jgp), dsdx,
+            dinv(kv.ie, 0, 1, igp, jgp) * v_buf(kv.ie, 1, igp, jgp, ilev));
+    grad_s(1, igp, jgp, ilev) =
+        fma(dinv(kv.ie, 1, 0, igp, jgp), dsdx,
+            dinv(kv.ie, 1, 1, igp, jgp) * v_buf(kv.ie, 1, igp, jgp, ilev));
+  });
+  kv.team_barrier();
+}
+
+KOKKOS_INLINE_FUNCTION void gradient_sphere_update_gemm(
+    const KernelVariables &kv,
+    const Elements::GeometryFactors &geometry,
+    const ExecViewUnmanaged<const Real         [NP][NP]>          dvv_rrearth,
+    const ExecViewUnmanaged<const Scalar       [NP][NP][NUM_LEV]> scalar,
+          ExecViewUnmanaged<      Scalar*   [2][NP][NP][NUM_LEV]> v_buf,
+          ExecViewUnmanaged<      Scalar    [2][NP][NP][NUM_LEV]> grad_s)
+{
+  const auto &dinv = geometry.contravariant;
+  dvv_gemm_first(kv, dvv_rrearth, scalar.data(),
+                 [&](const int igp, const int jgp, const int ilev,
+                     const Scalar &dsdy) {
+    v_buf(kv.ie, 1, igp, jgp, ilev) = dsdy;
+  });
+  kv.team_barrier();
+
+  dvv_gemm_second(kv, dvv_rrearth, scalar.data(),
+                  [&](const int igp, const int jgp, const int ilev,
+                      const Scalar &dsdx) {
+    grad_s(0, igp, jgp, ilev) =
+        fma(dinv(kv.ie, 0, 0, igp, jgp), dsdx,
+            fma(dinv(kv.ie, 0, 1, igp, jgp), v_buf(kv.ie, 1, igp, jgp, ilev),
+                grad_s(0, igp, jgp, ilev)));
+    grad_s(1, igp, jgp, ilev) =
+        fma(dinv(kv.ie, 1, 0, igp, jgp), dsdx,
+            fma(dinv(kv.ie, 1, 1, igp, jgp), v_buf(kv.ie, 1, igp, jgp, ilev),
+                grad_s(1, igp, jgp, ilev)));
+  });
+  kv.team_barrier();
+}
+
+// The contravariant components go to gv_buf, the derivative along the first
+// index overwrites gv_buf(1), and the one along the second is combined with
+// it and rmetdet in the epilogue
+KOKKOS_INLINE_FUNCTION void
+divergence_sphere_gemm(const KernelVariables &kv,
+                       const Elements::GeometryFactors &geometry,
+                       const ExecViewUnmanaged<const Real        [NP][NP]>          dvv,
+                       const ExecViewUnmanaged<const Scalar   [2][NP][NP][NUM_LEV]> v,
+                             ExecViewUnmanaged<      Scalar*  [2][NP][NP][NUM_LEV]> gv_buf,
+                             ExecViewUnmanaged<      Scalar      [NP][NP][NUM_LEV]> div_v)
+{
+  const auto &dinv_metdet = geometry.contravariant_metdet;
+  const auto &rmetdet = geometry.rmetdet;
+  constexpr int contra_iters = NP * NP;
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, contra_iters),
+                       [&](const int loop_idx) {
+    const int igp = loop_idx / NP;
+    const int jgp = loop_idx % NP;
+    Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
+      gv_buf(kv.ie, 0, igp, jgp, ilev) =
+          fma(dinv_metdet(kv.ie, 0, 0, igp, jgp), v(0, igp, jgp, ilev),
+              dinv_metdet(kv.ie, 0, 1, igp, jgp) * v(1, igp, jgp, ilev));
+      gv_buf(kv.ie, 1, igp, jgp, ilev) =
+          fma(dinv_metdet(kv.ie, 1, 0, igp, jgp), v(0, igp, jgp, ilev),
+              dinv_metdet(kv.ie, 1, 1, igp, jgp) * v(1, igp, jgp, ilev));
+    });
+  });
+  kv.team_barrier();
+
+  dvv_gemm_first(kv, dvv, &gv_buf(kv.ie, 1, 0, 0, 0),
+                 [&](const int igp, const int jgp, const int ilev,
+                     const Scalar &dvdy) {
+    gv_buf(kv.ie, 1, igp, jgp, ilev) = dvdy;
+  });
+  kv.team_barrier();
+
+  dvv_gemm_second(kv, dvv, &gv_buf(kv.ie, 0, 0, 0, 0),
+                  [&](const int igp, const int jgp, const int ilev,
+                      const Scalar &dudx) {
+    div_v(igp, jgp, ilev) =
+        (dudx + gv_buf(kv.ie, 1, igp, jgp, ilev)) * rmetdet(kv.ie, igp, jgp);
+  });
+  kv.team_barrier();
+}
+
+// The covariant components go to vcov_buf, the derivative of the first one
+// along the first index overwrites vcov_buf(0), and the one of the second
+// along the second index is combined with it and rmetdet in the epilogue
+KOKKOS_INLINE_FUNCTION void
+vorticity_sphere_gemm(const KernelVariables &kv,
+                      const Elements::GeometryFactors &geometry,
+                      const ExecViewUnmanaged<const Real         [NP][NP]>          dvv,
+                      const ExecViewUnmanaged<const Scalar       [NP][NP][NUM_LEV]> u,
+                      const ExecViewUnmanaged<const Scalar       [NP][NP][NUM_LEV]> v,
+                            ExecViewUnmanaged<      Scalar*   [2][NP][NP][NUM_LEV]> vcov_buf,
+                            ExecViewUnmanaged<      Scalar       [NP][NP][NUM_LEV]> vort)
+{
+  const auto &d = geometry.covariant;
+  const auto &rmetdet = geometry.rmetdet;
+  constexpr int covar_iters = NP * NP;
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, covar_iters),
+                       [&](const int loop_idx) {
+    const int igp = loop_idx / NP;
+    const int jgp = loop_idx % NP;
+    Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV), [&] (const int& ilev) {
+      vcov_buf(kv.ie, 0, igp, jgp, ilev) =
+          fma(d(kv.ie, 0, 0, igp, jgp), u(igp, jgp, ilev),
+              d(kv.ie, 0, 1, igp, jgp) * v(igp, jgp, ilev));
+      vcov_buf(kv.ie, 1, igp, jgp, ilev) =
+          fma(d(kv.ie, 1, 0, igp, jgp), u(igp, jgp, ilev),
+              d(kv.ie, 1, 1, igp, jgp) * v(igp, jgp, ilev));
+    });
+  });
+  kv.team_barrier();
+
+  dvv_gemm_first(kv, dvv, &vcov_buf(kv.ie, 0, 0, 0, 0),
+                 [&](const int igp, const int jgp, const int ilev,
+                     const Scalar &dudy) {
+    vcov_buf(kv.ie, 0, igp, jgp, ilev) = dudy;
+  });
+  kv.team_barrier();
+
+  dvv_gemm_second(kv, dvv, &vcov_buf(kv.ie, 1, 0, 0, 0),
+                  [&](const int igp, const int jgp, const int ilev,
+                      const Scalar &dvdx) {
+    vort(igp, jgp, ilev) =
+        (dvdx - vcov_buf(kv.ie, 0, igp, jgp, ilev)) * rmetdet(kv.ie, igp, jgp);
+  });
+  kv.team_barrier();
+}
+
+} // namespace Homme
+
+#endif // HOMMEXX_SPHERE_OPERATORS_GEMM_HPP
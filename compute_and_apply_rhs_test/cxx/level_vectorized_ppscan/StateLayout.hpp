@@ -0,0 +1,215 @@
+#ifndef HOMMEXX_STATE_LAYOUT_HPP
+#define HOMMEXX_STATE_LAYOUT_HPP
+
+#include "Types.hpp"
+
+#include <string>
+
+namespace Homme {
+
+// The indices of the prognostic state array. A layout is an ordering of
+// them, from the slowest to the fastest. The levels are split into packs
+// (LEVEL_INDEX) of VECTOR_SIZE levels (VECTOR_INDEX), so that the layouts of
+// the vectorized variants can be expressed too
+enum StateIndex {
+  ELEM_INDEX = 0,
+  TIME_LEVEL_INDEX,
+  FIELD_INDEX,
+  LEVEL_INDEX,
+  VECTOR_INDEX,
+  IGP_INDEX,
+  JGP_INDEX,
+  NUM_STATE_INDICES
+};
+
+// The fields of the state array, the first four of ST in the Fortran code
+enum StateField { U_FIELD = 0, V_FIELD, T_FIELD, DP3D_FIELD, NUM_ST_FIELDS };
+
+// Extent of an index; the number of elements is only known at runtime
+KOKKOS_INLINE_FUNCTION constexpr int static_extent(const int index) {
+  return index == TIME_LEVEL_INDEX ? NUM_TIME_LEVELS
+         : index == FIELD_INDEX ? NUM_ST_FIELDS
+         : index == LEVEL_INDEX ? NUM_LEV
+         : index == VECTOR_INDEX ? VECTOR_SIZE
+         : index == IGP_INDEX || index == JGP_INDEX ? NP
+         : 1;
+}
+
+// Product of the static extents of the indices, and whether one of them is
+// the element
+template <int... Indices> struct ExtentProduct;
+
+template <> struct ExtentProduct<> {
+  static constexpr int value = 1;
+  static constexpr bool has_elem = false;
+};
+
+template <int First, int... Rest> struct ExtentProduct<First, Rest...> {
+  static constexpr int value =
+      static_extent(First) * ExtentProduct<Rest...>::value;
+  static constexpr bool has_elem =
+      First == ELEM_INDEX || ExtentProduct<Rest...>::has_elem;
+};
+
+// Stride of Index in the ordering Order: the product of the extents of the
+// indices after it
+template <int Index, int... Order> struct IndexStride;
+
+template <int Index> struct IndexStride<Index> {
+  static constexpr int value = 0;
+  static constexpr bool times_elems = false;
+  static constexpr int count = 0;
+};
+
+template <int Index, int First, int... Rest>
+struct IndexStride<Index, First, Rest...> {
+  static constexpr int value = First == Index
+                                   ? ExtentProduct<Rest...>::value
+                                   : IndexStride<Index, Rest...>::value;
+  static constexpr bool times_elems =
+      First == Index ? ExtentProduct<Rest...>::has_elem
+                     : IndexStride<Index, Rest...>::times_elems;
+  // Number of occurrences of Index in the ordering
+  static constexpr int count =
+      (First == Index ? 1 : 0) + IndexStride<Index, Rest...>::count;
+};
+
+/* Layout of ST(np, np, nlev, nelemd, numst, timelevels) given by the order of
+ * its indices, as in the STVER1-4 builds of the Fortran benchmark. All the
+ * strides but those multiplied by the number of elements are compile time
+ * constants, so the contiguous indices of a layout vectorize. */
+template <int... Order> class StateLayout {
+  static_assert(sizeof...(Order) == NUM_STATE_INDICES,
+                "A state layout orders all the indices of the state");
+  static_assert(IndexStride<ELEM_INDEX, Order...>::count == 1 &&
+                    IndexStride<TIME_LEVEL_INDEX, Order...>::count == 1 &&
+                    IndexStride<FIELD_INDEX, Order...>::count == 1 &&
+                    IndexStride<LEVEL_INDEX, Order...>::count == 1 &&
+                    IndexStride<VECTOR_INDEX, Order...>::count == 1 &&
+                    IndexStride<IGP_INDEX, Order...>::count == 1 &&
+                    IndexStride<JGP_INDEX, Order...>::count == 1,
+                "A state layout has every index once");
+
+public:
+  // Whether the levels of a point are closer than the points of a level:
+  // the kernels then loop over the levels innermost
+  static constexpr bool levels_innermost =
+      IndexStride<VECTOR_INDEX, Order...>::value <
+      IndexStride<JGP_INDEX, Order...>::value;
+
+  StateLayout() = default;
+  explicit StateLayout(const int num_elems) : m_num_elems(num_elems) {}
+
+  size_t size() const {
+    return static_cast<size_t>(m_num_elems) *
+           ExtentProduct<Order...>::value;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  size_t offset(const int ie, const int tl, const int field, const int ilev,
+                const int igp, const int jgp) const {
+    return stride<ELEM_INDEX>() * ie + stride<TIME_LEVEL_INDEX>() * tl +
+           stride<FIELD_INDEX>() * field +
+           stride<LEVEL_INDEX>() * (ilev / VECTOR_SIZE) +
+           stride<VECTOR_INDEX>() * (ilev % VECTOR_SIZE) +
+           stride<IGP_INDEX>() * igp + stride<JGP_INDEX>() * jgp;
+  }
+
+  // Offset of a point of a level in the NP x NP x NUM_PHYSICAL_LEV values
+  // of an element, in the order the kernels loop over them
+  KOKKOS_INLINE_FUNCTION
+  static constexpr int point_offset(const int ilev, const int igp,
+                                    const int jgp) {
+    return levels_innermost ? (igp * NP + jgp) * NUM_PHYSICAL_LEV + ilev
+                            : (ilev * NP + igp) * NP + jgp;
+  }
+
+private:
+  template <int Index> KOKKOS_INLINE_FUNCTION size_t stride() const {
+    return IndexStride<Index, Order...>::times_elems
+               ? static_cast<size_t>(IndexStride<Index, Order...>::value) *
+                     m_num_elems
+               : static_cast<size_t>(IndexStride<Index, Order...>::value);
+  }
+
+  int m_num_elems;
+};
+
+// The orderings of ST in the Fortran benchmark (config1.h-config4.h). The
+// Fortran i index is jgp here
+using STVer1Layout =
+    StateLayout<TIME_LEVEL_INDEX, FIELD_INDEX, ELEM_INDEX, LEVEL_INDEX,
+                VECTOR_INDEX, IGP_INDEX, JGP_INDEX>;
+using STVer2Layout =
+    StateLayout<TIME_LEVEL_INDEX, ELEM_INDEX, FIELD_INDEX, LEVEL_INDEX,
+                VECTOR_INDEX, IGP_INDEX, JGP_INDEX>;
+// Also m_4d_scalars of kokkos_basic and kokkos_scratch
+using STVer3Layout =
+    StateLayout<ELEM_INDEX, TIME_LEVEL_INDEX, FIELD_INDEX, LEVEL_INDEX,
+                VECTOR_INDEX, IGP_INDEX, JGP_INDEX>;
+using STVer4Layout =
+    StateLayout<ELEM_INDEX, FIELD_INDEX, TIME_LEVEL_INDEX, LEVEL_INDEX,
+                VECTOR_INDEX, IGP_INDEX, JGP_INDEX>;
+// A view per field, with packs of levels (tiled_vectorized_ppscan)
+using TiledLayout =
+    StateLayout<FIELD_INDEX, ELEM_INDEX, TIME_LEVEL_INDEX, LEVEL_INDEX,
+                IGP_INDEX, JGP_INDEX, VECTOR_INDEX>;
+// A view per field, with the levels innermost (level_vectorized_ppscan)
+using LevelLayout =
+    StateLayout<FIELD_INDEX, ELEM_INDEX, TIME_LEVEL_INDEX, IGP_INDEX,
+                JGP_INDEX, LEVEL_INDEX, VECTOR_INDEX>;
+
+// The state of all the elements, stored in the given layout
+template <typename Layout> class State {
+public:
+  State() = default;
+  explicit State(const int num_elems)
+      : m_layout(num_elems), m_data("state", m_layout.size()) {}
+
+  KOKKOS_INLINE_FUNCTION
+  Real &operator()(const int ie, const int tl, const int field,
+                   const int ilev, const int igp, const int jgp) const {
+    return m_data(m_layout.offset(ie, tl, field, ilev, igp, jgp));
+  }
+
+  const Layout &layout() const { return m_layout; }
+  ExecViewManaged<Real *> data() const { return m_data; }
+
+private:
+  Layout m_layout;
+  ExecViewManaged<Real *> m_data;
+};
+
+// A field of num_components values per point of every level of every
+// element, which follows the loop order of Layout
+template <typename Layout, int num_components = 1> class PointField {
+public:
+  static constexpr int ELEM_SIZE = num_components * NP * NP * NUM_PHYSICAL_LEV;
+
+  PointField() = default;
+  PointField(const std::string &name, const int num_elems)
+      : m_data(name, static_cast<size_t>(num_elems) * ELEM_SIZE) {}
+
+  KOKKOS_INLINE_FUNCTION
+  static size_t offset(const int ie, const int ilev, const int igp,
+                       const int jgp, const int component = 0) {
+    return static_cast<size_t>(ie) * ELEM_SIZE +
+           component * NP * NP * NUM_PHYSICAL_LEV +
+           Layout::point_offset(ilev, igp, jgp);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  Real &operator()(const int ie, const int ilev, const int igp, const int jgp,
+                   const int component = 0) const {
+    return m_data(offset(ie, ilev, igp, jgp, component));
+  }
+
+  ExecViewManaged<Real *> data() const { return m_data; }
+
+private:
+  ExecViewManaged<Real *> m_data;
+};
+
+} // namespace Homme
+
+#endif // HOMMEXX_STATE_LAYOUT_HPP
@@ -0,0 +1,75 @@
+#ifndef HOMMEXX_STEP_FUNCTOR_HPP
+#define HOMMEXX_STEP_FUNCTOR_HPP
+
+#include "Types.hpp"
+#include "Control.hpp"
+#include "Elements.hpp"
+#include "Derivative.hpp"
+#include "KernelVariables.hpp"
+#include "CaarFunctor.hpp"
+#include "EulerStepFunctor.hpp"
+
+#include "profiling.hpp"
+
+namespace Homme {
+
+// CAAR followed by the Euler step of the tracers in a single launch. Each
+// team advects the tracers of its element right after its CAAR, while the
+// geometry, dp3d(np1) and the mass flux of that element are still in cache,
+// instead of reloading them in a second kernel. Builds with
+// HOMMEXX_UNFUSED_STEP launch the two functors separately, which must give
+// bitwise the same results
+struct StepFunctor {
+  const CaarFunctor m_caar;
+  const EulerStepFunctor m_euler_step;
+
+  StepFunctor(const Control &data, const Elements &elements,
+              const Derivative &deriv)
+      : m_caar(caar_control(data), elements, deriv),
+        m_euler_step(data, elements, deriv) {
+    // Nothing to be done here
+  }
+
+  // The control of the CAAR of the step: dp3d(np1), which the Euler step
+  // reads right after, is written with regular stores to stay in cache
+  static Control caar_control(const Control &data) {
+    Control caar_data = data;
+    caar_data.stream_dp3d = false;
+    return caar_data;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const TeamMember &team) const {
+    start_timer("step compute");
+    KernelVariables kv(team, m_caar.m_data.nets);
+    m_caar.prefetch_next_element(kv);
+    m_caar.compute(kv);
+    kv.team_barrier();
+    m_euler_step.compute(kv);
+    stop_timer("step compute");
+  }
+
+  // The step with the CAAR diagnostics, as CaarFunctor computes them
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const TeamMember &team, CaarDiagnostics &diagnostics) const {
+    start_timer("step compute");
+    KernelVariables kv(team, m_caar.m_data.nets);
+    m_caar.prefetch_next_element(kv);
+    m_caar.compute<true>(kv);
+    kv.team_barrier();
+    Kokkos::single(Kokkos::PerTeam(kv.team), [&]() {
+      diagnostics += m_caar.element_diagnostics(kv);
+    });
+    m_euler_step.compute(kv);
+    stop_timer("step compute");
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  size_t shmem_size(const int team_size) const {
+    return KernelVariables::shmem_size(team_size);
+  }
+};
+
+} // namespace Homme
+
+#endif // HOMMEXX_STEP_FUNCTOR_HPP
@@ -0,0 +1,563 @@
+#include "Topology.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <set>
+#include <utility>
+
+#if !defined(HOMMEXX_CUDA_SPACE) &&                                            \
+    !(defined(HOMMEXX_DEFAULT_SPACE) && defined(KOKKOS_ENABLE_CUDA)) &&        \
+    (defined(HOMMEXX_USE_HWLOC) || defined(__linux__))
+#define HOMMEXX_HOST_TOPOLOGY
+#ifdef HOMMEXX_USE_HWLOC
+#include <hwloc.h>
+#endif
+#ifdef __linux__
+#include <sched.h>
+
+#include <dirent.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#endif
+#endif
+
+namespace Homme {
+
+namespace {
+
+#ifdef HOMMEXX_HOST_TOPOLOGY
+
+#ifdef HOMMEXX_USE_HWLOC
+
+// A loaded hwloc topology, destroyed with it
+class HwlocTopology {
+public:
+  HwlocTopology() {
+    hwloc_topology_init(&m_topology);
+    hwloc_topology_load(m_topology);
+  }
+  ~HwlocTopology() { hwloc_topology_destroy(m_topology); }
+
+  HwlocTopology(const HwlocTopology &) = delete;
+  HwlocTopology &operator=(const HwlocTopology &) = delete;
+
+  hwloc_topology_t get() const { return m_topology; }
+
+private:
+  hwloc_topology_t m_topology;
+};
+
+// The logical index of the cache of the given level above pu (-1 if none)
+int cache_id(hwloc_topology_t topology, hwloc_obj_t pu, const int level) {
+#if HWLOC_API_VERSION >= 0x00020000
+  const hwloc_obj_type_t type =
+      level == 2 ? HWLOC_OBJ_L2CACHE : HWLOC_OBJ_L3CACHE;
+  const hwloc_obj_t cache = hwloc_get_ancestor_obj_by_type(topology, type, pu);
+  return cache == nullptr ? -1 : static_cast<int>(cache->logical_index);
+#else
+  (void)topology;
+  for (hwloc_obj_t obj = pu->parent; obj != nullptr; obj = obj->parent) {
+    if (obj->type == HWLOC_OBJ_CACHE &&
+        static_cast<int>(obj->attr->cache.depth) == level) {
+      return obj->logical_index;
+    }
+  }
+  return -1;
+#endif
+}
+
+std::vector<ProcessingUnit> detect_units(const std::set<int> &allowed) {
+  const HwlocTopology hwloc;
+  hwloc_topology_t topology = hwloc.get();
+  std::vector<ProcessingUnit> units;
+  const int num_pus = hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_PU);
+  const int num_nodes = hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_NUMANODE);
+  for (int i = 0; i < num_pus; ++i) {
+    const hwloc_obj_t pu = hwloc_get_obj_by_type(topology, HWLOC_OBJ_PU, i);
+    const int cpu = pu->os_index;
+    if (allowed.count(cpu) == 0) {
+      continue;
+    }
+    ProcessingUnit unit;
+    unit.cpu = cpu;
+    const hwloc_obj_t core =
+        hwloc_get_ancestor_obj_by_type(topology, HWLOC_OBJ_CORE, pu);
+    // Without cores (some virtual machines), each unit is its own core
+    unit.core = core == nullptr ? num_pus + i : core->logical_index;
+    // In hwloc 2 the NUMA nodes are not ancestors of the units
+    unit.numa = -1;
+    for (int n = 0; n < num_nodes; ++n) {
+      const hwloc_obj_t node =
+          hwloc_get_obj_by_type(topology, HWLOC_OBJ_NUMANODE, n);
+      if (hwloc_bitmap_isset(node->cpuset, cpu)) {
+        unit.numa = node->os_index;
+        break;
+      }
+    }
+    unit.l2 = cache_id(topology, pu, 2);
+    unit.l3 = cache_id(topology, pu, 3);
+    units.push_back(unit);
+  }
+  return units;
+}
+
+// The cpus thread i of the execution space may run on, for i up to its
+// concurrency
+std::vector<std::vector<int> > thread_cpus() {
+  const HwlocTopology hwloc;
+  hwloc_topology_t topology = hwloc.get();
+  const int num_threads = ExecSpace::concurrency();
+  std::vector<hwloc_bitmap_t> sets(num_threads);
+  for (auto &set : sets) {
+    set = hwloc_bitmap_alloc();
+  }
+  hwloc_bitmap_t *const data = sets.data();
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecSpace>(0, num_threads),
+      KOKKOS_LAMBDA(const int i) {
+        hwloc_get_cpubind(topology, data[i], HWLOC_CPUBIND_THREAD);
+      });
+  ExecSpace::fence();
+
+  std::vector<std::vector<int> > cpus(num_threads);
+  for (int i = 0; i < num_threads; ++i) {
+    int cpu;
+    hwloc_bitmap_foreach_begin(cpu, sets[i]) { cpus[i].push_back(cpu); }
+    hwloc_bitmap_foreach_end();
+    hwloc_bitmap_free(sets[i]);
+  }
+  return cpus;
+}
+
+#else // HOMMEXX_USE_HWLOC
+
+// The first line of a sysfs file (empty if it cannot be read)
+std::string read_line(const std::string &path) {
+  std::ifstream file(path);
+  std::string line;
+  std::getline(file, line);
+  return line;
+}
+
+// The cpus of a sysfs cpu list, as "0-3,8,10-11"
+std::vector<int> parse_cpu_list(const std::string &list) {
+  std::vector<int> cpus;
+  std::istringstream ranges(list);
+  std::string range;
+  while (std::getline(ranges, range, ',')) {
+    int first, last;
+    const int read = std::sscanf(range.c_str(), "%d-%d", &first, &last);
+    if (read == 1) {
+      last = first;
+    }
+    for (int cpu = first; read > 0 && cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+// The first cpu sharing the data or unified cache of the given level with
+// cpu, as the id of the cache (-1 if sysfs does not have the cache)
+int cache_id(const std::string &cpu_dir, const int level) {
+  for (int index = 0;; ++index) {
+    const std::string dir = cpu_dir + "/cache/index" + std::to_string(index);
+    const std::string cache_level = read_line(dir + "/level");
+    if (cache_level.empty()) {
+      return -1;
+    }
+    const std::string type = read_line(dir + "/type");
+    if (std::atoi(cache_level.c_str()) == level && type != "Instruction") {
+      const std::vector<int> shared =
+          parse_cpu_list(read_line(dir + "/shared_cpu_list"));
+      return shared.empty() ? -1
+                            : *std::min_element(shared.begin(), shared.end());
+    }
+  }
+}
+
+// The NUMA node of each cpu, from /sys/devices/system/node
+std::map<int, int> numa_nodes() {
+  const std::string node_dir = "/sys/devices/system/node";
+  std::map<int, int> numa;
+  DIR *dir = opendir(node_dir.c_str());
+  if (dir == nullptr) {
+    return numa;
+  }
+  while (const dirent *entry = readdir(dir)) {
+    int node;
+    if (std::sscanf(entry->d_name, "node%d", &node) == 1) {
+      const std::string list =
+          read_line(node_dir + "/" + entry->d_name + "/cpulist");
+      for (const int cpu : parse_cpu_list(list)) {
+        numa[cpu] = node;
+      }
+    }
+  }
+  closedir(dir);
+  return numa;
+}
+
+std::vector<ProcessingUnit> detect_units(const std::set<int> &allowed) {
+  const std::map<int, int> numa = numa_nodes();
+  // The cores are numbered by package, and then by core id in the package
+  std::map<std::pair<int, int>, int> cores;
+  std::vector<ProcessingUnit> units;
+  for (const int cpu : allowed) {
+    const std::string cpu_dir =
+        "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    const std::string core_id = read_line(cpu_dir + "/topology/core_id");
+    const std::string package =
+        read_line(cpu_dir + "/topology/physical_package_id");
+    // Without a core id, each unit is its own core
+    const std::pair<int, int> key =
+        core_id.empty() ? std::make_pair(-1, cpu)
+                        : std::make_pair(std::atoi(package.c_str()),
+                                         std::atoi(core_id.c_str()));
+    const auto core = cores.insert(std::make_pair(key, cores.size())).first;
+
+    ProcessingUnit unit;
+    unit.cpu = cpu;
+    unit.core = core->second;
+    const auto node = numa.find(cpu);
+    unit.numa = node == numa.end() ? -1 : node->second;
+    unit.l2 = cache_id(cpu_dir, 2);
+    unit.l3 = cache_id(cpu_dir, 3);
+    units.push_back(unit);
+  }
+  return units;
+}
+
+std::vector<std::vector<int> > thread_cpus() {
+  const int num_threads = ExecSpace::concurrency();
+  std::vector<cpu_set_t> sets(num_threads);
+  cpu_set_t *const data = sets.data();
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecSpace>(0, num_threads),
+      KOKKOS_LAMBDA(const int i) {
+        CPU_ZERO(&data[i]);
+        sched_getaffinity(0, sizeof(cpu_set_t), &data[i]);
+      });
+  ExecSpace::fence();
+
+  std::vector<std::vector<int> > cpus(num_threads);
+  for (int i = 0; i < num_threads; ++i) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &sets[i])) {
+        cpus[i].push_back(cpu);
+      }
+    }
+  }
+  return cpus;
+}
+
+#endif // HOMMEXX_USE_HWLOC
+
+// The cpu each thread of the execution space runs on (-1 if unknown)
+std::vector<int> current_cpus() {
+  const int num_threads = ExecSpace::concurrency();
+  std::vector<int> cpus(num_threads, -1);
+  int *const data = cpus.data();
+#ifdef __linux__
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecSpace>(0, num_threads),
+      KOKKOS_LAMBDA(const int i) { data[i] = sched_getcpu(); });
+#else
+  const HwlocTopology hwloc;
+  hwloc_topology_t topology = hwloc.get();
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecSpace>(0, num_threads),
+      KOKKOS_LAMBDA(const int i) {
+        hwloc_bitmap_t set = hwloc_bitmap_alloc();
+        if (hwloc_get_last_cpu_location(topology, set,
+                                        HWLOC_CPUBIND_THREAD) == 0) {
+          data[i] = hwloc_bitmap_first(set);
+        }
+        hwloc_bitmap_free(set);
+      });
+#endif
+  ExecSpace::fence();
+  return cpus;
+}
+
+#endif // HOMMEXX_HOST_TOPOLOGY
+
+// Units are sorted by NUMA node, then L3, L2, core and cpu, so that the
+// units close in the list are close in the machine
+bool topology_order(const ProcessingUnit &a, const ProcessingUnit &b) {
+  if (a.numa != b.numa) {
+    return a.numa < b.numa;
+  } else if (a.l3 != b.l3) {
+    return a.l3 < b.l3;
+  } else if (a.l2 != b.l2) {
+    return a.l2 < b.l2;
+  } else if (a.core != b.core) {
+    return a.core < b.core;
+  }
+  return a.cpu < b.cpu;
+}
+
+int count_distinct(const std::vector<ProcessingUnit> &units,
+                   int ProcessingUnit::*member) {
+  std::set<int> ids;
+  for (const ProcessingUnit &unit : units) {
+    ids.insert(unit.*member);
+  }
+  return ids.size();
+}
+
+} // namespace
+
+const char *binding_policy_name(const BindingPolicy policy) {
+  switch (policy) {
+  case BindingPolicy::COMPACT:
+    return "compact";
+  case BindingPolicy::SCATTER:
+    return "scatter";
+  case BindingPolicy::TEAM_PER_L2:
+    return "one team per L2";
+  default:
+    return "none";
+  }
+}
+
+bool parse_binding_policy(const char *name, BindingPolicy &policy) {
+  if (std::strcmp(name, "none") == 0) {
+    policy = BindingPolicy::NONE;
+  } else if (std::strcmp(name, "compact") == 0) {
+    policy = BindingPolicy::COMPACT;
+  } else if (std::strcmp(name, "scatter") == 0) {
+    policy = BindingPolicy::SCATTER;
+  } else if (std::strcmp(name, "l2") == 0) {
+    policy = BindingPolicy::TEAM_PER_L2;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+Topology::Topology() : m_source("sysfs") {
+#ifdef HOMMEXX_HOST_TOPOLOGY
+#ifdef HOMMEXX_USE_HWLOC
+  m_source = "hwloc";
+#endif
+  std::set<int> allowed;
+  for (const std::vector<int> &cpus : thread_cpus()) {
+    allowed.insert(cpus.begin(), cpus.end());
+  }
+  m_units = detect_units(allowed);
+  std::sort(m_units.begin(), m_units.end(), topology_order);
+#endif // HOMMEXX_HOST_TOPOLOGY
+}
+
+int Topology::num_cores() const {
+  return count_distinct(m_units, &ProcessingUnit::core);
+}
+
+int Topology::num_numa_nodes() const {
+  return count_distinct(m_units, &ProcessingUnit::numa);
+}
+
+std::vector<int> Topology::compact_order(const std::vector<int> &units) const {
+  // The k-th unit of each core goes after the (k-1)-th unit of all of them
+  std::map<int, int> seen;
+  std::vector<std::pair<int, int> > ranked;
+  for (const int unit : units) {
+    ranked.push_back(std::make_pair(seen[m_units[unit].core]++, unit));
+  }
+  std::stable_sort(
+      ranked.begin(), ranked.end(),
+      [](const std::pair<int, int> &a, const std::pair<int, int> &b) {
+        return a.first < b.first;
+      });
+  std::vector<int> order;
+  for (const auto &rank : ranked) {
+    order.push_back(rank.second);
+  }
+  return order;
+}
+
+std::vector<std::vector<int> >
+Topology::team_domains(const int threads_per_team, const char *&level) const {
+  // The smallest shared cache (or NUMA node) every domain of which holds a
+  // team, skipping the levels the topology does not know
+  const std::pair<const char *, int ProcessingUnit::*> levels[] = {
+    { "L2", &ProcessingUnit::l2 },
+    { "L3", &ProcessingUnit::l3 },
+    { "NUMA node", &ProcessingUnit::numa }
+  };
+  for (const auto &candidate : levels) {
+    std::map<int, std::vector<int> > domains;
+    bool known = true;
+    for (int unit = 0; unit < static_cast<int>(m_units.size()); ++unit) {
+      const int id = m_units[unit].*candidate.second;
+      known = known && id >= 0;
+      domains[id].push_back(unit);
+    }
+    bool fits = known;
+    for (const auto &domain : domains) {
+      fits = fits &&
+             static_cast<int>(domain.second.size()) >= threads_per_team;
+    }
+    if (fits) {
+      level = candidate.first;
+      std::vector<std::vector<int> > ordered;
+      for (const auto &domain : domains) {
+        ordered.push_back(compact_order(domain.second));
+      }
+      return ordered;
+    }
+  }
+
+  level = "machine";
+  std::vector<int> all(m_units.size());
+  for (int unit = 0; unit < static_cast<int>(all.size()); ++unit) {
+    all[unit] = unit;
+  }
+  return std::vector<std::vector<int> >(1, compact_order(all));
+}
+
+const char *Topology::team_domain(const int threads_per_team) const {
+  const char *level;
+  team_domains(threads_per_team, level);
+  return level;
+}
+
+std::vector<int> Topology::placement(const BindingPolicy policy,
+                                     const int num_threads,
+                                     const int threads_per_team) const {
+  std::vector<int> placement;
+  if (m_units.empty() || policy == BindingPolicy::NONE) {
+    return placement;
+  }
+
+  std::vector<int> all(m_units.size());
+  for (int unit = 0; unit < static_cast<int>(all.size()); ++unit) {
+    all[unit] = unit;
+  }
+
+  if (policy == BindingPolicy::COMPACT) {
+    const std::vector<int> order = compact_order(all);
+    for (int thread = 0; thread < num_threads; ++thread) {
+      placement.push_back(order[thread % order.size()]);
+    }
+  } else if (policy == BindingPolicy::SCATTER) {
+    // Each NUMA node in compact order, and the threads dealt to the nodes
+    std::map<int, std::vector<int> > by_node;
+    for (const int unit : compact_order(all)) {
+      by_node[m_units[unit].numa].push_back(unit);
+    }
+    std::vector<std::vector<int> > nodes;
+    for (const auto &node : by_node) {
+      nodes.push_back(node.second);
+    }
+    for (int thread = 0; thread < num_threads; ++thread) {
+      const std::vector<int> &node = nodes[thread % nodes.size()];
+      placement.push_back(node[(thread / nodes.size()) % node.size()]);
+    }
+  } else {
+    // Team k on domain k % D; the teams sharing a domain take its units in
+    // turn, so that they only share a core when the domain is full
+    const char *level;
+    const std::vector<std::vector<int> > domains =
+        team_domains(threads_per_team, level);
+    const int num_domains = domains.size();
+    for (int thread = 0; thread < num_threads; ++thread) {
+      const int team = thread / threads_per_team;
+      const int member = thread % threads_per_team;
+      const std::vector<int> &domain = domains[team % num_domains];
+      const int slot = (team / num_domains) * threads_per_team + member;
+      placement.push_back(domain[slot % domain.size()]);
+    }
+  }
+  return placement;
+}
+
+bool Topology::bind(const std::vector<int> &placement) const {
+#ifdef HOMMEXX_HOST_TOPOLOGY
+  const int num_threads =
+      std::min<int>(placement.size(), ExecSpace::concurrency());
+  std::vector<int> cpus(num_threads);
+  for (int thread = 0; thread < num_threads; ++thread) {
+    cpus[thread] = m_units[placement[thread]].cpu;
+  }
+  std::vector<int> failed(num_threads, 0);
+  const int *const cpu = cpus.data();
+  int *const fail = failed.data();
+#ifdef HOMMEXX_USE_HWLOC
+  const HwlocTopology hwloc;
+  hwloc_topology_t topology = hwloc.get();
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecSpace>(0, num_threads),
+      KOKKOS_LAMBDA(const int i) {
+        hwloc_bitmap_t set = hwloc_bitmap_alloc();
+        hwloc_bitmap_only(set, cpu[i]);
+        fail[i] = hwloc_set_cpubind(topology, set, HWLOC_CPUBIND_THREAD) != 0;
+        hwloc_bitmap_free(set);
+      });
+#else
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecSpace>(0, num_threads),
+      KOKKOS_LAMBDA(const int i) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu[i], &set);
+        fail[i] = sched_setaffinity(0, sizeof(cpu_set_t), &set) != 0;
+      });
+#endif // HOMMEXX_USE_HWLOC
+  ExecSpace::fence();
+  return std::count(failed.begin(), failed.end(), 1) == 0;
+#else
+  return placement.empty();
+#endif // HOMMEXX_HOST_TOPOLOGY
+}
+
+void Topology::print_thread_map(std::ostream &out,
+                                const int threads_per_team) const {
+#ifdef HOMMEXX_HOST_TOPOLOGY
+  std::map<int, const ProcessingUnit *> by_cpu;
+  for (const ProcessingUnit &unit : m_units) {
+    by_cpu[unit.cpu] = &unit;
+  }
+
+  const std::vector<int> cpus = current_cpus();
+  std::map<int, std::set<int> > team_numa, team_l3;
+  out << "thread team cpu core NUMA L2 L3\n";
+  for (int thread = 0; thread < static_cast<int>(cpus.size()); ++thread) {
+    const int team = thread / threads_per_team;
+    out << thread << " " << team << " " << cpus[thread];
+    const auto unit = by_cpu.find(cpus[thread]);
+    if (unit == by_cpu.end()) {
+      out << " ? ? ? ?\n";
+      continue;
+    }
+    const ProcessingUnit &pu = *unit->second;
+    out << " " << pu.core << " " << pu.numa << " " << pu.l2 << " " << pu.l3
+        << "\n";
+    team_numa[team].insert(pu.numa);
+    team_l3[team].insert(pu.l3);
+  }
+
+  for (const auto &team : team_numa) {
+    if (team.second.size() > 1) {
+      out << "Warning! Team " << team.first << " spans "
+          << team.second.size() << " NUMA nodes\n";
+    }
+  }
+  for (const auto &team : team_l3) {
+    if (team.second.size() > 1) {
+      out << "Warning! Team " << team.first << " spans "
+          << team.second.size() << " L3 caches\n";
+    }
+  }
+#else
+  (void)out;
+  (void)threads_per_team;
+#endif // HOMMEXX_HOST_TOPOLOGY
+}
+
+} // namespace Homme
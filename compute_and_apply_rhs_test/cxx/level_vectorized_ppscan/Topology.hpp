@@ -0,0 +1,94 @@
+#ifndef HOMMEXX_TOPOLOGY_HPP
+#define HOMMEXX_TOPOLOGY_HPP
+
+#include "Types.hpp"
+
+#include <ostream>
+#include <vector>
+
+namespace Homme {
+
+// A hardware thread the execution space may run on. The cache domains are
+// ids shared by the processing units of the same cache (-1 if unknown)
+struct ProcessingUnit {
+  int cpu;
+  int core;
+  int numa;
+  int l2;
+  int l3;
+};
+
+// How the threads of the execution space are bound to the processing units
+enum class BindingPolicy {
+  // Leave them where Kokkos and the OpenMP runtime put them
+  NONE,
+  // A thread per core, the cores in the order of the topology, and the
+  // other hardware threads of the cores once all the cores have one
+  // (OMP_PROC_BIND=close with OMP_PLACES=cores)
+  COMPACT,
+  // As COMPACT, but dealing the threads round robin to the NUMA nodes
+  SCATTER,
+  // Each team on its own L2 domain (or L3, or NUMA node, if the team does
+  // not fit in one), so that its threads share the cache the sphere
+  // operators reuse
+  TEAM_PER_L2
+};
+
+const char *binding_policy_name(const BindingPolicy policy);
+
+// "none", "compact", "scatter" or "l2"; false if name is none of them
+bool parse_binding_policy(const char *name, BindingPolicy &policy);
+
+/* The processing units the threads of the execution space may run on (the
+ * union of their affinity masks), with their core, NUMA node and L2 and L3
+ * caches, from hwloc when built with USE_HWLOC and from sysfs otherwise.
+ * Create it after Kokkos::initialize, so that the threads exist.
+ *
+ * The topology may not be available (not Linux without hwloc, a GPU
+ * execution space): units() is then empty. */
+class Topology {
+public:
+  Topology();
+
+  bool available() const { return !m_units.empty(); }
+  const std::vector<ProcessingUnit> &units() const { return m_units; }
+  // "hwloc" or "sysfs"
+  const char *source() const { return m_source; }
+
+  int num_cores() const;
+  int num_numa_nodes() const;
+
+  // The unit (index in units()) of each of num_threads threads, thread t
+  // being in team t / threads_per_team, as the teams of a TeamPolicy are
+  std::vector<int> placement(const BindingPolicy policy,
+                             const int num_threads,
+                             const int threads_per_team) const;
+
+  // The cache level the teams of TEAM_PER_L2 are placed on
+  const char *team_domain(const int threads_per_team) const;
+
+  // Binds thread i of the execution space (the one running iteration i of a
+  // RangePolicy as long as its concurrency) to units()[placement[i]];
+  // false if a thread could not be bound
+  bool bind(const std::vector<int> &placement) const;
+
+  // A line per thread of the execution space with the cpu it runs on, its
+  // core, NUMA node and caches, and a warning for each team spread over
+  // several NUMA nodes or L3 caches
+  void print_thread_map(std::ostream &out, const int threads_per_team) const;
+
+private:
+  // The units of each domain of the level of the cache of TEAM_PER_L2, in
+  // compact order
+  std::vector<std::vector<int> > team_domains(const int threads_per_team,
+                                              const char *&level) const;
+  // The units in compact order
+  std::vector<int> compact_order(const std::vector<int> &units) const;
+
+  std::vector<ProcessingUnit> m_units;
+  const char *m_source;
+};
+
+} // namespace Homme
+
+#endif // HOMMEXX_TOPOLOGY_HPP
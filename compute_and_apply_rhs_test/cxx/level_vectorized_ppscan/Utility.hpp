@@ -3,6 +3,10 @@
 
 #include "Types.hpp"
 
+#if defined(__SSE2__) && !defined(__CUDA_ARCH__)
+#include <emmintrin.h>
+#endif
+
 #ifndef NDEBUG
 #define DEBUG_PRINT(...)                                                       \
   { printf(__VA_ARGS__); }
@@ -13,6 +17,72 @@
 
 namespace Homme {
 
+// Division by a per-level quantity (e.g. the pressure). Configuring with
+// HOMMEXX_FAST_RECIPROCAL turns this into a multiplication by a
+// Newton-refined reciprocal, which is cheaper than a packed division on
+// wide vectors but no longer bitwise identical to it.
+template <typename NumeratorType>
+KOKKOS_INLINE_FUNCTION Scalar divide(const NumeratorType &num,
+                                     const Scalar &den) {
+#ifdef HOMMEXX_FAST_RECIPROCAL
+  return num * reciprocal(den);
+#else
+  return num / den;
+#endif
+}
+
+// Stores value into dst, with a streaming (non-temporal) store if streaming
+// is set: it skips the read for ownership of the line and leaves the caches
+// to the next element. Only worth it for outputs nothing reads again soon,
+// and the thread must call streaming_store_fence before others read them
+KOKKOS_INLINE_FUNCTION void store_scalar(Scalar &dst, const Scalar &value,
+                                         const bool streaming) {
+  if (streaming) {
+    value.storeStreaming(&dst[0]);
+  } else {
+    dst = value;
+  }
+}
+
+// Orders the streaming stores of the thread before its later stores (the
+// ones of a barrier, in particular)
+KOKKOS_INLINE_FUNCTION void streaming_store_fence(const bool streaming) {
+#if defined(__SSE2__) && !defined(__CUDA_ARCH__)
+  if (streaming) {
+    _mm_sfence();
+  }
+#else
+  (void)streaming;
+#endif
+}
+
+// Software prefetch of the cache lines of [p, p + bytes) with the locality
+// of __builtin_prefetch: 3 keeps them in all the levels of the cache (T0),
+// 2 from the L2 (T1), 1 from the last level (T2), 0 is non temporal (NTA)
+template <int Locality>
+KOKKOS_INLINE_FUNCTION void prefetch_lines(const char *p, const size_t bytes) {
+#if defined(__GNUC__) && !defined(__CUDA_ARCH__)
+  constexpr size_t line_bytes = 64;
+  for (size_t offset = 0; offset < bytes; offset += line_bytes) {
+    __builtin_prefetch(p + offset, 0, Locality);
+  }
+#else
+  (void)p;
+  (void)bytes;
+#endif
+}
+
+KOKKOS_INLINE_FUNCTION void prefetch(const void *p, const size_t bytes,
+                                     const int locality) {
+  const char *line = static_cast<const char *>(p);
+  switch (locality) {
+  case 0: prefetch_lines<0>(line, bytes); break;
+  case 1: prefetch_lines<1>(line, bytes); break;
+  case 2: prefetch_lines<2>(line, bytes); break;
+  default: prefetch_lines<3>(line, bytes); break;
+  }
+}
+
 // ================ Subviews of 2d views ======================= //
 // Note: we still template on ScalarType (should always be Homme::Real here)
 //       to allow const/non-const version
@@ -182,11 +252,9 @@ sync_to_host(Source_T source, Dest_T dest) {
 
 template <typename Source_T, typename Dest_T>
 typename std::enable_if<
-    exec_view_mappable<Source_T,
-                       Scalar * [Q_NUM_TIME_LEVELS][QSIZE_D][NP][NP][NUM_LEV]>::
-        value &&host_view_mappable<
-            Dest_T, Real * [Q_NUM_TIME_LEVELS][QSIZE_D][NUM_PHYSICAL_LEV][NP]
-                                              [NP]>::value,
+    exec_view_mappable<Source_T, Scalar *** [NP][NP][NUM_LEV]>::value &&
+        host_view_mappable<
+            Dest_T, Real *** [NUM_PHYSICAL_LEV][NP][NP]>::value,
     void>::type
 sync_to_host(Source_T source, Dest_T dest) {
   typename Source_T::HostMirror source_mirror(
@@ -194,7 +262,7 @@ sync_to_host(Source_T source, Dest_T dest) {
   Kokkos::deep_copy(source_mirror, source);
   for (int ie = 0; ie < source.extent_int(0); ++ie) {
     for (int time = 0; time < Q_NUM_TIME_LEVELS; ++time) {
-      for (int tracer = 0; tracer < QSIZE_D; ++tracer) {
+      for (int tracer = 0; tracer < source.extent_int(2); ++tracer) {
         for (int vector_level = 0, level = 0; vector_level < NUM_LEV;
              ++vector_level) {
           for (int vector = 0; vector < VECTOR_SIZE; ++vector, ++level) {
@@ -0,0 +1,339 @@
+#include "Types.hpp"
+#include "Control.hpp"
+#include "Elements.hpp"
+#include "Derivative.hpp"
+#include "CubedSphere.hpp"
+#include "KernelVariables.hpp"
+#include "CaarFunctor.hpp"
+#include "EulerStepFunctor.hpp"
+
+#include "profiling.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <chrono>
+#include <type_traits>
+
+using namespace Homme;
+
+using clock_type = std::chrono::high_resolution_clock;
+using ns = std::chrono::nanoseconds;
+
+// CAAR of a step, followed by the vstar its tracers are advected with
+struct CaarVstarFunctor {
+  const CaarFunctor m_caar;
+  const EulerStepFunctor m_euler_step;
+
+  CaarVstarFunctor(const Control &data, const Elements &elements,
+                   const Derivative &deriv)
+      : m_caar(data, elements, deriv), m_euler_step(data, elements, deriv) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const TeamMember &team) const {
+    start_timer("caar compute");
+    KernelVariables kv(team, m_caar.m_data.nets);
+    m_caar.compute(kv);
+    kv.team_barrier();
+    m_euler_step.compute_vstar(kv);
+    stop_timer("caar compute");
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  size_t shmem_size(const int team_size) const {
+    return KernelVariables::shmem_size(team_size);
+  }
+};
+
+// The tracer update of a step, from its vstar
+struct TracerFunctor {
+  const EulerStepFunctor m_euler_step;
+
+  TracerFunctor(const Control &data, const Elements &elements,
+                const Derivative &deriv)
+      : m_euler_step(data, elements, deriv) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const TeamMember &team) const {
+    start_timer("tracer compute");
+    KernelVariables kv(team, m_euler_step.m_data.nets);
+    m_euler_step.compute_tracers(kv);
+    stop_timer("tracer compute");
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  size_t shmem_size(const int team_size) const {
+    return KernelVariables::shmem_size(team_size);
+  }
+};
+
+// Runs f(partition, num_partitions) on num_partitions disjoint sets of
+// partition_size threads of the pool at the same time. Execution spaces
+// that cannot be partitioned run the partitions one after the other
+template <typename Functor>
+void run_partitioned(const Functor &f, const int num_partitions,
+                     const int partition_size) {
+#ifdef KOKKOS_ENABLE_OPENMP
+  if (std::is_same<ExecSpace, Kokkos::OpenMP>::value) {
+    Kokkos::OpenMP::partition_master(f, num_partitions, partition_size);
+    return;
+  }
+#endif
+  for (int partition = 0; partition < num_partitions; ++partition) {
+    f(partition, num_partitions);
+  }
+}
+
+static bool can_partition() {
+#ifdef KOKKOS_ENABLE_OPENMP
+  return std::is_same<ExecSpace, Kokkos::OpenMP>::value;
+#else
+  return false;
+#endif
+}
+
+// The elements [nets, nete) of chunk i of num_chunks
+static void chunk_range(const int num_elems, const int i,
+                        const int num_chunks, Control &data) {
+  data.nets = static_cast<long>(num_elems) * i / num_chunks;
+  data.nete = static_cast<long>(num_elems) * (i + 1) / num_chunks;
+}
+
+// CAAR and the tracers of the previous step at the same time, on disjoint
+// partitions of the thread pool: when there are fewer elements than threads,
+// a single kernel leaves most of the cores idle. The tracers of step n only
+// need the vstar of step n, which is double buffered, so they do not race
+// with the CAAR of step n + 1. The number of partitions given to CAAR is
+// autotuned, unless it is given
+int main(int argc, char **argv) {
+  constexpr int tstep = 600;
+
+  Kokkos::initialize();
+  ExecSpace::print_configuration(std::cout, true);
+  GPTLinitialize();
+
+  constexpr int threads_per_team = 4;
+  constexpr int vectors_per_thread = 1;
+
+  int ne = 2;
+  if (argc > 1) {
+    ne = atoi(argv[1]);
+  }
+
+  constexpr int seconds_per_day = 24 * 3600;
+  constexpr int rk_stages = 5;
+  int num_exec = (seconds_per_day / tstep) * rk_stages;
+  if (argc > 2) {
+    num_exec = atoi(argv[2]);
+  }
+
+  int qsize = QSIZE_D;
+  if (argc > 3) {
+    qsize = atoi(argv[3]);
+  }
+  if (qsize < 0 || qsize > QSIZE_D) {
+    std::cerr << "qsize must be between 0 and QSIZE_D=" << QSIZE_D << "\n";
+    Kokkos::finalize();
+    return 1;
+  }
+
+  Control data;
+  data.nm1 = 0;
+  data.n0 = 1;
+  data.np1 = 2;
+  data.qn0 = -1;
+  data.n0_qdp = 0;
+  data.np1_qdp = 1;
+  data.dt = tstep;
+  data.eta_ave_w = 1.0;
+  data.compute_diagonstics = 0;
+  data.qsize = qsize;
+  data.rsplit = 1;
+  if (argc > 4) {
+    data.rsplit = atoi(argv[4]);
+  }
+
+  int num_elems = 6 * ne * ne;
+  if (argc > 5) {
+    num_elems = atoi(argv[5]);
+  }
+  if (num_elems < 1 || num_elems > 6 * ne * ne) {
+    std::cerr << "A cubed sphere with ne=" << ne << " only has "
+              << 6 * ne * ne << " elements\n";
+    Kokkos::finalize();
+    return 1;
+  }
+
+  // A partition per team; CAAR gets caar_partitions of them, the tracers the
+  // others
+  const int num_partitions =
+      std::max(ExecSpace::concurrency() / threads_per_team, 2);
+  const int partition_size =
+      std::max(ExecSpace::concurrency() / num_partitions, 1);
+  const int team_size = std::min(threads_per_team, partition_size);
+
+  int caar_partitions = 0;
+  if (argc > 6) {
+    caar_partitions = atoi(argv[6]);
+  }
+  if (caar_partitions < 0 || caar_partitions >= num_partitions) {
+    std::cerr << "CAAR gets 1 to " << num_partitions - 1
+              << " partitions, or 0 to autotune\n";
+    Kokkos::finalize();
+    return 1;
+  }
+
+  data.num_elems = num_elems;
+  data.nets = 0;
+  data.nete = num_elems;
+
+  CubedSphere mesh(ne);
+  mesh.init_state(num_elems);
+
+  Derivative deriv;
+  deriv.init(mesh.m_dvv.data());
+
+  Elements elem;
+  elem.init(num_elems, qsize);
+  elem.init_2d(mesh.m_d.data(), mesh.m_dinv.data(), mesh.m_fcor.data(),
+               mesh.m_spheremp.data(), mesh.m_metdet.data(),
+               mesh.m_phis.data());
+  elem.pull_from_f90_pointers(
+      mesh.m_state_v.data(), mesh.m_state_t.data(), mesh.m_state_dp3d.data(),
+      mesh.m_derived_phi.data(), mesh.m_derived_pecnd.data(),
+      mesh.m_derived_omega_p.data(), mesh.m_derived_v.data(),
+      mesh.m_derived_eta_dot_dpdn.data(), mesh.m_state_qdp.data());
+
+  data.ps0 = mesh.m_ps0;
+  data.hybrid_a = ExecViewManaged<Real[NUM_LEV_P]>(
+      "Hybrid coordinates; translates between pressure and velocity");
+  ExecViewManaged<Real[NUM_LEV_P]>::HostMirror h_hybrid_a =
+      Kokkos::create_mirror_view(data.hybrid_a);
+  for (int i = 0; i < NUM_LEV_P; ++i) {
+    h_hybrid_a(i) = mesh.m_hybrid_a[i];
+  }
+  Kokkos::deep_copy(data.hybrid_a, h_hybrid_a);
+
+  data.hybrid_b =
+      ExecViewManaged<Scalar[NUM_LEV_P]>("Hybrid b at the interfaces");
+  ExecViewManaged<Scalar[NUM_LEV_P]>::HostMirror h_hybrid_b =
+      Kokkos::create_mirror_view(data.hybrid_b);
+  for (int ilevel = 0; ilevel < NUM_INTERFACE_LEV; ++ilevel) {
+    h_hybrid_b(ilevel / VECTOR_SIZE)[ilevel % VECTOR_SIZE] =
+        static_cast<Real>(ilevel) / NUM_PHYSICAL_LEV;
+  }
+  Kokkos::deep_copy(data.hybrid_b, h_hybrid_b);
+
+  // The elements seen by CAAR and by the tracers of a step of each parity:
+  // the same views, except for vstar (one per parity) and the divergence
+  // buffer of the tracers, which CAAR also uses
+  Elements caar_elem[2] = { elem, elem };
+  caar_elem[1].buffers.vstar =
+      ExecViewManaged<Scalar * [2][NP][NP][NUM_LEV]>("buffer for v/dp",
+                                                      num_elems);
+  Elements tracer_elem[2] = { caar_elem[0], caar_elem[1] };
+  const ExecViewManaged<Scalar * [2][NP][NP][NUM_LEV]> tracer_div_buf(
+      "buffer for the tracer divergence", num_elems);
+  for (int parity = 0; parity < 2; ++parity) {
+    tracer_elem[parity].buffers.div_buf = tracer_div_buf;
+  }
+
+  // CAAR of step n on caar_parts partitions and the tracers of step n - 1 on
+  // the others, or both after one another on the whole pool if caar_parts
+  // is 0
+  auto run_step = [&](const int exec, const int caar_parts) {
+    const int parity = exec % 2;
+    if (caar_parts == 0) {
+      Kokkos::TeamPolicy<ExecSpace> policy(num_elems, threads_per_team,
+                                           vectors_per_thread);
+      policy.set_chunk_size(1);
+      Kokkos::parallel_for(
+          policy, CaarVstarFunctor(data, caar_elem[parity], deriv));
+      ExecSpace::fence();
+      Kokkos::parallel_for(
+          policy, TracerFunctor(data, tracer_elem[1 - parity], deriv));
+      ExecSpace::fence();
+      return;
+    }
+    run_partitioned([&](const int partition, const int partitions) {
+      Control part_data = data;
+      const bool caar = partition < caar_parts;
+      if (caar) {
+        chunk_range(num_elems, partition, caar_parts, part_data);
+      } else {
+        chunk_range(num_elems, partition - caar_parts,
+                    partitions - caar_parts, part_data);
+      }
+      if (part_data.nete <= part_data.nets) {
+        return;
+      }
+      Kokkos::TeamPolicy<ExecSpace> policy(part_data.nete - part_data.nets,
+                                           team_size, vectors_per_thread);
+      policy.set_chunk_size(1);
+      if (caar) {
+        Kokkos::parallel_for(
+            policy, CaarVstarFunctor(part_data, caar_elem[parity], deriv));
+      } else {
+        Kokkos::parallel_for(
+            policy, TracerFunctor(part_data, tracer_elem[1 - parity], deriv));
+      }
+      ExecSpace::fence();
+    }, num_partitions, partition_size);
+  };
+
+  // Steps keep alternating parities across the calls
+  int exec = 0;
+  auto time_steps = [&](const int steps, const int caar_parts) {
+    ExecSpace::fence();
+    auto start = clock_type::now();
+    for (int step = 0; step < steps; ++step, ++exec) {
+      run_step(exec, caar_parts);
+    }
+    return std::chrono::duration_cast<ns>(clock_type::now() - start).count();
+  };
+
+  {
+    // Step -1 only computes the vstar of the first tracers
+    Kokkos::TeamPolicy<ExecSpace> policy(num_elems, threads_per_team,
+                                         vectors_per_thread);
+    Kokkos::parallel_for(policy,
+                         CaarVstarFunctor(data, caar_elem[1], deriv));
+    ExecSpace::fence();
+
+    if (!can_partition()) {
+      std::cout << "This execution space cannot be partitioned; CAAR and "
+                   "the tracers run one after the other\n";
+    } else if (caar_partitions == 0) {
+      // The fastest split over a few steps
+      constexpr int tune_steps = 4;
+      long best_count = 0;
+      for (int parts = 1; parts < num_partitions; ++parts) {
+        const long count = time_steps(tune_steps, parts);
+        if (caar_partitions == 0 || count < best_count) {
+          caar_partitions = parts;
+          best_count = count;
+        }
+      }
+      std::cout << "Autotuned split: " << caar_partitions << " of "
+                << num_partitions << " partitions of " << partition_size
+                << " threads for CAAR\n";
+    }
+
+    start_timer("serialized");
+    const long serial_count = time_steps(num_exec, 0);
+    stop_timer("serialized");
+    start_timer("concurrent");
+    const long concurrent_count = time_steps(num_exec, caar_partitions);
+    stop_timer("concurrent");
+
+    std::cout << "Seconds " << serial_count * 1e-9 << " (serialized) vs "
+              << concurrent_count * 1e-9 << " (concurrent, "
+              << caar_partitions << " of " << num_partitions
+              << " partitions for CAAR) to evaluate " << num_elems
+              << " elements and " << qsize << " tracers " << num_exec
+              << " times with rsplit " << data.rsplit << "\n";
+  }
+
+  Kokkos::finalize();
+  GPTLpr_summary_file(0, "Timing.dat");
+  return 0;
+}
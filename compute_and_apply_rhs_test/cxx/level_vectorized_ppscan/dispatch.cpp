@@ -0,0 +1,160 @@
+
+#include "registry.h.c"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Entry points of the pre-built variants of the benchmark (see the
+// HOMMEXX_MULTI_ISA/HOMMEXX_DIMENSIONS section of CMakeLists.txt). All other
+// symbols of those objects are made local, so each variant keeps its own
+// copies of the kernels, of the Vector instantiations and of the Elements
+// layout (NUM_LEV, NP, QSIZE_D), all with compile time extents.
+
+// The widest pack (in doubles) the CPU and the OS can execute
+int widest_supported_vector_size() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return 8;
+  }
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return 4;
+  }
+#endif
+  return 1;
+}
+
+// The dimensions requested by the user. -1 matches any pre-built value
+struct Dimensions {
+  int plev = -1;
+  int np = -1;
+  int qsize = -1;
+};
+
+bool set_dimension(const std::string &key, const int value, Dimensions &dims) {
+  if (key == "plev") {
+    dims.plev = value;
+  } else if (key == "np") {
+    dims.np = value;
+  } else if (key == "qsize") {
+    dims.qsize = value;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// Input file with one 'key = value' per line, '#' starting a comment
+bool read_dimensions(const char *file_name, Dimensions &dims) {
+  std::ifstream input(file_name);
+  if (!input) {
+    std::cerr << "Could not open " << file_name << "\n";
+    return false;
+  }
+  std::string line;
+  while (std::getline(input, line)) {
+    line = line.substr(0, line.find('#'));
+    const size_t eq = line.find('=');
+    if (eq == std::string::npos) {
+      continue;
+    }
+    std::string key;
+    std::istringstream(line.substr(0, eq)) >> key;
+    if (!set_dimension(key, std::atoi(line.c_str() + eq + 1), dims)) {
+      std::cerr << "Unknown key '" << key << "' in " << file_name << "\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+void print_variants() {
+  std::cerr << "Available variants (vector size, PLEV, NP, QSIZE_D):\n";
+  for (const KernelVariant &variant : kernel_variants) {
+    std::cerr << "  " << variant.vector_size << " " << variant.plev << " "
+              << variant.np << " " << variant.qsize << "\n";
+  }
+}
+
+int main(int argc, char **argv) {
+  // Strip the dimension options; the remaining arguments are forwarded
+  // to the benchmark (number of elements, number of executions, tracers,
+  // rsplit, cubed sphere ne)
+  Dimensions dims;
+  std::vector<char *> args(1, argv[0]);
+  for (int iarg = 1; iarg < argc; ++iarg) {
+    const std::string arg(argv[iarg]);
+    const size_t eq = arg.find('=');
+    if (arg.compare(0, 2, "--") != 0 || eq == std::string::npos) {
+      args.push_back(argv[iarg]);
+    } else if (arg.compare(2, eq - 2, "input") == 0) {
+      if (!read_dimensions(argv[iarg] + eq + 1, dims)) {
+        return 1;
+      }
+    } else if (!set_dimension(arg.substr(2, eq - 2),
+                              std::atoi(argv[iarg] + eq + 1), dims)) {
+      std::cerr << "Unknown option " << arg << "\n"
+                << "Usage: " << argv[0] << " [--plev=N] [--np=N] [--qsize=N]"
+                << " [--input=file] [num_elems] [num_exec] [qsize] [rsplit]"
+                << " [ne]\n";
+      return 1;
+    }
+  }
+  args.push_back(nullptr);
+
+  const int supported = widest_supported_vector_size();
+  int max_vector_size = supported;
+
+  // Allow forcing a narrower pack, e.g. to compare widths on the same node
+  const char *requested = std::getenv("HOMMEXX_VECTOR_SIZE");
+  if (requested != nullptr && *requested != '\0') {
+    const int size = std::atoi(requested);
+    if ((size == 1 || size == 4 || size == 8) && size <= supported) {
+      max_vector_size = size;
+    } else {
+      std::cerr << "Ignoring HOMMEXX_VECTOR_SIZE=" << requested
+                << ": valid values are 1, 4 and 8, up to " << supported
+                << " on this CPU\n";
+    }
+  }
+
+  // The first dimensions (in HOMMEXX_DIMENSIONS order) matching the request,
+  // with the widest pack that can run here
+  const KernelVariant *selected = nullptr;
+  for (const KernelVariant &variant : kernel_variants) {
+    if ((dims.plev >= 0 && variant.plev != dims.plev) ||
+        (dims.np >= 0 && variant.np != dims.np) ||
+        (dims.qsize >= 0 && variant.qsize != dims.qsize) ||
+        variant.vector_size > max_vector_size) {
+      continue;
+    }
+    if (selected == nullptr) {
+      selected = &variant;
+    } else if (variant.plev == selected->plev && variant.np == selected->np &&
+               variant.qsize == selected->qsize &&
+               variant.vector_size > selected->vector_size) {
+      selected = &variant;
+    }
+  }
+  if (selected == nullptr) {
+    std::cerr << "No variant with the requested dimensions and at most "
+              << max_vector_size << " doubles per pack was built\n";
+    print_variants();
+    return 1;
+  }
+
+  std::cout << "Running PLEV=" << selected->plev << ", NP=" << selected->np
+            << ", QSIZE_D=" << selected->qsize << " with ";
+  if (selected->vector_size > 0) {
+    std::cout << selected->vector_size << " doubles per pack (" << supported
+              << " supported)\n";
+  } else {
+    std::cout << "the configured pack width\n";
+  }
+
+  return selected->run(static_cast<int>(args.size()) - 1, args.data());
+}
@@ -0,0 +1,218 @@
+#include "Types.hpp"
+#include "Control.hpp"
+#include "Elements.hpp"
+#include "Derivative.hpp"
+#include "CubedSphere.hpp"
+#include "CaarFunctor.hpp"
+#include "Dss.hpp"
+#include "CacheMissCounter.hpp"
+
+#include "profiling.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <chrono>
+
+using namespace Homme;
+
+using clock_type = std::chrono::high_resolution_clock;
+using ns = std::chrono::nanoseconds;
+
+// Times CAAR, the DSS of its output and both together on a cubed sphere,
+// i.e. the cost of one RK stage of the dynamics per process, with the
+// elements stored in the given order (see CubedSphere::Ordering)
+int main(int argc, char **argv) {
+  constexpr int tstep = 600;
+
+  Kokkos::initialize();
+  ExecSpace::print_configuration(std::cout, true);
+  GPTLinitialize();
+
+  constexpr int threads_per_team = 4;
+  constexpr int vectors_per_thread = 1;
+
+  int ne = 4;
+  if (argc > 1) {
+    ne = atoi(argv[1]);
+  }
+
+  constexpr int seconds_per_day = 24 * 3600;
+  constexpr int rk_stages = 5;
+  int num_exec = (seconds_per_day / tstep) * rk_stages;
+  if (argc > 2) {
+    num_exec = atoi(argv[2]);
+  }
+
+  int qsize = QSIZE_D;
+  if (argc > 3) {
+    qsize = atoi(argv[3]);
+  }
+  if (qsize < 0 || qsize > QSIZE_D) {
+    std::cerr << "qsize must be between 0 and QSIZE_D=" << QSIZE_D << "\n";
+    Kokkos::finalize();
+    return 1;
+  }
+
+  Control data;
+  data.nm1 = 0;
+  data.n0 = 1;
+  data.np1 = 2;
+  data.qn0 = -1;
+  data.dt = tstep;
+  data.eta_ave_w = 1.0;
+  data.compute_diagonstics = 0;
+  data.qsize = qsize;
+  data.rsplit = 1;
+  if (argc > 4) {
+    data.rsplit = atoi(argv[4]);
+  }
+
+  // All the elements of the sphere by default, or the first num_elems ones
+  // of the ordering (the DSS then only assembles the contributions of those)
+  int num_elems = 6 * ne * ne;
+  if (argc > 5) {
+    num_elems = atoi(argv[5]);
+  }
+  if (num_elems > 6 * ne * ne) {
+    std::cerr << "A cubed sphere with ne=" << ne << " only has "
+              << 6 * ne * ne << " elements\n";
+    Kokkos::finalize();
+    return 1;
+  }
+
+  CubedSphere::Ordering ordering = CubedSphere::ROW_MAJOR;
+  if (argc > 6) {
+    ordering = static_cast<CubedSphere::Ordering>(atoi(argv[6]));
+  }
+  if (ordering < 0 || ordering >= CubedSphere::NUM_ORDERINGS) {
+    std::cerr << "The ordering is 0 (row major), 1 (Morton), 2 (Hilbert) or "
+                 "3 (random)\n";
+    Kokkos::finalize();
+    return 1;
+  }
+
+  // CAAR runs on the elements [nets, nete)
+  data.num_elems = num_elems;
+  data.nets = 0;
+  data.nete = num_elems;
+
+  CubedSphere mesh(ne);
+  std::vector<int> elems = mesh.ordered_elements(ordering);
+  elems.resize(num_elems);
+
+  // The elements are loaded in the order of the mesh, as from F90, and then
+  // permuted into the requested order
+  std::vector<int> mesh_elems = elems;
+  std::sort(mesh_elems.begin(), mesh_elems.end());
+  mesh.init_state(mesh_elems);
+
+  Derivative deriv;
+  deriv.init(mesh.m_dvv.data());
+
+  Elements elem;
+  ElementsStorage storage;
+  elem.init(num_elems, qsize);
+  elem.init_2d(mesh.gather(mesh.m_d, mesh_elems).data(),
+               mesh.gather(mesh.m_dinv, mesh_elems).data(),
+               mesh.gather(mesh.m_fcor, mesh_elems).data(),
+               mesh.gather(mesh.m_spheremp, mesh_elems).data(),
+               mesh.gather(mesh.m_metdet, mesh_elems).data(),
+               mesh.gather(mesh.m_phis, mesh_elems).data());
+  elem.pull_from_f90_pointers(
+      mesh.m_state_v.data(), mesh.m_state_t.data(), mesh.m_state_dp3d.data(),
+      mesh.m_derived_phi.data(), mesh.m_derived_pecnd.data(),
+      mesh.m_derived_omega_p.data(), mesh.m_derived_v.data(),
+      mesh.m_derived_eta_dot_dpdn.data(), mesh.m_state_qdp.data());
+
+  std::vector<int> order(num_elems);
+  for (int ie = 0; ie < num_elems; ++ie) {
+    order[ie] = std::lower_bound(mesh_elems.begin(), mesh_elems.end(),
+                                 elems[ie]) -
+                mesh_elems.begin();
+  }
+  elem.reorder(order, storage);
+
+  data.ps0 = mesh.m_ps0;
+  data.hybrid_a = ExecViewManaged<Real[NUM_LEV_P]>(
+      "Hybrid coordinates; translates between pressure and velocity");
+  ExecViewManaged<Real[NUM_LEV_P]>::HostMirror h_hybrid_a =
+      Kokkos::create_mirror_view(data.hybrid_a);
+  for (int i = 0; i < NUM_LEV_P; ++i) {
+    h_hybrid_a(i) = mesh.m_hybrid_a[i];
+  }
+  Kokkos::deep_copy(data.hybrid_a, h_hybrid_a);
+
+  data.hybrid_b =
+      ExecViewManaged<Scalar[NUM_LEV_P]>("Hybrid b at the interfaces");
+  ExecViewManaged<Scalar[NUM_LEV_P]>::HostMirror h_hybrid_b =
+      Kokkos::create_mirror_view(data.hybrid_b);
+  for (int ilevel = 0; ilevel < NUM_INTERFACE_LEV; ++ilevel) {
+    h_hybrid_b(ilevel / VECTOR_SIZE)[ilevel % VECTOR_SIZE] =
+        static_cast<Real>(ilevel) / NUM_PHYSICAL_LEV;
+  }
+  Kokkos::deep_copy(data.hybrid_b, h_hybrid_b);
+
+  Dss dss;
+  dss.init(mesh, elem, elems);
+
+  CaarFunctor func(data, elem, deriv);
+
+  {
+    // Each team gets a contiguous segment of the ordering
+    Kokkos::TeamPolicy<ExecSpace> policy(data.nete - data.nets,
+                                         threads_per_team, vectors_per_thread);
+    const int num_teams =
+        std::max(ExecSpace::concurrency() / threads_per_team, 1);
+    policy.set_chunk_size((num_elems + num_teams - 1) / num_teams);
+
+    CacheMissCounter cache_misses;
+
+    clock_type::duration caar_time = clock_type::duration::zero();
+    clock_type::duration dss_time = clock_type::duration::zero();
+
+    cache_misses.start();
+    for (int exec = 0; exec < num_exec; ++exec) {
+      ExecSpace::fence();
+      auto start = clock_type::now();
+      start_timer("caar");
+      Kokkos::parallel_for(policy, func);
+      ExecSpace::fence();
+      stop_timer("caar");
+      auto middle = clock_type::now();
+      start_timer("dss");
+      // The tracers are assembled too, as after each Euler step
+      dss.exchange(elem, data.np1, 0);
+      stop_timer("dss");
+      auto end = clock_type::now();
+      caar_time += middle - start;
+      dss_time += end - middle;
+    }
+    cache_misses.stop();
+
+    const auto caar_count = std::chrono::duration_cast<ns>(caar_time).count();
+    const auto dss_count = std::chrono::duration_cast<ns>(dss_time).count();
+    std::cout << "Seconds " << caar_count * 1e-9 << " (CAAR) + "
+              << dss_count * 1e-9 << " (DSS) = "
+              << (caar_count + dss_count) * 1e-9 << " to evaluate "
+              << num_elems << " elements " << num_exec
+              << " times with rsplit " << data.rsplit << "\n";
+    std::cout << "Seconds per step " << (caar_count + dss_count) * 1e-9 /
+                                            num_exec
+              << " (DSS " << 100.0 * dss_count / (caar_count + dss_count)
+              << "%)\n";
+    if (cache_misses.available()) {
+      std::cout << "Last level cache miss rate " << cache_misses.miss_rate()
+                << " (" << static_cast<double>(cache_misses.misses()) /
+                               (num_exec * num_elems)
+                << " misses per element per step) with ordering "
+                << ordering << "\n";
+    } else {
+      std::cout << "Cache counters unavailable with ordering " << ordering
+                << "\n";
+    }
+  }
+
+  Kokkos::finalize();
+  GPTLpr_summary_file(0, "Timing.dat");
+  return 0;
+}
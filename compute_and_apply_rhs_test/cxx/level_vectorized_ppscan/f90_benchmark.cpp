@@ -0,0 +1,221 @@
+#include "Types.hpp"
+#include "Control.hpp"
+#include "Elements.hpp"
+#include "Derivative.hpp"
+#include "CaarFunctor.hpp"
+
+#include "profiling.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <chrono>
+#include <vector>
+
+using namespace Homme;
+
+using clock_type = std::chrono::high_resolution_clock;
+using ns = std::chrono::nanoseconds;
+
+// The original Fortran compute_and_apply_rhs (fortran/caar_bridge.F90)
+extern "C" {
+void caar_f90_dimensions(int *np, int *nlev, int *qsize_d);
+void caar_f90_time_levels(int *np1, int *nm1, int *n0, int *qn0);
+void caar_f90_init(int num_elems);
+void caar_f90_finalize();
+void caar_f90_run(int num_exec);
+void caar_f90_pull_2d(F90Ptr dvv, F90Ptr hybrid_a, F90Ptr ps0, F90Ptr d,
+                      F90Ptr dinv, F90Ptr fcor, F90Ptr spheremp,
+                      F90Ptr metdet, F90Ptr phis);
+void caar_f90_pull_state(F90Ptr state_v, F90Ptr state_t, F90Ptr state_dp3d,
+                         F90Ptr derived_phi, F90Ptr derived_pecnd,
+                         F90Ptr derived_omega_p, F90Ptr derived_v,
+                         F90Ptr derived_eta_dot_dpdn, F90Ptr state_qdp,
+                         int num_q, int num_q_tl);
+}
+
+// The fields of the F90 state, in the memory of the F90 arrays
+struct F90State {
+  explicit F90State(const int num_elems)
+      : v(num_elems * NUM_TIME_LEVELS * NUM_PHYSICAL_LEV * 2 * NP * NP),
+        t(num_elems * NUM_TIME_LEVELS * NUM_PHYSICAL_LEV * NP * NP),
+        dp3d(num_elems * NUM_TIME_LEVELS * NUM_PHYSICAL_LEV * NP * NP),
+        phi(num_elems * NUM_PHYSICAL_LEV * NP * NP),
+        pecnd(num_elems * NUM_PHYSICAL_LEV * NP * NP),
+        omega_p(num_elems * NUM_PHYSICAL_LEV * NP * NP),
+        vn0(num_elems * NUM_PHYSICAL_LEV * 2 * NP * NP),
+        eta_dot_dpdn(num_elems * NUM_INTERFACE_LEV * NP * NP),
+        qdp(num_elems * Q_NUM_TIME_LEVELS * QSIZE_D * NUM_PHYSICAL_LEV * NP *
+            NP) {}
+
+  void pull_from_f90() {
+    caar_f90_pull_state(v.data(), t.data(), dp3d.data(), phi.data(),
+                        pecnd.data(), omega_p.data(), vn0.data(),
+                        eta_dot_dpdn.data(), qdp.data(), QSIZE_D,
+                        Q_NUM_TIME_LEVELS);
+  }
+
+  void push_to(Elements &elem) const {
+    elem.pull_from_f90_pointers(v.data(), t.data(), dp3d.data(), phi.data(),
+                                pecnd.data(), omega_p.data(), vn0.data(),
+                                eta_dot_dpdn.data(), qdp.data());
+  }
+
+  void pull_from(const Elements &elem) {
+    elem.push_to_f90_pointers(v.data(), t.data(), dp3d.data(), phi.data(),
+                              pecnd.data(), omega_p.data(), vn0.data(),
+                              eta_dot_dpdn.data(), qdp.data());
+  }
+
+  std::vector<Real> v, t, dp3d, phi, pecnd, omega_p, vn0, eta_dot_dpdn, qdp;
+};
+
+// Largest difference between the two, relative to the largest value of
+// expected
+static Real max_rel_diff(const std::vector<Real> &computed,
+                         const std::vector<Real> &expected) {
+  Real max_diff = 0, max_value = 0;
+  for (size_t i = 0; i < expected.size(); ++i) {
+    max_diff = std::max(max_diff, std::abs(computed[i] - expected[i]));
+    max_value = std::max(max_value, std::abs(expected[i]));
+  }
+  return max_value > 0 ? max_diff / max_value : max_diff;
+}
+
+// The original Fortran CAAR and the C++ one back to back on the same elements
+// in the same process: both start from the initial state of the Fortran
+// benchmark, so that the timings only differ by the implementations, and
+// their outputs are compared
+int main(int argc, char **argv) {
+  Kokkos::initialize();
+  ExecSpace::print_configuration(std::cout, true);
+  GPTLinitialize();
+
+  constexpr int threads_per_team = 4;
+  constexpr int vectors_per_thread = 1;
+
+  int num_elems = 32;
+  if (argc > 1) {
+    num_elems = atoi(argv[1]);
+  }
+
+  int num_exec = 100;
+  if (argc > 2) {
+    num_exec = atoi(argv[2]);
+  }
+
+  int f90_np, f90_nlev, f90_qsize_d;
+  caar_f90_dimensions(&f90_np, &f90_nlev, &f90_qsize_d);
+  if (f90_np != NP || f90_nlev != NUM_PHYSICAL_LEV || f90_qsize_d > QSIZE_D) {
+    std::cerr << "The Fortran version is built for np=" << f90_np
+              << ", nlev=" << f90_nlev << " and qsize_d=" << f90_qsize_d
+              << ", the C++ one for np=" << NP << ", nlev="
+              << NUM_PHYSICAL_LEV << " and qsize_d=" << QSIZE_D << "\n";
+    Kokkos::finalize();
+    return 1;
+  }
+  if (num_elems < 1) {
+    std::cerr << "At least one element is needed\n";
+    Kokkos::finalize();
+    return 1;
+  }
+
+  // Moist, with the single tracer of the Fortran state, and vertically
+  // Lagrangian like the Fortran version
+  Control data;
+  caar_f90_time_levels(&data.np1, &data.nm1, &data.n0, &data.qn0);
+  data.dt = 1.0;
+  data.eta_ave_w = 1.0;
+  data.compute_diagonstics = 0;
+  data.qsize = f90_qsize_d;
+  data.rsplit = 1;
+  data.num_elems = num_elems;
+  data.nets = 0;
+  data.nete = num_elems;
+
+  caar_f90_init(num_elems);
+
+  Derivative deriv;
+  Elements elem;
+  F90State f90_state(num_elems);
+  {
+    std::vector<Real> dvv(NP * NP), hybrid_a(NUM_INTERFACE_LEV);
+    std::vector<Real> d(num_elems * 2 * 2 * NP * NP);
+    std::vector<Real> dinv(num_elems * 2 * 2 * NP * NP);
+    std::vector<Real> fcor(num_elems * NP * NP);
+    std::vector<Real> spheremp(num_elems * NP * NP);
+    std::vector<Real> metdet(num_elems * NP * NP);
+    std::vector<Real> phis(num_elems * NP * NP);
+    Real ps0;
+    caar_f90_pull_2d(dvv.data(), hybrid_a.data(), &ps0, d.data(), dinv.data(),
+                     fcor.data(), spheremp.data(), metdet.data(),
+                     phis.data());
+
+    deriv.init(dvv.data());
+    elem.init(num_elems, data.qsize);
+    elem.init_2d(d.data(), dinv.data(), fcor.data(), spheremp.data(),
+                 metdet.data(), phis.data());
+    f90_state.pull_from_f90();
+    f90_state.push_to(elem);
+
+    data.ps0 = ps0;
+    data.hybrid_a = ExecViewManaged<Real[NUM_LEV_P]>(
+        "Hybrid coordinates; translates between pressure and velocity");
+    ExecViewManaged<Real[NUM_LEV_P]>::HostMirror h_hybrid_a =
+        Kokkos::create_mirror_view(data.hybrid_a);
+    for (int i = 0; i < NUM_LEV_P; ++i) {
+      h_hybrid_a(i) = hybrid_a[i];
+    }
+    Kokkos::deep_copy(data.hybrid_a, h_hybrid_a);
+  }
+
+  {
+    start_timer("fortran");
+    auto start = clock_type::now();
+    caar_f90_run(num_exec);
+    auto end = clock_type::now();
+    stop_timer("fortran");
+    const double f90_seconds =
+        std::chrono::duration_cast<ns>(end - start).count() * 1e-9;
+
+    Kokkos::TeamPolicy<ExecSpace> policy(num_elems, threads_per_team,
+                                         vectors_per_thread);
+    policy.set_chunk_size(1);
+    const CaarFunctor func(data, elem, deriv);
+    ExecSpace::fence();
+    start_timer("cxx");
+    start = clock_type::now();
+    for (int i = 0; i < num_exec; ++i) {
+      Kokkos::parallel_for(policy, func);
+      ExecSpace::fence();
+    }
+    end = clock_type::now();
+    stop_timer("cxx");
+    const double cxx_seconds =
+        std::chrono::duration_cast<ns>(end - start).count() * 1e-9;
+
+    std::cout << "Seconds " << f90_seconds << " (Fortran) vs " << cxx_seconds
+              << " (C++) to evaluate " << num_elems << " elements "
+              << num_exec << " times\n";
+
+    F90State cxx_state(num_elems);
+    cxx_state.pull_from(elem);
+    f90_state.pull_from_f90();
+    std::cout << "Largest relative differences of the C++ results:\n"
+              << "  v       " << max_rel_diff(cxx_state.v, f90_state.v) << "\n"
+              << "  T       " << max_rel_diff(cxx_state.t, f90_state.t) << "\n"
+              << "  dp3d    " << max_rel_diff(cxx_state.dp3d, f90_state.dp3d)
+              << "\n"
+              << "  phi     " << max_rel_diff(cxx_state.phi, f90_state.phi)
+              << "\n"
+              << "  omega_p "
+              << max_rel_diff(cxx_state.omega_p, f90_state.omega_p) << "\n"
+              << "  vn0     " << max_rel_diff(cxx_state.vn0, f90_state.vn0)
+              << "\n";
+  }
+
+  caar_f90_finalize();
+  Kokkos::finalize();
+  GPTLpr_summary_file(0, "Timing.dat");
+  return 0;
+}
@@ -3,10 +3,16 @@
 #include "Control.hpp"
 #include "Elements.hpp"
 #include "Derivative.hpp"
+#include "CubedSphere.hpp"
 #include "CaarFunctor.hpp"
+#include "EulerStepFunctor.hpp"
+#include "StepFunctor.hpp"
+#include "CacheMissCounter.hpp"
+#include "Topology.hpp"
 
 #include "profiling.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <chrono>
 
@@ -37,7 +43,11 @@ static __inline__ void clobber() {
 // Attempt to invalidate the instruction cache
 void __attribute__((__noinline__)) function_call_test() {}
 
-void init_kokkos(const bool print_configuration = true) {
+// Also binds the threads of Kokkos to the processing units as HOMMEXX_BIND
+// says (none, compact, scatter or l2, see BindingPolicy; none by default),
+// and prints where each of them runs. False if HOMMEXX_BIND is invalid
+bool init_kokkos(const int threads_per_team,
+                 const bool print_configuration = true) {
   /* Make certain profiling is only done for code we're working on */
   profiling_pause();
 
@@ -46,6 +56,44 @@ void init_kokkos(const bool print_configuration = true) {
   Kokkos::initialize();
 
   ExecSpace::print_configuration(std::cout, print_configuration);
+
+  BindingPolicy binding = BindingPolicy::NONE;
+  const char *bind = std::getenv("HOMMEXX_BIND");
+  if (bind != nullptr && !parse_binding_policy(bind, binding)) {
+    std::cerr << "HOMMEXX_BIND must be none, compact, scatter or l2\n";
+    return false;
+  }
+
+  const Topology topology;
+  if (!topology.available()) {
+    if (binding != BindingPolicy::NONE) {
+      std::cout << "No topology to bind the threads with, leaving them "
+                   "unbound\n";
+    }
+    return true;
+  }
+  std::cout << topology.units().size() << " processing units on "
+            << topology.num_cores() << " cores and "
+            << topology.num_numa_nodes() << " NUMA nodes (from "
+            << topology.source() << ")\n";
+
+  if (binding != BindingPolicy::NONE) {
+    const std::vector<int> placement = topology.placement(
+        binding, ExecSpace::concurrency(), threads_per_team);
+    if (!topology.bind(placement)) {
+      std::cout << "Warning! Could not bind all the threads\n";
+    }
+    std::cout << "Threads bound " << binding_policy_name(binding);
+    if (binding == BindingPolicy::TEAM_PER_L2) {
+      std::cout << " (teams of " << threads_per_team << " threads per "
+                << topology.team_domain(threads_per_team) << ")";
+    }
+    std::cout << "\n";
+  }
+  if (print_configuration) {
+    topology.print_thread_map(std::cout, threads_per_team);
+  }
+  return true;
 }
 
 void flush_caches(HostViewManaged<Real *> &trash) {
@@ -57,15 +105,52 @@ void flush_caches(HostViewManaged<Real *> &trash) {
 
 void finalize_kokkos() { Kokkos::finalize(); }
 
+// Replace the random data with the first num_elems elements of a cubed sphere
+void init_from_mesh(const int ne, const int num_elems, const int qsize,
+                    const PagePolicy pages, Control &data, Elements &elem,
+                    ElementsStorage &storage, Derivative &deriv) {
+  CubedSphere mesh(ne);
+  mesh.init_state(num_elems);
+
+  deriv.init(mesh.m_dvv.data());
+
+  elem.init(num_elems, qsize, pages, storage);
+  elem.init_2d(mesh.m_d.data(), mesh.m_dinv.data(), mesh.m_fcor.data(),
+               mesh.m_spheremp.data(), mesh.m_metdet.data(),
+               mesh.m_phis.data());
+  elem.pull_from_f90_pointers(
+      mesh.m_state_v.data(), mesh.m_state_t.data(), mesh.m_state_dp3d.data(),
+      mesh.m_derived_phi.data(), mesh.m_derived_pecnd.data(),
+      mesh.m_derived_omega_p.data(), mesh.m_derived_v.data(),
+      mesh.m_derived_eta_dot_dpdn.data(), mesh.m_state_qdp.data());
+
+  // The mesh uses the same evenly spaced hybrid_b as the random data
+  data.ps0 = mesh.m_ps0;
+  ExecViewManaged<Real[NUM_LEV_P]>::HostMirror h_hybrid_a =
+      Kokkos::create_mirror_view(data.hybrid_a);
+  for (int i = 0; i < NUM_LEV_P; ++i) {
+    h_hybrid_a(i) = mesh.m_hybrid_a[i];
+  }
+  Kokkos::deep_copy(data.hybrid_a, h_hybrid_a);
+}
+
+// When built for runtime dispatch (HOMMEXX_MULTI_ISA), this file is compiled
+// once per pack width and main is renamed to the entry point of that width
+#ifdef HOMMEXX_DISPATCH_ENTRY
+extern "C" int HOMMEXX_DISPATCH_ENTRY(int argc, char **argv) {
+#else
 int main(int argc, char **argv) {
+#endif
   constexpr int tstep = 600;
-
-  init_kokkos();
-  GPTLinitialize();
-
   constexpr int threads_per_team = 4;
   constexpr int vectors_per_thread = 1;
 
+  if (!init_kokkos(threads_per_team)) {
+    finalize_kokkos();
+    return 1;
+  }
+  GPTLinitialize();
+
   std::random_device rd;
   std::mt19937_64 rng(rd());
 
@@ -83,16 +168,130 @@ int main(int argc, char **argv) {
   genRandArray(data.hybrid_a, rng,
                std::uniform_real_distribution<Real>(1.0, 2.0));
 
+  // Evenly spaced hybrid b, from 0 at the top to 1 at the surface
+  data.hybrid_b =
+      ExecViewManaged<Scalar[NUM_LEV_P]>("Hybrid b at the interfaces");
+  ExecViewManaged<Scalar[NUM_LEV_P]>::HostMirror h_hybrid_b =
+      Kokkos::create_mirror_view(data.hybrid_b);
+  for (int ilevel = 0; ilevel < NUM_INTERFACE_LEV; ++ilevel) {
+    h_hybrid_b(ilevel / VECTOR_SIZE)[ilevel % VECTOR_SIZE] =
+        static_cast<Real>(ilevel) / NUM_PHYSICAL_LEV;
+  }
+  Kokkos::deep_copy(data.hybrid_b, h_hybrid_b);
+
   int num_elems = 32;
   if (argc > 1) {
     num_elems = atoi(argv[1]);
   }
 
-  Elements elem;
-  elem.random_init(num_elems, rng);
+  // Tracers actually advected; storage and initialization are sized to it
+  int qsize = QSIZE_D;
+  if (argc > 3) {
+    qsize = atoi(argv[3]);
+  }
+  if (qsize < 0 || qsize > QSIZE_D) {
+    std::cerr << "qsize must be between 0 and QSIZE_D=" << QSIZE_D << "\n";
+    finalize_kokkos();
+    return 1;
+  }
+  data.qsize = qsize;
 
+  // rsplit=0 adds the Eulerian vertical advection to the timed kernel
+  data.rsplit = 1;
+  if (argc > 4) {
+    data.rsplit = atoi(argv[4]);
+  }
+
+  // With ne > 0 the elements are taken from a cubed sphere with ne x ne
+  // elements per face, instead of being filled with random numbers
+  int ne = 0;
+  if (argc > 5) {
+    ne = atoi(argv[5]);
+  }
+  if (num_elems > 6 * ne * ne && ne > 0) {
+    std::cerr << "A cubed sphere with ne=" << ne << " only has "
+              << 6 * ne * ne << " elements\n";
+    finalize_kokkos();
+    return 1;
+  }
+
+  // With euler_step set, each step also advects the tracers with the mass
+  // flux of CAAR, fused into the CAAR kernel unless HOMMEXX_UNFUSED_STEP
+  bool euler_step = false;
+  if (argc > 6) {
+    euler_step = atoi(argv[6]) != 0;
+  }
+  data.n0_qdp = 0;
+  data.np1_qdp = 1;
+
+  // HOMMEXX_DIAGNOSTICS=1 computes the energy and mass diagnostics inside
+  // CAAR; timing a run with and without it measures what they cost
+  const char *diagnostics = std::getenv("HOMMEXX_DIAGNOSTICS");
+  data.compute_diagonstics =
+      diagnostics != nullptr && std::atoi(diagnostics) != 0;
+
+  // HOMMEXX_STREAMING_STORES=1 writes the state at np1 with non-temporal
+  // stores instead of regular ones; timing a run with each compares them.
+  // The fused step keeps dp3d(np1) on regular stores (see Control)
+  const char *streaming_stores = std::getenv("HOMMEXX_STREAMING_STORES");
+  data.streaming_stores =
+      streaming_stores != nullptr && std::atoi(streaming_stores) != 0;
+
+  // HOMMEXX_PREFETCH_DISTANCE=d prefetches the inputs of the element each
+  // team evaluates d elements later, with the __builtin_prefetch locality
+  // HOMMEXX_PREFETCH_LOCALITY (0 to 3, 2 by default)
+  const char *prefetch_distance = std::getenv("HOMMEXX_PREFETCH_DISTANCE");
+  if (prefetch_distance != nullptr) {
+    data.prefetch_distance = std::atoi(prefetch_distance);
+  }
+  const char *prefetch_locality = std::getenv("HOMMEXX_PREFETCH_LOCALITY");
+  if (prefetch_locality != nullptr) {
+    data.prefetch_locality =
+        std::min(std::max(std::atoi(prefetch_locality), 0), 3);
+  }
+
+  // CAAR runs on the elements [nets, nete)
+  data.num_elems = num_elems;
+  data.nets = 0;
+  data.nete = num_elems;
+
+  // HOMMEXX_PIPELINE=1 evaluates CAAR with as many teams as run at once,
+  // each on a contiguous range of the elements, staging the state of the
+  // next one in team scratch while it computes the current one
+  const char *pipeline = std::getenv("HOMMEXX_PIPELINE");
+  if (pipeline != nullptr && std::atoi(pipeline) != 0) {
+    data.pipeline_teams = std::min(
+        std::max(ExecSpace::concurrency() / threads_per_team, 1), num_elems);
+  }
+#ifndef HOMMEXX_UNFUSED_STEP
+  if (data.pipeline_teams > 0 && euler_step) {
+    std::cerr << "HOMMEXX_PIPELINE needs CAAR in its own kernel: build with "
+                 "HOMMEXX_UNFUSED_STEP for the Euler step\n";
+    finalize_kokkos();
+    return 1;
+  }
+#endif
+
+  // HOMMEXX_HUGE_PAGES=thp or hugetlb carves all the views of the elements
+  // from one slab of huge pages, to cut the TLB misses of the kernels
+  PagePolicy pages = PagePolicy::DEFAULT;
+  const char *huge_pages = std::getenv("HOMMEXX_HUGE_PAGES");
+  if (huge_pages != nullptr && !parse_page_policy(huge_pages, pages)) {
+    std::cerr << "HOMMEXX_HUGE_PAGES must be none, thp or hugetlb\n";
+    finalize_kokkos();
+    return 1;
+  }
+
+  // Owns the slab of the views of elem, so it is destroyed after them
+  ElementsStorage storage;
+  Elements elem;
   Derivative deriv;
-  deriv.random_init(rng);
+  if (ne > 0) {
+    init_from_mesh(ne, num_elems, qsize, pages, data, elem, storage, deriv);
+  } else {
+    elem.random_init(num_elems, qsize, rng, pages, storage);
+    deriv.random_init(rng);
+  }
 
   constexpr int seconds_per_day = 24 * 3600;
   constexpr int rk_stages = 5;
@@ -102,8 +301,10 @@ int main(int argc, char **argv) {
     num_exec = atoi(argv[2]);
   }
 
-  // Create the functor
+  // Create the functors
   CaarFunctor func(data, elem, deriv);
+  EulerStepFunctor euler_step_func(data, elem, deriv);
+  StepFunctor step_func(data, elem, deriv);
 
   constexpr int kb_size = 1024;
   constexpr int doubles_per_kb = kb_size / sizeof(double);
@@ -113,20 +314,64 @@ int main(int argc, char **argv) {
 
   {
     // Setup the policy
-    Kokkos::TeamPolicy<ExecSpace> policy(num_elems, threads_per_team,
-                                         vectors_per_thread);
+    Kokkos::TeamPolicy<ExecSpace> policy(data.nete - data.nets,
+                                         threads_per_team, vectors_per_thread);
     policy.set_chunk_size(1);
+    // Kokkos adds the team scratch of the staged buffers from shmem_size
+    Kokkos::TeamPolicy<ExecSpace, CaarFunctor::Pipelined> pipelined_policy(
+        std::max(data.pipeline_teams, 1), threads_per_team,
+        vectors_per_thread);
 
     std::vector<clock_type::time_point> start_times(num_exec);
     std::vector<clock_type::time_point> end_times(num_exec);
 
+    // Counts the kernels only, not the flushes of the caches
+    CacheMissCounter cache_misses;
+    CacheMissCounter tlb_misses(CountedCache::DATA_TLB);
+
+    // Of the last step, when data.compute_diagonstics is set
+    CaarDiagnostics diagnostics;
+
+    // CAAR in its own kernel
+    const auto caar = [&]() {
+      if (data.pipeline_teams > 0) {
+        if (data.compute_diagonstics) {
+          Kokkos::parallel_reduce(pipelined_policy, func, diagnostics);
+        } else {
+          Kokkos::parallel_for(pipelined_policy, func);
+        }
+      } else if (data.compute_diagonstics) {
+        Kokkos::parallel_reduce(policy, func, diagnostics);
+      } else {
+        Kokkos::parallel_for(policy, func);
+      }
+    };
+
     for (int exec = 0; exec < num_exec; ++exec) {
       auto start = clock_type::now();
       ExecSpace::fence();
+      cache_misses.start();
+      tlb_misses.start();
       start_timer("dispatch and compute");
-      Kokkos::parallel_for(policy, func);
+      if (!euler_step) {
+        caar();
+      } else {
+#ifdef HOMMEXX_UNFUSED_STEP
+        caar();
+        ExecSpace::fence();
+        Kokkos::parallel_for(policy, euler_step_func);
+#else
+        if (data.compute_diagonstics) {
+          Kokkos::parallel_reduce(policy, step_func, diagnostics);
+        } else {
+          Kokkos::parallel_for(policy, step_func);
+        }
+#endif
+      }
       ExecSpace::fence();
       stop_timer("dispatch and compute");
+      cache_misses.stop();
+      tlb_misses.stop();
       flush_caches(trash);
       auto end = clock_type::now();
       start_times[exec] = start;
@@ -142,9 +387,60 @@ int main(int argc, char **argv) {
 
     auto count = std::chrono::duration_cast<ns>(total_time).count();
     std::cout << "Seconds " << count * 1e-9 << " to evaluate " << num_elems
-              << " elements " << num_exec << " times\n";
+              << " elements " << num_exec << " times with rsplit "
+              << data.rsplit
+              << (euler_step ? " and the Euler step of the tracers" : "")
+              << (data.streaming_stores ? ", streaming the np1 stores" : "")
+#ifndef HOMMEXX_UNFUSED_STEP
+              << (data.streaming_stores && euler_step
+                      ? " but dp3d, which the fused Euler step reads"
+                      : "")
+#endif
+              << (data.compute_diagonstics ? ", with the diagnostics" : "")
+              << "\n";
+    if (data.compute_diagonstics) {
+      std::cout << "Kinetic energy " << diagnostics.kinetic_energy
+                << ", internal energy " << diagnostics.internal_energy
+                << ", mass " << diagnostics.mass << "\n";
+    }
+    if (data.pipeline_teams > 0) {
+      std::cout << "Pipelined over " << data.pipeline_teams
+                << " teams, staging the next element in "
+                << func.shmem_size(threads_per_team) / 1024
+                << " KB of team scratch\n";
+    }
+    if (data.prefetch_distance > 0) {
+      std::cout << "Prefetching " << data.prefetch_distance
+                << " elements ahead with locality " << data.prefetch_locality
+                << "\n";
+    }
+    if (cache_misses.available()) {
+      std::cout << "Last level cache miss rate " << cache_misses.miss_rate()
+                << " (" << static_cast<double>(cache_misses.misses()) /
+                               (static_cast<double>(num_exec) * num_elems)
+                << " misses per element per step)\n";
+    } else {
+      std::cout << "Cache counters unavailable\n";
+    }
+    if (storage.slab_size() > 0) {
+      std::cout << "Elements in a slab of " << storage.slab_size() / (1 << 20)
+                << " MB with " << page_policy_name(storage.page_policy())
+                << "\n";
+    } else if (pages != PagePolicy::DEFAULT) {
+      std::cout << "Elements in their own allocations: no slab of huge "
+                   "pages in this execution space\n";
+    }
+    if (tlb_misses.available()) {
+      std::cout << "Data TLB miss rate " << tlb_misses.miss_rate() << " ("
+                << static_cast<double>(tlb_misses.misses()) /
+                       (static_cast<double>(num_exec) * num_elems)
+                << " misses per element per step)\n";
+    } else {
+      std::cout << "TLB counters unavailable\n";
+    }
   }
 
   finalize_kokkos();
   GPTLpr_summary_file(0, "Timing.dat");
+  return 0;
 }
@@ -0,0 +1,250 @@
+#include "Types.hpp"
+#include "Control.hpp"
+#include "Elements.hpp"
+#include "Derivative.hpp"
+#include "CubedSphere.hpp"
+#include "StateLayout.hpp"
+#include "LayoutCaarFunctor.hpp"
+
+#include "profiling.hpp"
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+
+using namespace Homme;
+
+using clock_type = std::chrono::high_resolution_clock;
+using ns = std::chrono::nanoseconds;
+
+// Host copies of the inputs of CAAR, read with the same (ie, tl, ilev, igp,
+// jgp) indices in all the layouts
+struct HostInputs {
+  explicit HostInputs(const Elements &elem)
+      : u(Kokkos::create_mirror_view(elem.m_u)),
+        v(Kokkos::create_mirror_view(elem.m_v)),
+        t(Kokkos::create_mirror_view(elem.m_t)),
+        dp3d(Kokkos::create_mirror_view(elem.m_dp3d)),
+        phi(Kokkos::create_mirror_view(elem.m_phi)),
+        pecnd(Kokkos::create_mirror_view(elem.m_pecnd)),
+        omega_p(Kokkos::create_mirror_view(elem.m_omega_p)),
+        un0(Kokkos::create_mirror_view(elem.m_derived_un0)),
+        vn0(Kokkos::create_mirror_view(elem.m_derived_vn0)) {
+    Kokkos::deep_copy(u, elem.m_u);
+    Kokkos::deep_copy(v, elem.m_v);
+    Kokkos::deep_copy(t, elem.m_t);
+    Kokkos::deep_copy(dp3d, elem.m_dp3d);
+    Kokkos::deep_copy(phi, elem.m_phi);
+    Kokkos::deep_copy(pecnd, elem.m_pecnd);
+    Kokkos::deep_copy(omega_p, elem.m_omega_p);
+    Kokkos::deep_copy(un0, elem.m_derived_un0);
+    Kokkos::deep_copy(vn0, elem.m_derived_vn0);
+  }
+
+  Real state(const int ie, const int tl, const int field, const int ilev,
+             const int igp, const int jgp) const {
+    const auto &view = field == U_FIELD ? u : field == V_FIELD
+                                                  ? v
+                                                  : field == T_FIELD ? t
+                                                                     : dp3d;
+    return view(ie, tl, igp, jgp, ilev / VECTOR_SIZE)[ilev % VECTOR_SIZE];
+  }
+
+  ExecViewManaged<Scalar * [NUM_TIME_LEVELS][NP][NP][NUM_LEV]>::HostMirror u,
+      v, t, dp3d;
+  ExecViewManaged<Scalar * [NP][NP][NUM_LEV]>::HostMirror phi, pecnd,
+      omega_p, un0, vn0;
+};
+
+template <typename Layout>
+static void copy_field(
+    const ExecViewManaged<Scalar * [NP][NP][NUM_LEV]>::HostMirror &src,
+    const PointField<Layout> &dst, const int num_elems) {
+  auto h_dst = Kokkos::create_mirror_view(dst.data());
+  for (int ie = 0; ie < num_elems; ++ie) {
+    for (int ilev = 0; ilev < NUM_PHYSICAL_LEV; ++ilev) {
+      for (int igp = 0; igp < NP; ++igp) {
+        for (int jgp = 0; jgp < NP; ++jgp) {
+          h_dst(PointField<Layout>::offset(ie, ilev, igp, jgp)) =
+              src(ie, igp, jgp, ilev / VECTOR_SIZE)[ilev % VECTOR_SIZE];
+        }
+      }
+    }
+  }
+  Kokkos::deep_copy(dst.data(), h_dst);
+}
+
+// Runs CAAR num_exec times on the state stored in Layout, and returns the
+// seconds it took and the state at np1 in the (ie, field, ilev, igp, jgp)
+// order, to compare the layouts
+template <typename Layout>
+static double benchmark_layout(const Control &data, const Elements &elem,
+                               const Derivative &deriv,
+                               const HostInputs &inputs, const int num_exec,
+                               std::vector<Real> &np1_state) {
+  const int num_elems = data.num_elems;
+  State<Layout> state(num_elems);
+  LayoutCaarFields<Layout> fields(num_elems);
+
+  auto h_state = Kokkos::create_mirror_view(state.data());
+  for (int ie = 0; ie < num_elems; ++ie) {
+    for (int tl = 0; tl < NUM_TIME_LEVELS; ++tl) {
+      for (int field = 0; field < NUM_ST_FIELDS; ++field) {
+        for (int ilev = 0; ilev < NUM_PHYSICAL_LEV; ++ilev) {
+          for (int igp = 0; igp < NP; ++igp) {
+            for (int jgp = 0; jgp < NP; ++jgp) {
+              h_state(state.layout().offset(ie, tl, field, ilev, igp, jgp)) =
+                  inputs.state(ie, tl, field, ilev, igp, jgp);
+            }
+          }
+        }
+      }
+    }
+  }
+  Kokkos::deep_copy(state.data(), h_state);
+  copy_field(inputs.phi, fields.phi, num_elems);
+  copy_field(inputs.pecnd, fields.pecnd, num_elems);
+  copy_field(inputs.omega_p, fields.omega_p, num_elems);
+  copy_field(inputs.un0, fields.un0, num_elems);
+  copy_field(inputs.vn0, fields.vn0, num_elems);
+
+  constexpr int threads_per_team = 4;
+  constexpr int vectors_per_thread = 1;
+  Kokkos::TeamPolicy<ExecSpace> policy(num_elems, threads_per_team,
+                                       vectors_per_thread);
+  policy.set_chunk_size(1);
+  const LayoutCaarFunctor<Layout> func(data, elem, deriv, state, fields);
+
+  ExecSpace::fence();
+  auto start = clock_type::now();
+  for (int i = 0; i < num_exec; ++i) {
+    Kokkos::parallel_for(policy, func);
+    ExecSpace::fence();
+  }
+  auto end = clock_type::now();
+
+  Kokkos::deep_copy(h_state, state.data());
+  np1_state.clear();
+  for (int ie = 0; ie < num_elems; ++ie) {
+    for (int field = 0; field < NUM_ST_FIELDS; ++field) {
+      for (int ilev = 0; ilev < NUM_PHYSICAL_LEV; ++ilev) {
+        for (int igp = 0; igp < NP; ++igp) {
+          for (int jgp = 0; jgp < NP; ++jgp) {
+            np1_state.push_back(h_state(
+                state.layout().offset(ie, data.np1, field, ilev, igp, jgp)));
+          }
+        }
+      }
+    }
+  }
+  return std::chrono::duration_cast<ns>(end - start).count() * 1e-9;
+}
+
+// CAAR on the state stored in each of the layouts of the Fortran benchmark
+// (STVER1-4) and of the C++ variants, with the same arithmetic in all of
+// them, so that only the memory layout differs between the timings
+int main(int argc, char **argv) {
+  constexpr int tstep = 600;
+
+  Kokkos::initialize();
+  ExecSpace::print_configuration(std::cout, true);
+  GPTLinitialize();
+
+  int ne = 2;
+  if (argc > 1) {
+    ne = atoi(argv[1]);
+  }
+
+  constexpr int seconds_per_day = 24 * 3600;
+  constexpr int rk_stages = 5;
+  int num_exec = (seconds_per_day / tstep) * rk_stages;
+  if (argc > 2) {
+    num_exec = atoi(argv[2]);
+  }
+
+  int num_elems = 6 * ne * ne;
+  if (argc > 3) {
+    num_elems = atoi(argv[3]);
+  }
+  if (num_elems < 1 || num_elems > 6 * ne * ne) {
+    std::cerr << "A cubed sphere with ne=" << ne << " only has "
+              << 6 * ne * ne << " elements\n";
+    Kokkos::finalize();
+    return 1;
+  }
+
+  Control data;
+  data.nm1 = 0;
+  data.n0 = 1;
+  data.np1 = 2;
+  data.qn0 = -1;
+  data.dt = tstep;
+  data.eta_ave_w = 1.0;
+  data.compute_diagonstics = 0;
+  data.qsize = 0;
+  data.rsplit = 1;
+  data.num_elems = num_elems;
+  data.nets = 0;
+  data.nete = num_elems;
+
+  CubedSphere mesh(ne);
+  mesh.init_state(num_elems);
+
+  Derivative deriv;
+  deriv.init(mesh.m_dvv.data());
+
+  Elements elem;
+  elem.init(num_elems, 0);
+  elem.init_2d(mesh.m_d.data(), mesh.m_dinv.data(), mesh.m_fcor.data(),
+               mesh.m_spheremp.data(), mesh.m_metdet.data(),
+               mesh.m_phis.data());
+  elem.pull_from_f90_pointers(
+      mesh.m_state_v.data(), mesh.m_state_t.data(), mesh.m_state_dp3d.data(),
+      mesh.m_derived_phi.data(), mesh.m_derived_pecnd.data(),
+      mesh.m_derived_omega_p.data(), mesh.m_derived_v.data(),
+      mesh.m_derived_eta_dot_dpdn.data(), mesh.m_state_qdp.data());
+
+  data.ps0 = mesh.m_ps0;
+  data.hybrid_a = ExecViewManaged<Real[NUM_LEV_P]>(
+      "Hybrid coordinates; translates between pressure and velocity");
+  ExecViewManaged<Real[NUM_LEV_P]>::HostMirror h_hybrid_a =
+      Kokkos::create_mirror_view(data.hybrid_a);
+  for (int i = 0; i < NUM_LEV_P; ++i) {
+    h_hybrid_a(i) = mesh.m_hybrid_a[i];
+  }
+  Kokkos::deep_copy(data.hybrid_a, h_hybrid_a);
+
+  const HostInputs inputs(elem);
+
+  const char *names[] = { "STVER1", "STVER2", "STVER3", "STVER4",
+                          "tiled",  "level" };
+  double seconds[6];
+  std::vector<Real> np1_states[6];
+  seconds[0] = benchmark_layout<STVer1Layout>(data, elem, deriv, inputs,
+                                              num_exec, np1_states[0]);
+  seconds[1] = benchmark_layout<STVer2Layout>(data, elem, deriv, inputs,
+                                              num_exec, np1_states[1]);
+  seconds[2] = benchmark_layout<STVer3Layout>(data, elem, deriv, inputs,
+                                              num_exec, np1_states[2]);
+  seconds[3] = benchmark_layout<STVer4Layout>(data, elem, deriv, inputs,
+                                              num_exec, np1_states[3]);
+  seconds[4] = benchmark_layout<TiledLayout>(data, elem, deriv, inputs,
+                                             num_exec, np1_states[4]);
+  seconds[5] = benchmark_layout<LevelLayout>(data, elem, deriv, inputs,
+                                             num_exec, np1_states[5]);
+
+  for (int i = 0; i < 6; ++i) {
+    std::cout << "Seconds " << seconds[i] << " (" << names[i]
+              << " layout) to evaluate " << num_elems << " elements "
+              << num_exec << " times";
+    if (np1_states[i] != np1_states[0]) {
+      std::cout << ", but its state at np1 differs from the " << names[0]
+                << " one";
+    }
+    std::cout << "\n";
+  }
+
+  Kokkos::finalize();
+  GPTLpr_summary_file(0, "Timing.dat");
+  return 0;
+}
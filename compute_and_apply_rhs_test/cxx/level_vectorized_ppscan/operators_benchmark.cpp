@@ -0,0 +1,202 @@
+#include "Types.hpp"
+#include "Elements.hpp"
+#include "Derivative.hpp"
+#include "KernelVariables.hpp"
+#include "SphereOperators.hpp"
+#include "SphereOperatorsGemm.hpp"
+
+#include "profiling.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <chrono>
+#include <random>
+
+using namespace Homme;
+
+using clock_type = std::chrono::high_resolution_clock;
+using ns = std::chrono::nanoseconds;
+
+// The outputs of the operators on all the elements
+struct OperatorOutputs {
+  explicit OperatorOutputs(const int num_elems)
+      : grad("gradient of T", num_elems),
+        div("divergence of (u, v)", num_elems),
+        vort("vorticity of (u, v)", num_elems) {}
+
+  ExecViewManaged<Scalar * [2][NP][NP][NUM_LEV]> grad;
+  ExecViewManaged<Scalar * [NP][NP][NUM_LEV]> div;
+  ExecViewManaged<Scalar * [NP][NP][NUM_LEV]> vort;
+};
+
+// The gradient of T, the divergence and the vorticity of (u, v) at n0 of
+// each element, with the per-level operators or the batched small-GEMM ones
+template <bool Gemm> struct OperatorsFunctor {
+  static constexpr Kokkos::Impl::ALL_t ALL = Kokkos::ALL;
+  static constexpr int n0 = 0;
+
+  OperatorsFunctor(const Elements &elements, const Derivative &deriv,
+                   const ExecViewManaged<Scalar * [2][NP][NP][NUM_LEV]> &uv,
+                   const OperatorOutputs &out)
+      : m_elements(elements), m_deriv(deriv), m_uv(uv), m_out(out) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const TeamMember &team) const {
+    KernelVariables kv(team);
+    const auto t = Kokkos::subview(m_elements.m_t, kv.ie, n0, ALL, ALL, ALL);
+    const auto u = Kokkos::subview(m_elements.m_u, kv.ie, n0, ALL, ALL, ALL);
+    const auto v = Kokkos::subview(m_elements.m_v, kv.ie, n0, ALL, ALL, ALL);
+    const auto uv = Kokkos::subview(m_uv, kv.ie, ALL, ALL, ALL, ALL);
+    const auto grad = Kokkos::subview(m_out.grad, kv.ie, ALL, ALL, ALL, ALL);
+    const auto div = Kokkos::subview(m_out.div, kv.ie, ALL, ALL, ALL);
+    const auto vort = Kokkos::subview(m_out.vort, kv.ie, ALL, ALL, ALL);
+    if (Gemm) {
+      gradient_sphere_gemm(kv, m_elements.geometry, m_deriv.get_dvv_rrearth(),
+                           t, m_elements.buffers.grad_buf, grad);
+      divergence_sphere_gemm(kv, m_elements.geometry, m_deriv.get_dvv(), uv,
+                             m_elements.buffers.div_buf, div);
+      vorticity_sphere_gemm(kv, m_elements.geometry, m_deriv.get_dvv(), u, v,
+                            m_elements.buffers.vort_buf, vort);
+    } else {
+      gradient_sphere(kv, m_elements.geometry, m_deriv.get_dvv_rrearth(), t,
+                      m_elements.buffers.grad_buf, grad);
+      divergence_sphere(kv, m_elements.geometry, m_deriv.get_dvv(), uv,
+                        m_elements.buffers.div_buf, div);
+      vorticity_sphere(kv, m_elements.geometry, m_deriv.get_dvv(), u, v,
+                       m_elements.buffers.vort_buf, vort);
+    }
+  }
+
+  const Elements m_elements;
+  const Derivative m_deriv;
+  const ExecViewManaged<Scalar * [2][NP][NP][NUM_LEV]> m_uv;
+  const OperatorOutputs m_out;
+};
+
+template <bool Gemm>
+static double time_operators(const OperatorsFunctor<Gemm> &func,
+                             const int num_elems, const int num_exec,
+                             const char *timer) {
+  constexpr int threads_per_team = 4;
+  constexpr int vectors_per_thread = 1;
+  Kokkos::TeamPolicy<ExecSpace> policy(num_elems, threads_per_team,
+                                       vectors_per_thread);
+  policy.set_chunk_size(1);
+
+  // Once to warm up the caches
+  Kokkos::parallel_for(policy, func);
+  ExecSpace::fence();
+
+  start_timer(timer);
+  const auto start = clock_type::now();
+  for (int exec = 0; exec < num_exec; ++exec) {
+    Kokkos::parallel_for(policy, func);
+    ExecSpace::fence();
+  }
+  const auto end = clock_type::now();
+  stop_timer(timer);
+  return std::chrono::duration_cast<ns>(end - start).count() * 1e-9;
+}
+
+// Largest difference between the packs of two views
+template <typename ViewType>
+static Real max_diff(const ViewType &computed, const ViewType &expected) {
+  auto h_computed = Kokkos::create_mirror_view(computed);
+  auto h_expected = Kokkos::create_mirror_view(expected);
+  Kokkos::deep_copy(h_computed, computed);
+  Kokkos::deep_copy(h_expected, expected);
+  const Scalar *c = h_computed.data();
+  const Scalar *e = h_expected.data();
+  Real diff = 0;
+  for (size_t i = 0; i < h_expected.size(); ++i) {
+    for (int v = 0; v < VECTOR_SIZE; ++v) {
+      diff = std::max(diff, std::abs(c[i][v] - e[i][v]));
+    }
+  }
+  return diff;
+}
+
+// The gradient, divergence and vorticity operators of CAAR with the dvv
+// contractions computed level by level (SphereOperators.hpp) and as batched
+// small GEMMs (SphereOperatorsGemm.hpp), head to head on the same random
+// elements, and the largest difference between their results
+int main(int argc, char **argv) {
+  Kokkos::initialize();
+  ExecSpace::print_configuration(std::cout, true);
+  GPTLinitialize();
+
+  int num_elems = 32;
+  if (argc > 1) {
+    num_elems = atoi(argv[1]);
+  }
+
+  int num_exec = 1000;
+  if (argc > 2) {
+    num_exec = atoi(argv[2]);
+  }
+
+  if (num_elems < 1 || num_exec < 1) {
+    std::cerr << "Usage: " << argv[0] << " [num_elems] [num_exec]\n";
+    Kokkos::finalize();
+    return 1;
+  }
+
+#ifdef HOMMEXX_GEMM_OPERATORS
+  std::cout << "Built with HOMMEXX_GEMM_OPERATORS: the per-level operators "
+               "forward to the GEMM ones\n";
+#endif
+
+  std::random_device rd;
+  std::mt19937_64 rng(rd());
+
+  Elements elem;
+  elem.random_init(num_elems, 0, rng);
+  Derivative deriv;
+  deriv.random_init(rng);
+
+  // The divergence takes (u, v) as a single view
+  ExecViewManaged<Scalar * [2][NP][NP][NUM_LEV]> uv("(u, v) at n0",
+                                                    num_elems);
+  {
+    auto h_uv = Kokkos::create_mirror_view(uv);
+    auto h_u = Kokkos::create_mirror_view(elem.m_u);
+    auto h_v = Kokkos::create_mirror_view(elem.m_v);
+    Kokkos::deep_copy(h_u, elem.m_u);
+    Kokkos::deep_copy(h_v, elem.m_v);
+    for (int ie = 0; ie < num_elems; ++ie) {
+      for (int igp = 0; igp < NP; ++igp) {
+        for (int jgp = 0; jgp < NP; ++jgp) {
+          for (int ilev = 0; ilev < NUM_LEV; ++ilev) {
+            h_uv(ie, 0, igp, jgp, ilev) = h_u(ie, 0, igp, jgp, ilev);
+            h_uv(ie, 1, igp, jgp, ilev) = h_v(ie, 0, igp, jgp, ilev);
+          }
+        }
+      }
+    }
+    Kokkos::deep_copy(uv, h_uv);
+  }
+
+  const OperatorOutputs per_level_out(num_elems), gemm_out(num_elems);
+  const double per_level_seconds = time_operators(
+      OperatorsFunctor<false>(elem, deriv, uv, per_level_out), num_elems,
+      num_exec, "per level operators");
+  const double gemm_seconds =
+      time_operators(OperatorsFunctor<true>(elem, deriv, uv, gemm_out),
+                     num_elems, num_exec, "gemm operators");
+
+  std::cout << "Seconds " << per_level_seconds << " (per level) vs "
+            << gemm_seconds << " (GEMM) to apply the operators to "
+            << num_elems << " elements " << num_exec << " times\n"
+            << "Largest differences of the GEMM results:\n"
+            << "  gradient   " << max_diff(gemm_out.grad, per_level_out.grad)
+            << "\n"
+            << "  divergence " << max_diff(gemm_out.div, per_level_out.div)
+            << "\n"
+            << "  vorticity  " << max_diff(gemm_out.vort, per_level_out.vort)
+            << "\n";
+
+  Kokkos::finalize();
+  GPTLpr_summary_file(0, "Timing.dat");
+  return 0;
+}
@@ -0,0 +1,245 @@
+#include "Types.hpp"
+#include "Control.hpp"
+#include "Elements.hpp"
+#include "Derivative.hpp"
+#include "CubedSphere.hpp"
+#include "CaarFunctor.hpp"
+#include "Dss.hpp"
+#include "SharedMemoryComm.hpp"
+
+#include "profiling.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <thread>
+
+using namespace Homme;
+
+using clock_type = std::chrono::high_resolution_clock;
+using ns = std::chrono::nanoseconds;
+
+// CAAR and DSS on a cubed sphere split over num_ranks processes. Each rank
+// computes the elements on its boundary first, and then packs and exchanges
+// them on a separate thread while its interior elements are computed. Leave
+// a core per rank for that thread (e.g. OMP_NUM_THREADS=cores/ranks-1)
+int main(int argc, char **argv) {
+  constexpr int tstep = 600;
+
+  int ne = 4;
+  if (argc > 1) {
+    ne = atoi(argv[1]);
+  }
+
+  constexpr int seconds_per_day = 24 * 3600;
+  constexpr int rk_stages = 5;
+  int num_exec = (seconds_per_day / tstep) * rk_stages;
+  if (argc > 2) {
+    num_exec = atoi(argv[2]);
+  }
+
+  int qsize = QSIZE_D;
+  if (argc > 3) {
+    qsize = atoi(argv[3]);
+  }
+  if (qsize < 0 || qsize > QSIZE_D) {
+    std::cerr << "qsize must be between 0 and QSIZE_D=" << QSIZE_D << "\n";
+    return 1;
+  }
+
+  int rsplit = 1;
+  if (argc > 4) {
+    rsplit = atoi(argv[4]);
+  }
+
+  int num_ranks = 2;
+  if (argc > 5) {
+    num_ranks = atoi(argv[5]);
+  }
+
+  // Each rank owns a contiguous segment of this ordering of the elements
+  CubedSphere::Ordering ordering = CubedSphere::ROW_MAJOR;
+  if (argc > 6) {
+    ordering = static_cast<CubedSphere::Ordering>(atoi(argv[6]));
+  }
+
+  CubedSphere mesh(ne);
+  if (num_ranks < 1 || num_ranks > mesh.num_elems()) {
+    std::cerr << "A cubed sphere with ne=" << ne << " only has "
+              << mesh.num_elems() << " elements\n";
+    return 1;
+  }
+  if (ordering < 0 || ordering >= CubedSphere::NUM_ORDERINGS) {
+    std::cerr << "The ordering is 0 (row major), 1 (Morton), 2 (Hilbert) or "
+                 "3 (random)\n";
+    return 1;
+  }
+
+  // One buffer per parity of the step: a rank may pack step n + 1 while a
+  // slower one still unpacks step n
+  const size_t buffer_size = Dss::buffer_size(mesh, qsize);
+  SharedMemoryComm comm(num_ranks, 2 * buffer_size);
+
+  Kokkos::initialize();
+  ExecSpace::print_configuration(std::cout, comm.rank() == 0);
+  GPTLinitialize();
+
+  constexpr int threads_per_team = 4;
+  constexpr int vectors_per_thread = 1;
+
+  int num_boundary;
+  const std::vector<int> elems =
+      mesh.partition(comm.rank(), comm.size(), num_boundary, ordering);
+  const int num_elems = elems.size();
+  mesh.init_state(elems);
+
+  Derivative deriv;
+  deriv.init(mesh.m_dvv.data());
+
+  Elements elem;
+  elem.init(num_elems, qsize);
+  elem.init_2d(mesh.gather(mesh.m_d, elems).data(),
+               mesh.gather(mesh.m_dinv, elems).data(),
+               mesh.gather(mesh.m_fcor, elems).data(),
+               mesh.gather(mesh.m_spheremp, elems).data(),
+               mesh.gather(mesh.m_metdet, elems).data(),
+               mesh.gather(mesh.m_phis, elems).data());
+  elem.pull_from_f90_pointers(
+      mesh.m_state_v.data(), mesh.m_state_t.data(), mesh.m_state_dp3d.data(),
+      mesh.m_derived_phi.data(), mesh.m_derived_pecnd.data(),
+      mesh.m_derived_omega_p.data(), mesh.m_derived_v.data(),
+      mesh.m_derived_eta_dot_dpdn.data(), mesh.m_state_qdp.data());
+
+  Control data;
+  data.nm1 = 0;
+  data.n0 = 1;
+  data.np1 = 2;
+  data.qn0 = -1;
+  data.dt = tstep;
+  data.eta_ave_w = 1.0;
+  data.compute_diagonstics = 0;
+  data.qsize = qsize;
+  data.rsplit = rsplit;
+  data.num_elems = num_elems;
+
+  data.ps0 = mesh.m_ps0;
+  data.hybrid_a = ExecViewManaged<Real[NUM_LEV_P]>(
+      "Hybrid coordinates; translates between pressure and velocity");
+  ExecViewManaged<Real[NUM_LEV_P]>::HostMirror h_hybrid_a =
+      Kokkos::create_mirror_view(data.hybrid_a);
+  for (int i = 0; i < NUM_LEV_P; ++i) {
+    h_hybrid_a(i) = mesh.m_hybrid_a[i];
+  }
+  Kokkos::deep_copy(data.hybrid_a, h_hybrid_a);
+
+  data.hybrid_b =
+      ExecViewManaged<Scalar[NUM_LEV_P]>("Hybrid b at the interfaces");
+  ExecViewManaged<Scalar[NUM_LEV_P]>::HostMirror h_hybrid_b =
+      Kokkos::create_mirror_view(data.hybrid_b);
+  for (int ilevel = 0; ilevel < NUM_INTERFACE_LEV; ++ilevel) {
+    h_hybrid_b(ilevel / VECTOR_SIZE)[ilevel % VECTOR_SIZE] =
+        static_cast<Real>(ilevel) / NUM_PHYSICAL_LEV;
+  }
+  Kokkos::deep_copy(data.hybrid_b, h_hybrid_b);
+
+  Dss dss[2];
+  for (int i = 0; i < 2; ++i) {
+    dss[i].init(mesh, elem, elems,
+                reinterpret_cast<Scalar *>(static_cast<char *>(comm.buffer()) +
+                                           i * buffer_size));
+  }
+
+  // The boundary elements are [0, num_boundary), the interior ones
+  // [num_boundary, num_elems)
+  Control boundary_data = data;
+  boundary_data.nets = 0;
+  boundary_data.nete = num_boundary;
+  Control interior_data = data;
+  interior_data.nets = num_boundary;
+  interior_data.nete = num_elems;
+  CaarFunctor boundary_func(boundary_data, elem, deriv);
+  CaarFunctor interior_func(interior_data, elem, deriv);
+
+  {
+    Kokkos::TeamPolicy<ExecSpace> boundary_policy(
+        std::max(num_boundary, 1), threads_per_team, vectors_per_thread);
+    boundary_policy.set_chunk_size(1);
+    Kokkos::TeamPolicy<ExecSpace> interior_policy(
+        std::max(num_elems - num_boundary, 1), threads_per_team,
+        vectors_per_thread);
+    interior_policy.set_chunk_size(1);
+
+    clock_type::duration total_time = clock_type::duration::zero();
+    clock_type::duration exchange_time = clock_type::duration::zero();
+    clock_type::duration exposed_time = clock_type::duration::zero();
+
+    comm.barrier();
+    for (int exec = 0; exec < num_exec; ++exec) {
+      const Dss &step_dss = dss[exec % 2];
+
+      ExecSpace::fence();
+      auto start = clock_type::now();
+      if (num_boundary > 0) {
+        start_timer("boundary caar");
+        Kokkos::parallel_for(boundary_policy, boundary_func);
+        ExecSpace::fence();
+        stop_timer("boundary caar");
+      }
+
+      clock_type::duration step_exchange_time;
+      std::thread exchange([&]() {
+        auto exchange_start = clock_type::now();
+        step_dss.pack_host(elem, data.np1, 0, 0, num_boundary);
+        comm.barrier();
+        step_exchange_time = clock_type::now() - exchange_start;
+      });
+
+      if (num_boundary < num_elems) {
+        start_timer("interior caar");
+        Kokkos::parallel_for(interior_policy, interior_func);
+        ExecSpace::fence();
+        stop_timer("interior caar");
+      }
+      auto interior_end = clock_type::now();
+      exchange.join();
+      auto joined = clock_type::now();
+
+      // The interior elements only share points with elements of this rank
+      start_timer("dss");
+      step_dss.pack(elem, data.np1, 0, num_boundary, num_elems);
+      step_dss.unpack(elem, data.np1, 0);
+      stop_timer("dss");
+      auto end = clock_type::now();
+
+      total_time += end - start;
+      exchange_time += step_exchange_time;
+      exposed_time += joined - interior_end;
+    }
+
+    const auto total_count =
+        std::chrono::duration_cast<ns>(total_time).count();
+    const auto exchange_count =
+        std::chrono::duration_cast<ns>(exchange_time).count();
+    const auto exposed_count =
+        std::chrono::duration_cast<ns>(exposed_time).count();
+    std::ostringstream report;
+    report << "Rank " << comm.rank() << ": Seconds " << total_count * 1e-9
+           << " to evaluate " << num_elems << " elements (" << num_boundary
+           << " on the boundary) " << num_exec << " times with rsplit "
+           << data.rsplit << "; exchange " << exchange_count * 1e-9
+           << " s, of which " << (exchange_count - exposed_count) * 1e-9
+           << " s hidden behind the interior ("
+           << (exchange_count > 0
+                   ? 100.0 * (exchange_count - exposed_count) / exchange_count
+                   : 100.0)
+           << "%)\n";
+    std::cout << report.str() << std::flush;
+  }
+
+  Kokkos::finalize();
+  if (comm.rank() == 0) {
+    GPTLpr_summary_file(0, "Timing.dat");
+  }
+  return 0;
+}
@@ -59,11 +59,29 @@ public:
 
   inline void storeAligned(value_type *p) const { _mm256_store_pd(p, _data.v); }
 
+  // Non-temporal: bypasses the caches, and needs an sfence before other
+  // threads read p
+  inline void storeStreaming(value_type *p) const {
+    _mm256_stream_pd(p, _data.v);
+  }
+
   inline void storeUnaligned(value_type *p) const {
     _mm256_storeu_pd(p, _data.v);
   }
 
   inline value_type &operator[](int i) const { return _data.d[i]; }
+
+  inline void shift_left(int num_shift) {
+    for (int i = 0; i < vector_length - num_shift; ++i) {
+      _data.d[i] = _data.d[i + num_shift];
+    }
+  }
+
+  inline void shift_right(int num_shift) {
+    for (int i = vector_length - 1; i >= num_shift; --i) {
+      _data.d[i] = _data.d[i - num_shift];
+    }
+  }
 };
 
 template <typename SpT>
@@ -238,6 +256,100 @@ operator-(Vector<VectorTag<AVX<double, SpT>, 4> > const &a) {
   return -1 * a;
 }
 
+// Fused multiply-add family: fma(a,b,c) = a*b+c, fms(a,b,c) = a*b-c,
+// fnma(a,b,c) = c-a*b. Without FMA hardware these fall back to mul+add.
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+fma(Vector<VectorTag<AVX<double, SpT>, 4> > const &a,
+    Vector<VectorTag<AVX<double, SpT>, 4> > const &b,
+    Vector<VectorTag<AVX<double, SpT>, 4> > const &c) {
+#if defined(__FMA__)
+  return _mm256_fmadd_pd(a, b, c);
+#else
+  return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+fma(const double a, Vector<VectorTag<AVX<double, SpT>, 4> > const &b,
+    Vector<VectorTag<AVX<double, SpT>, 4> > const &c) {
+  return fma(Vector<VectorTag<AVX<double, SpT>, 4> >(a), b, c);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+fma(Vector<VectorTag<AVX<double, SpT>, 4> > const &a, const double b,
+    Vector<VectorTag<AVX<double, SpT>, 4> > const &c) {
+  return fma(a, Vector<VectorTag<AVX<double, SpT>, 4> >(b), c);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+fms(Vector<VectorTag<AVX<double, SpT>, 4> > const &a,
+    Vector<VectorTag<AVX<double, SpT>, 4> > const &b,
+    Vector<VectorTag<AVX<double, SpT>, 4> > const &c) {
+#if defined(__FMA__)
+  return _mm256_fmsub_pd(a, b, c);
+#else
+  return _mm256_sub_pd(_mm256_mul_pd(a, b), c);
+#endif
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+fms(const double a, Vector<VectorTag<AVX<double, SpT>, 4> > const &b,
+    Vector<VectorTag<AVX<double, SpT>, 4> > const &c) {
+  return fms(Vector<VectorTag<AVX<double, SpT>, 4> >(a), b, c);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+fms(Vector<VectorTag<AVX<double, SpT>, 4> > const &a, const double b,
+    Vector<VectorTag<AVX<double, SpT>, 4> > const &c) {
+  return fms(a, Vector<VectorTag<AVX<double, SpT>, 4> >(b), c);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+fnma(Vector<VectorTag<AVX<double, SpT>, 4> > const &a,
+     Vector<VectorTag<AVX<double, SpT>, 4> > const &b,
+     Vector<VectorTag<AVX<double, SpT>, 4> > const &c) {
+#if defined(__FMA__)
+  return _mm256_fnmadd_pd(a, b, c);
+#else
+  return _mm256_sub_pd(c, _mm256_mul_pd(a, b));
+#endif
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+fnma(const double a, Vector<VectorTag<AVX<double, SpT>, 4> > const &b,
+     Vector<VectorTag<AVX<double, SpT>, 4> > const &c) {
+  return fnma(Vector<VectorTag<AVX<double, SpT>, 4> >(a), b, c);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+fnma(Vector<VectorTag<AVX<double, SpT>, 4> > const &a, const double b,
+     Vector<VectorTag<AVX<double, SpT>, 4> > const &c) {
+  return fnma(a, Vector<VectorTag<AVX<double, SpT>, 4> >(b), c);
+}
+
+// Approximate 1/a: single precision estimate refined by three Newton-Raphson
+// steps. Only valid for |a| within the single precision range.
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 4> >
+reciprocal(Vector<VectorTag<AVX<double, SpT>, 4> > const &a) {
+  const Vector<VectorTag<AVX<double, SpT>, 4> > one(1.0);
+  Vector<VectorTag<AVX<double, SpT>, 4> > x(
+      _mm256_cvtps_pd(_mm_rcp_ps(_mm256_cvtpd_ps(a))));
+  x = fma(x, fnma(a, x, one), x);
+  x = fma(x, fnma(a, x, one), x);
+  x = fma(x, fnma(a, x, one), x);
+  return x;
+}
+
 } // Experimental
 } // Batched
 } // KokkosKernels
@@ -57,11 +57,29 @@ public:
 
   inline void storeAligned(value_type *p) const { _mm512_store_pd(p, _data.v); }
 
+  // Non-temporal: bypasses the caches, and needs an sfence before other
+  // threads read p
+  inline void storeStreaming(value_type *p) const {
+    _mm512_stream_pd(p, _data.v);
+  }
+
   inline void storeUnaligned(value_type *p) const {
     _mm512_storeu_pd(p, _data.v);
   }
 
   inline value_type &operator[](int i) const { return _data.d[i]; }
+
+  inline void shift_left(int num_shift) {
+    for (int i = 0; i < vector_length - num_shift; ++i) {
+      _data.d[i] = _data.d[i + num_shift];
+    }
+  }
+
+  inline void shift_right(int num_shift) {
+    for (int i = vector_length - 1; i >= num_shift; --i) {
+      _data.d[i] = _data.d[i - num_shift];
+    }
+  }
 };
 
 template <typename SpT>
@@ -236,6 +254,85 @@ operator-(Vector<VectorTag<AVX<double, SpT>, 8> > const &a) {
   return -1 * a;
 }
 
+// Fused multiply-add family: fma(a,b,c) = a*b+c, fms(a,b,c) = a*b-c,
+// fnma(a,b,c) = c-a*b.
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+fma(Vector<VectorTag<AVX<double, SpT>, 8> > const &a,
+    Vector<VectorTag<AVX<double, SpT>, 8> > const &b,
+    Vector<VectorTag<AVX<double, SpT>, 8> > const &c) {
+  return _mm512_fmadd_pd(a, b, c);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+fma(const double a, Vector<VectorTag<AVX<double, SpT>, 8> > const &b,
+    Vector<VectorTag<AVX<double, SpT>, 8> > const &c) {
+  return fma(Vector<VectorTag<AVX<double, SpT>, 8> >(a), b, c);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+fma(Vector<VectorTag<AVX<double, SpT>, 8> > const &a, const double b,
+    Vector<VectorTag<AVX<double, SpT>, 8> > const &c) {
+  return fma(a, Vector<VectorTag<AVX<double, SpT>, 8> >(b), c);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+fms(Vector<VectorTag<AVX<double, SpT>, 8> > const &a,
+    Vector<VectorTag<AVX<double, SpT>, 8> > const &b,
+    Vector<VectorTag<AVX<double, SpT>, 8> > const &c) {
+  return _mm512_fmsub_pd(a, b, c);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+fms(const double a, Vector<VectorTag<AVX<double, SpT>, 8> > const &b,
+    Vector<VectorTag<AVX<double, SpT>, 8> > const &c) {
+  return fms(Vector<VectorTag<AVX<double, SpT>, 8> >(a), b, c);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+fms(Vector<VectorTag<AVX<double, SpT>, 8> > const &a, const double b,
+    Vector<VectorTag<AVX<double, SpT>, 8> > const &c) {
+  return fms(a, Vector<VectorTag<AVX<double, SpT>, 8> >(b), c);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+fnma(Vector<VectorTag<AVX<double, SpT>, 8> > const &a,
+     Vector<VectorTag<AVX<double, SpT>, 8> > const &b,
+     Vector<VectorTag<AVX<double, SpT>, 8> > const &c) {
+  return _mm512_fnmadd_pd(a, b, c);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+fnma(const double a, Vector<VectorTag<AVX<double, SpT>, 8> > const &b,
+     Vector<VectorTag<AVX<double, SpT>, 8> > const &c) {
+  return fnma(Vector<VectorTag<AVX<double, SpT>, 8> >(a), b, c);
+}
+
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+fnma(Vector<VectorTag<AVX<double, SpT>, 8> > const &a, const double b,
+     Vector<VectorTag<AVX<double, SpT>, 8> > const &c) {
+  return fnma(a, Vector<VectorTag<AVX<double, SpT>, 8> >(b), c);
+}
+
+// Approximate 1/a: 14 bit estimate refined by two Newton-Raphson steps.
+template <typename SpT>
+inline static Vector<VectorTag<AVX<double, SpT>, 8> >
+reciprocal(Vector<VectorTag<AVX<double, SpT>, 8> > const &a) {
+  const Vector<VectorTag<AVX<double, SpT>, 8> > one(1.0);
+  Vector<VectorTag<AVX<double, SpT>, 8> > x(_mm512_rcp14_pd(a));
+  x = fma(x, fnma(a, x, one), x);
+  x = fma(x, fnma(a, x, one), x);
+  return x;
+}
+
 } // Experimental
 } // Batched
 } // KokkosKernels
@@ -85,13 +85,24 @@ public:
         [&](const int &i) { p[i] = _data[i]; });
   }
 
+  // No non-temporal stores in this version: a regular store
+  KOKKOS_INLINE_FUNCTION
+  void storeStreaming(value_type *p) const { storeAligned(p); }
+
   KOKKOS_INLINE_FUNCTION
   value_type &operator[](const int i) const { return _data[i]; }
 
   KOKKOS_INLINE_FUNCTION
   void shift_left(int num_shift) {
-    for(int i = 0; i < vector_length - 1; i++) {
-      _data[i] = _data[i + 1];
+    for(int i = 0; i < vector_length - num_shift; i++) {
+      _data[i] = _data[i + num_shift];
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void shift_right(int num_shift) {
+    for(int i = vector_length - 1; i >= num_shift; i--) {
+      _data[i] = _data[i - num_shift];
     }
   }
 };
@@ -310,6 +321,122 @@ operator/=(Vector<VectorTag<SIMD<T, SpT>, l> > &a,
   return a;
 }
 
+// Fused multiply-add family: fma(a,b,c) = a*b+c, fms(a,b,c) = a*b-c,
+// fnma(a,b,c) = c-a*b. Without FMA hardware these fall back to mul+add.
+template <typename T, typename SpT, int l>
+KOKKOS_INLINE_FUNCTION static Vector<VectorTag<SIMD<T, SpT>, l> >
+fma(Vector<VectorTag<SIMD<T, SpT>, l> > const &a,
+    Vector<VectorTag<SIMD<T, SpT>, l> > const &b,
+    Vector<VectorTag<SIMD<T, SpT>, l> > const &c) {
+  Vector<VectorTag<SIMD<T, SpT>, l> > r_val;
+  Kokkos::parallel_for(
+      Kokkos::Impl::ThreadVectorRangeBoundariesStruct<
+          int, typename VectorTag<SIMD<T, SpT>, l>::member_type>(
+          VectorTag<SIMD<T, SpT>, l>::length),
+      [&](const int &i) {
+#if defined(__FMA__)
+        r_val[i] = std::fma(a[i], b[i], c[i]);
+#else
+        r_val[i] = a[i] * b[i] + c[i];
+#endif
+      });
+  return r_val;
+}
+
+template <typename T, typename SpT, int l>
+KOKKOS_INLINE_FUNCTION static Vector<VectorTag<SIMD<T, SpT>, l> >
+fma(const typename VectorTag<SIMD<T, SpT>, l>::value_type a,
+    Vector<VectorTag<SIMD<T, SpT>, l> > const &b,
+    Vector<VectorTag<SIMD<T, SpT>, l> > const &c) {
+  return fma(Vector<VectorTag<SIMD<T, SpT>, l> >(a), b, c);
+}
+
+template <typename T, typename SpT, int l>
+KOKKOS_INLINE_FUNCTION static Vector<VectorTag<SIMD<T, SpT>, l> >
+fma(Vector<VectorTag<SIMD<T, SpT>, l> > const &a,
+    const typename VectorTag<SIMD<T, SpT>, l>::value_type b,
+    Vector<VectorTag<SIMD<T, SpT>, l> > const &c) {
+  return fma(a, Vector<VectorTag<SIMD<T, SpT>, l> >(b), c);
+}
+
+template <typename T, typename SpT, int l>
+KOKKOS_INLINE_FUNCTION static Vector<VectorTag<SIMD<T, SpT>, l> >
+fms(Vector<VectorTag<SIMD<T, SpT>, l> > const &a,
+    Vector<VectorTag<SIMD<T, SpT>, l> > const &b,
+    Vector<VectorTag<SIMD<T, SpT>, l> > const &c) {
+  Vector<VectorTag<SIMD<T, SpT>, l> > r_val;
+  Kokkos::parallel_for(
+      Kokkos::Impl::ThreadVectorRangeBoundariesStruct<
+          int, typename VectorTag<SIMD<T, SpT>, l>::member_type>(
+          VectorTag<SIMD<T, SpT>, l>::length),
+      [&](const int &i) {
+#if defined(__FMA__)
+        r_val[i] = std::fma(a[i], b[i], -c[i]);
+#else
+        r_val[i] = a[i] * b[i] - c[i];
+#endif
+      });
+  return r_val;
+}
+
+template <typename T, typename SpT, int l>
+KOKKOS_INLINE_FUNCTION static Vector<VectorTag<SIMD<T, SpT>, l> >
+fms(const typename VectorTag<SIMD<T, SpT>, l>::value_type a,
+    Vector<VectorTag<SIMD<T, SpT>, l> > const &b,
+    Vector<VectorTag<SIMD<T, SpT>, l> > const &c) {
+  return fms(Vector<VectorTag<SIMD<T, SpT>, l> >(a), b, c);
+}
+
+template <typename T, typename SpT, int l>
+KOKKOS_INLINE_FUNCTION static Vector<VectorTag<SIMD<T, SpT>, l> >
+fms(Vector<VectorTag<SIMD<T, SpT>, l> > const &a,
+    const typename VectorTag<SIMD<T, SpT>, l>::value_type b,
+    Vector<VectorTag<SIMD<T, SpT>, l> > const &c) {
+  return fms(a, Vector<VectorTag<SIMD<T, SpT>, l> >(b), c);
+}
+
+template <typename T, typename SpT, int l>
+KOKKOS_INLINE_FUNCTION static Vector<VectorTag<SIMD<T, SpT>, l> >
+fnma(Vector<VectorTag<SIMD<T, SpT>, l> > const &a,
+     Vector<VectorTag<SIMD<T, SpT>, l> > const &b,
+     Vector<VectorTag<SIMD<T, SpT>, l> > const &c) {
+  Vector<VectorTag<SIMD<T, SpT>, l> > r_val;
+  Kokkos::parallel_for(
+      Kokkos::Impl::ThreadVectorRangeBoundariesStruct<
+          int, typename VectorTag<SIMD<T, SpT>, l>::member_type>(
+          VectorTag<SIMD<T, SpT>, l>::length),
+      [&](const int &i) {
+#if defined(__FMA__)
+        r_val[i] = std::fma(-a[i], b[i], c[i]);
+#else
+        r_val[i] = c[i] - a[i] * b[i];
+#endif
+      });
+  return r_val;
+}
+
+template <typename T, typename SpT, int l>
+KOKKOS_INLINE_FUNCTION static Vector<VectorTag<SIMD<T, SpT>, l> >
+fnma(const typename VectorTag<SIMD<T, SpT>, l>::value_type a,
+     Vector<VectorTag<SIMD<T, SpT>, l> > const &b,
+     Vector<VectorTag<SIMD<T, SpT>, l> > const &c) {
+  return fnma(Vector<VectorTag<SIMD<T, SpT>, l> >(a), b, c);
+}
+
+template <typename T, typename SpT, int l>
+KOKKOS_INLINE_FUNCTION static Vector<VectorTag<SIMD<T, SpT>, l> >
+fnma(Vector<VectorTag<SIMD<T, SpT>, l> > const &a,
+     const typename VectorTag<SIMD<T, SpT>, l>::value_type b,
+     Vector<VectorTag<SIMD<T, SpT>, l> > const &c) {
+  return fnma(a, Vector<VectorTag<SIMD<T, SpT>, l> >(b), c);
+}
+
+template <typename T, typename SpT, int l>
+KOKKOS_INLINE_FUNCTION static Vector<VectorTag<SIMD<T, SpT>, l> >
+reciprocal(Vector<VectorTag<SIMD<T, SpT>, l> > const &a) {
+  return typename VectorTag<SIMD<T, SpT>, l>::value_type(1) / a;
+}
+
 } // Experimental
 } // Batched
 } // KokkosKernels
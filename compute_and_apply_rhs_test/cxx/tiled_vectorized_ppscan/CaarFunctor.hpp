@@ -15,13 +15,22 @@
 
 namespace Homme {
 
-struct CaarFunctor {
+// The level loops of the functor give each thread a tile of LEV_TILE level
+// packs per iteration instead of a single one, and the sphere operators are
+// applied to the whole tile at once (see levels_in_tile). The best tile
+// depends on the size of the L1 cache and on VECTOR_SIZE;
+// tiled_vectorized_ppscan_tiles times all of them
+template <int LEV_TILE = LEVEL_TILE> struct CaarFunctor {
   Control m_data;
   const Elements m_elements;
   const Derivative m_deriv;
 
   static constexpr Kokkos::Impl::ALL_t ALL = Kokkos::ALL;
 
+  static_assert(LEV_TILE >= 1 && LEV_TILE <= NUM_LEV,
+                "The level tile must have between 1 and NUM_LEV packs");
+  static constexpr int NUM_LEV_TILES = (NUM_LEV + LEV_TILE - 1) / LEV_TILE;
+
   CaarFunctor()
       : m_data(), m_elements(get_elements()), m_deriv(get_derivative()) {
     // Nothing to be done here
@@ -34,27 +43,42 @@ struct CaarFunctor {
     // Nothing to be done here
   }
 
+  // Calls f() with kv.ilev set to each level pack of the tile starting at
+  // kv.ilev, for the parts of the kernel that work point by point
+  template <typename Func>
+  KOKKOS_INLINE_FUNCTION void for_each_tile_level(KernelVariables &kv,
+                                                  const Func &f) const {
+    const int tile_start = kv.ilev;
+    const int tile_end = tile_start + levels_in_tile<LEV_TILE>(kv);
+    for (kv.ilev = tile_start; kv.ilev < tile_end; ++kv.ilev) {
+      f();
+    }
+    kv.ilev = tile_start;
+  }
+
   // Depends on PHI (after preq_hydrostatic), PECND
   // Modifies Ephi_grad
   // Computes \nabla (E + phi) + \nabla (P) * Rgas * T_v / P
   KOKKOS_INLINE_FUNCTION void compute_energy_grad(KernelVariables &kv) const {
-    Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NP * NP),
-                         [&](const int idx) {
-      const int igp = idx / NP;
-      const int jgp = idx % NP;
-      // Kinetic energy + PHI (geopotential energy) +
-      // PECND (potential energy?)
-      Scalar k_energy =
-          0.5 * (m_elements.m_u(kv.ie, m_data.n0, kv.ilev, igp, jgp) *
-                     m_elements.m_u(kv.ie, m_data.n0, kv.ilev, igp, jgp) +
-                 m_elements.m_v(kv.ie, m_data.n0, kv.ilev, igp, jgp) *
-                     m_elements.m_v(kv.ie, m_data.n0, kv.ilev, igp, jgp));
-      m_elements.buffers.ephi(kv.ie, kv.ilev, igp, jgp) =
-          k_energy + (m_elements.m_phi(kv.ie, kv.ilev, igp, jgp) +
-                      m_elements.m_pecnd(kv.ie, kv.ilev, igp, jgp));
+    for_each_tile_level(kv, [&]() {
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NP * NP),
+                           [&](const int idx) {
+        const int igp = idx / NP;
+        const int jgp = idx % NP;
+        // Kinetic energy + PHI (geopotential energy) +
+        // PECND (potential energy?)
+        Scalar k_energy =
+            0.5 * (m_elements.m_u(kv.ie, m_data.n0, kv.ilev, igp, jgp) *
+                       m_elements.m_u(kv.ie, m_data.n0, kv.ilev, igp, jgp) +
+                   m_elements.m_v(kv.ie, m_data.n0, kv.ilev, igp, jgp) *
+                       m_elements.m_v(kv.ie, m_data.n0, kv.ilev, igp, jgp));
+        m_elements.buffers.ephi(kv.ie, kv.ilev, igp, jgp) =
+            k_energy + (m_elements.m_phi(kv.ie, kv.ilev, igp, jgp) +
+                        m_elements.m_pecnd(kv.ie, kv.ilev, igp, jgp));
+      });
     });
 
-    gradient_sphere_update(
+    gradient_sphere_update<LEV_TILE>(
         kv, m_elements.m_dinv, m_deriv.get_dvv(),
         Homme::subview(m_elements.buffers.ephi, kv.ie),
         Homme::subview(m_elements.buffers.energy_grad, kv.ie));
@@ -63,11 +87,13 @@ struct CaarFunctor {
   // Depends on pressure, PHI, U_current, V_current, METDET,
   // D, DINV, U, V, FCOR, SPHEREMP, T_v, ETA_DPDN
   KOKKOS_INLINE_FUNCTION void compute_phase_3(KernelVariables &kv) const {
-    Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NUM_LEV),
-                         [&](const int &ilev) {
-      kv.ilev = ilev;
-      compute_eta_dpdn(kv);
-      compute_omega_p(kv);
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NUM_LEV_TILES),
+                         [&](const int &itile) {
+      kv.ilev = itile * LEV_TILE;
+      for_each_tile_level(kv, [&]() {
+        compute_eta_dpdn(kv);
+        compute_omega_p(kv);
+      });
       compute_temperature_np1(kv);
       compute_velocity_np1(kv);
       compute_dp3d_np1(kv);
@@ -78,60 +104,67 @@ struct CaarFunctor {
   // D, DINV, U, V, FCOR, SPHEREMP, T_v
   KOKKOS_INLINE_FUNCTION
   void compute_velocity_np1(KernelVariables &kv) const {
-    Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, 2 * NP * NP),
-                         [&](const int idx) {
-      const int hgp = (idx / NP) / NP;
-      const int igp = (idx / NP) % NP;
-      const int jgp = idx % NP;
-
-      m_elements.buffers.energy_grad(kv.ie, kv.ilev, hgp, igp, jgp) =
-          PhysicalConstants::Rgas *
-          (m_elements.buffers.temperature_virt(kv.ie, kv.ilev, igp, jgp) /
-           m_elements.buffers.pressure(kv.ie, kv.ilev, igp, jgp)) *
-          m_elements.buffers.pressure_grad(kv.ie, kv.ilev, hgp, igp, jgp);
+    for_each_tile_level(kv, [&]() {
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, 2 * NP * NP),
+                           [&](const int idx) {
+        const int hgp = (idx / NP) / NP;
+        const int igp = (idx / NP) % NP;
+        const int jgp = idx % NP;
+
+        m_elements.buffers.energy_grad(kv.ie, kv.ilev, hgp, igp, jgp) =
+            PhysicalConstants::Rgas *
+            (m_elements.buffers.temperature_virt(kv.ie, kv.ilev, igp, jgp) /
+             m_elements.buffers.pressure(kv.ie, kv.ilev, igp, jgp)) *
+            m_elements.buffers.pressure_grad(kv.ie, kv.ilev, hgp, igp, jgp);
+      });
     });
 
     compute_energy_grad(kv);
 
-    vorticity_sphere(kv, m_elements.m_d, m_elements.m_metdet, m_deriv.get_dvv(),
-                     Homme::subview(m_elements.m_u, kv.ie, m_data.n0),
-                     Homme::subview(m_elements.m_v, kv.ie, m_data.n0),
-                     Homme::subview(m_elements.buffers.vorticity, kv.ie));
-
-    Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NP * NP),
-                         [&](const int idx) {
-      const int igp = idx / NP;
-      const int jgp = idx % NP;
-
-      // Recycle vort to contain (fcor+vort)
-      m_elements.buffers.vorticity(kv.ie, kv.ilev, igp, jgp) +=
-          m_elements.m_fcor(kv.ie, igp, jgp);
-
-      m_elements.buffers.energy_grad(kv.ie, kv.ilev, 0, igp, jgp) *= -1;
-      m_elements.buffers.energy_grad(kv.ie, kv.ilev, 0, igp, jgp) +=
-          /* v_vadv(igp, jgp) + */ m_elements.m_v(kv.ie, m_data.n0, kv.ilev,
-                                                  igp, jgp) *
-          m_elements.buffers.vorticity(kv.ie, kv.ilev, igp, jgp);
-      m_elements.buffers.energy_grad(kv.ie, kv.ilev, 1, igp, jgp) *= -1;
-      m_elements.buffers.energy_grad(kv.ie, kv.ilev, 1, igp, jgp) +=
-          /* v_vadv(igp, jgp) + */ -m_elements.m_u(kv.ie, m_data.n0, kv.ilev,
-                                                   igp, jgp) *
-          m_elements.buffers.vorticity(kv.ie, kv.ilev, igp, jgp);
-
-      m_elements.buffers.energy_grad(kv.ie, kv.ilev, 0, igp, jgp) *= m_data.dt;
-      m_elements.buffers.energy_grad(kv.ie, kv.ilev, 0, igp, jgp) +=
-          m_elements.m_u(kv.ie, m_data.nm1, kv.ilev, igp, jgp);
-      m_elements.buffers.energy_grad(kv.ie, kv.ilev, 1, igp, jgp) *= m_data.dt;
-      m_elements.buffers.energy_grad(kv.ie, kv.ilev, 1, igp, jgp) +=
-          m_elements.m_v(kv.ie, m_data.nm1, kv.ilev, igp, jgp);
-
-      // Velocity at np1 = spheremp * buffer
-      m_elements.m_u(kv.ie, m_data.np1, kv.ilev, igp, jgp) =
-          m_elements.m_spheremp(kv.ie, igp, jgp) *
-          m_elements.buffers.energy_grad(kv.ie, kv.ilev, 0, igp, jgp);
-      m_elements.m_v(kv.ie, m_data.np1, kv.ilev, igp, jgp) =
-          m_elements.m_spheremp(kv.ie, igp, jgp) *
-          m_elements.buffers.energy_grad(kv.ie, kv.ilev, 1, igp, jgp);
+    vorticity_sphere<LEV_TILE>(
+        kv, m_elements.m_d, m_elements.m_metdet, m_deriv.get_dvv(),
+        Homme::subview(m_elements.m_u, kv.ie, m_data.n0),
+        Homme::subview(m_elements.m_v, kv.ie, m_data.n0),
+        Homme::subview(m_elements.buffers.vorticity, kv.ie));
+
+    for_each_tile_level(kv, [&]() {
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NP * NP),
+                           [&](const int idx) {
+        const int igp = idx / NP;
+        const int jgp = idx % NP;
+
+        // Recycle vort to contain (fcor+vort)
+        m_elements.buffers.vorticity(kv.ie, kv.ilev, igp, jgp) +=
+            m_elements.m_fcor(kv.ie, igp, jgp);
+
+        m_elements.buffers.energy_grad(kv.ie, kv.ilev, 0, igp, jgp) *= -1;
+        m_elements.buffers.energy_grad(kv.ie, kv.ilev, 0, igp, jgp) +=
+            /* v_vadv(igp, jgp) + */ m_elements.m_v(kv.ie, m_data.n0, kv.ilev,
+                                                    igp, jgp) *
+            m_elements.buffers.vorticity(kv.ie, kv.ilev, igp, jgp);
+        m_elements.buffers.energy_grad(kv.ie, kv.ilev, 1, igp, jgp) *= -1;
+        m_elements.buffers.energy_grad(kv.ie, kv.ilev, 1, igp, jgp) +=
+            /* v_vadv(igp, jgp) + */ -m_elements.m_u(kv.ie, m_data.n0,
+                                                     kv.ilev, igp, jgp) *
+            m_elements.buffers.vorticity(kv.ie, kv.ilev, igp, jgp);
+
+        m_elements.buffers.energy_grad(kv.ie, kv.ilev, 0, igp, jgp) *=
+            m_data.dt;
+        m_elements.buffers.energy_grad(kv.ie, kv.ilev, 0, igp, jgp) +=
+            m_elements.m_u(kv.ie, m_data.nm1, kv.ilev, igp, jgp);
+        m_elements.buffers.energy_grad(kv.ie, kv.ilev, 1, igp, jgp) *=
+            m_data.dt;
+        m_elements.buffers.energy_grad(kv.ie, kv.ilev, 1, igp, jgp) +=
+            m_elements.m_v(kv.ie, m_data.nm1, kv.ilev, igp, jgp);
+
+        // Velocity at np1 = spheremp * buffer
+        m_elements.m_u(kv.ie, m_data.np1, kv.ilev, igp, jgp) =
+            m_elements.m_spheremp(kv.ie, igp, jgp) *
+            m_elements.buffers.energy_grad(kv.ie, kv.ilev, 0, igp, jgp);
+        m_elements.m_v(kv.ie, m_data.np1, kv.ilev, igp, jgp) =
+            m_elements.m_spheremp(kv.ie, igp, jgp) *
+            m_elements.buffers.energy_grad(kv.ie, kv.ilev, 1, igp, jgp);
+      });
     });
   }
 
@@ -217,12 +250,13 @@ struct CaarFunctor {
   // omega_p
   KOKKOS_INLINE_FUNCTION
   void preq_omega_ps(KernelVariables &kv) const {
-    Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NUM_LEV),
-                         [&](const int ilev) {
-      kv.ilev = ilev;
-      gradient_sphere(kv, m_elements.m_dinv, m_deriv.get_dvv(),
-                      Homme::subview(m_elements.buffers.pressure, kv.ie),
-                      Homme::subview(m_elements.buffers.pressure_grad, kv.ie));
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NUM_LEV_TILES),
+                         [&](const int itile) {
+      kv.ilev = itile * LEV_TILE;
+      gradient_sphere<LEV_TILE>(
+          kv, m_elements.m_dinv, m_deriv.get_dvv(),
+          Homme::subview(m_elements.buffers.pressure, kv.ie),
+          Homme::subview(m_elements.buffers.pressure_grad, kv.ie));
     });
 
     ExecViewUnmanaged<Real[NP][NP]> integration = kv.scratch_mem_1;
@@ -378,34 +412,36 @@ struct CaarFunctor {
   // Requires NUM_LEV * 5 * NP * NP
   KOKKOS_INLINE_FUNCTION
   void compute_div_vdp(KernelVariables &kv) const {
-    Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NP * NP),
-                         [&](const int idx) {
-      const int igp = idx / NP;
-      const int jgp = idx % NP;
+    for_each_tile_level(kv, [&]() {
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NP * NP),
+                           [&](const int idx) {
+        const int igp = idx / NP;
+        const int jgp = idx % NP;
 
-      m_elements.buffers.vdp(kv.ie, kv.ilev, 0, igp, jgp) =
-          m_elements.m_u(kv.ie, m_data.n0, kv.ilev, igp, jgp) *
-          m_elements.m_dp3d(kv.ie, m_data.n0, kv.ilev, igp, jgp);
+        m_elements.buffers.vdp(kv.ie, kv.ilev, 0, igp, jgp) =
+            m_elements.m_u(kv.ie, m_data.n0, kv.ilev, igp, jgp) *
+            m_elements.m_dp3d(kv.ie, m_data.n0, kv.ilev, igp, jgp);
 
-      m_elements.buffers.vdp(kv.ie, kv.ilev, 1, igp, jgp) =
-          m_elements.m_v(kv.ie, m_data.n0, kv.ilev, igp, jgp) *
-          m_elements.m_dp3d(kv.ie, m_data.n0, kv.ilev, igp, jgp);
+        m_elements.buffers.vdp(kv.ie, kv.ilev, 1, igp, jgp) =
+            m_elements.m_v(kv.ie, m_data.n0, kv.ilev, igp, jgp) *
+            m_elements.m_dp3d(kv.ie, m_data.n0, kv.ilev, igp, jgp);
 
-      m_elements.m_derived_un0(kv.ie, kv.ilev, igp, jgp) =
-          m_elements.m_derived_un0(kv.ie, kv.ilev, igp, jgp) +
-          m_data.eta_ave_w *
-              m_elements.buffers.vdp(kv.ie, kv.ilev, 0, igp, jgp);
+        m_elements.m_derived_un0(kv.ie, kv.ilev, igp, jgp) =
+            m_elements.m_derived_un0(kv.ie, kv.ilev, igp, jgp) +
+            m_data.eta_ave_w *
+                m_elements.buffers.vdp(kv.ie, kv.ilev, 0, igp, jgp);
 
-      m_elements.m_derived_vn0(kv.ie, kv.ilev, igp, jgp) =
-          m_elements.m_derived_vn0(kv.ie, kv.ilev, igp, jgp) +
-          m_data.eta_ave_w *
-              m_elements.buffers.vdp(kv.ie, kv.ilev, 1, igp, jgp);
+        m_elements.m_derived_vn0(kv.ie, kv.ilev, igp, jgp) =
+            m_elements.m_derived_vn0(kv.ie, kv.ilev, igp, jgp) +
+            m_data.eta_ave_w *
+                m_elements.buffers.vdp(kv.ie, kv.ilev, 1, igp, jgp);
+      });
     });
 
-    divergence_sphere(kv, m_elements.m_dinv, m_elements.m_metdet,
-                      m_deriv.get_dvv(),
-                      Homme::subview(m_elements.buffers.vdp, kv.ie),
-                      Homme::subview(m_elements.buffers.div_vdp, kv.ie));
+    divergence_sphere<LEV_TILE>(
+        kv, m_elements.m_dinv, m_elements.m_metdet, m_deriv.get_dvv(),
+        Homme::subview(m_elements.buffers.vdp, kv.ie),
+        Homme::subview(m_elements.buffers.div_vdp, kv.ie));
   }
 
   // Depends on T_current, DERIVE_UN0, DERIVED_VN0, METDET,
@@ -414,17 +450,19 @@ struct CaarFunctor {
   KOKKOS_INLINE_FUNCTION
   void compute_temperature_div_vdp(KernelVariables &kv) const {
     if (m_data.qn0 == -1) {
-      Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NUM_LEV),
-                           [&](const int ilev) {
-        kv.ilev = ilev;
-        compute_temperature_no_tracers_helper(kv);
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NUM_LEV_TILES),
+                           [&](const int itile) {
+        kv.ilev = itile * LEV_TILE;
+        for_each_tile_level(
+            kv, [&]() { compute_temperature_no_tracers_helper(kv); });
         compute_div_vdp(kv);
       });
     } else {
-      Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NUM_LEV),
-                           [&](const int ilev) {
-        kv.ilev = ilev;
-        compute_temperature_tracers_helper(kv);
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NUM_LEV_TILES),
+                           [&](const int itile) {
+        kv.ilev = itile * LEV_TILE;
+        for_each_tile_level(kv,
+                            [&]() { compute_temperature_tracers_helper(kv); });
         compute_div_vdp(kv);
       });
     }
@@ -449,33 +487,38 @@ struct CaarFunctor {
   KOKKOS_INLINE_FUNCTION
   void compute_temperature_np1(KernelVariables &kv) const {
 
-    gradient_sphere(kv, m_elements.m_dinv, m_deriv.get_dvv(),
-                    Homme::subview(m_elements.m_t, kv.ie, m_data.n0),
-                    Homme::subview(m_elements.buffers.temperature_grad, kv.ie));
+    gradient_sphere<LEV_TILE>(
+        kv, m_elements.m_dinv, m_deriv.get_dvv(),
+        Homme::subview(m_elements.m_t, kv.ie, m_data.n0),
+        Homme::subview(m_elements.buffers.temperature_grad, kv.ie));
 
-    Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NP * NP),
-                         [&](const int idx) {
-      const int igp = idx / NP;
-      const int jgp = idx % NP;
+    for_each_tile_level(kv, [&]() {
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NP * NP),
+                           [&](const int idx) {
+        const int igp = idx / NP;
+        const int jgp = idx % NP;
 
-      Scalar vgrad_t =
-          m_elements.m_u(kv.ie, m_data.n0, kv.ilev, igp, jgp) *
-              m_elements.buffers.temperature_grad(kv.ie, kv.ilev, 0, igp, jgp) +
-          m_elements.m_v(kv.ie, m_data.n0, kv.ilev, igp, jgp) *
-              m_elements.buffers.temperature_grad(kv.ie, kv.ilev, 1, igp, jgp);
-
-      // vgrad_t + kappa * T_v * omega_p
-      Scalar ttens;
-      ttens =
-          -vgrad_t +
-          PhysicalConstants::kappa *
-              m_elements.buffers.temperature_virt(kv.ie, kv.ilev, igp, jgp) *
-              m_elements.buffers.omega_p(kv.ie, kv.ilev, igp, jgp);
-
-      Scalar temp_np1 = ttens * m_data.dt +
-                        m_elements.m_t(kv.ie, m_data.nm1, kv.ilev, igp, jgp);
-      temp_np1 *= m_elements.m_spheremp(kv.ie, igp, jgp);
-      m_elements.m_t(kv.ie, m_data.np1, kv.ilev, igp, jgp) = temp_np1;
+        Scalar vgrad_t =
+            m_elements.m_u(kv.ie, m_data.n0, kv.ilev, igp, jgp) *
+                m_elements.buffers.temperature_grad(kv.ie, kv.ilev, 0, igp,
+                                                    jgp) +
+            m_elements.m_v(kv.ie, m_data.n0, kv.ilev, igp, jgp) *
+                m_elements.buffers.temperature_grad(kv.ie, kv.ilev, 1, igp,
+                                                    jgp);
+
+        // vgrad_t + kappa * T_v * omega_p
+        Scalar ttens;
+        ttens =
+            -vgrad_t +
+            PhysicalConstants::kappa *
+                m_elements.buffers.temperature_virt(kv.ie, kv.ilev, igp, jgp) *
+                m_elements.buffers.omega_p(kv.ie, kv.ilev, igp, jgp);
+
+        Scalar temp_np1 = ttens * m_data.dt +
+                          m_elements.m_t(kv.ie, m_data.nm1, kv.ilev, igp, jgp);
+        temp_np1 *= m_elements.m_spheremp(kv.ie, igp, jgp);
+        m_elements.m_t(kv.ie, m_data.np1, kv.ilev, igp, jgp) = temp_np1;
+      });
     });
   }
 
@@ -483,14 +526,17 @@ struct CaarFunctor {
   // Modifies DERIVED_UN0, DERIVED_VN0, OMEGA_P, T, and DP3D
   KOKKOS_INLINE_FUNCTION
   void compute_dp3d_np1(KernelVariables &kv) const {
-    Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NP * NP),
-                         [&](const int idx) {
-      const int igp = idx / NP;
-      const int jgp = idx % NP;
-      Scalar tmp = m_elements.m_dp3d(kv.ie, m_data.nm1, kv.ilev, igp, jgp);
-      tmp -= m_data.dt * m_elements.buffers.div_vdp(kv.ie, kv.ilev, igp, jgp);
-      m_elements.m_dp3d(kv.ie, m_data.np1, kv.ilev, igp, jgp) =
-          m_elements.m_spheremp(kv.ie, igp, jgp) * tmp;
+    for_each_tile_level(kv, [&]() {
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NP * NP),
+                           [&](const int idx) {
+        const int igp = idx / NP;
+        const int jgp = idx % NP;
+        Scalar tmp = m_elements.m_dp3d(kv.ie, m_data.nm1, kv.ilev, igp, jgp);
+        tmp -= m_data.dt *
+               m_elements.buffers.div_vdp(kv.ie, kv.ilev, igp, jgp);
+        m_elements.m_dp3d(kv.ie, m_data.np1, kv.ilev, igp, jgp) =
+            m_elements.m_spheremp(kv.ie, igp, jgp) * tmp;
+      });
     });
   }
 
@@ -0,0 +1,103 @@
+#ifndef HOMMEXX_CUBED_SPHERE_HPP
+#define HOMMEXX_CUBED_SPHERE_HPP
+
+#include "Types.hpp"
+
+#include <vector>
+
+namespace Homme {
+
+/* Equiangular cubed sphere with ne x ne spectral elements on each of its 6
+ * faces, with the GLL derivative matrix, the metric terms of every element,
+ * the neighbours of every element and a balanced initial state.
+ *
+ * Everything is stored with the ordering of the F90 arrays, so that it can be
+ * loaded with Derivative::init, Elements::init_2d and
+ * Elements::pull_from_f90_pointers just like data coming from HOMME.
+ * Elements are numbered face by face and row by row within a face; a
+ * benchmark with fewer elements takes the first ones, like an MPI rank. */
+class CubedSphere {
+public:
+  // Directions of the neighbours, as in HOMME's edge buffers. Within an
+  // element, jgp runs from west to east and igp from south to north
+  enum Direction {
+    WEST = 0,
+    EAST,
+    SOUTH,
+    NORTH,
+    SWEST,
+    SEAST,
+    NWEST,
+    NEAST,
+    NUM_DIRECTIONS
+  };
+
+  // Builds the grid, the metric terms and the connectivity
+  explicit CubedSphere(const int ne);
+
+  // Fills the state of the first num_elems elements with a steady zonal flow
+  // in hydrostatic and gradient wind balance with the surface geopotential
+  // (a 3d isothermal version of Williamson et al.'s test case 2)
+  void init_state(const int num_elems);
+
+  int ne() const { return m_ne; }
+  int num_elems() const { return 6 * m_ne * m_ne; }
+  int num_unique_points() const { return m_num_unique_points; }
+
+  // GLL points and weights on [-1, 1]
+  Real m_gll_points[NP];
+  Real m_gll_weights[NP];
+  // dvv[igp][jgp] is the derivative of the jgp-th Lagrange polynomial at the
+  // igp-th point (the F90 Dvv transposed, i.e. the F90 memory of Dvv)
+  std::vector<Real> m_dvv;
+
+  // Geometry, for all the elements, as expected by Elements::init_2d.
+  // D maps contravariant components on the reference element to the
+  // eastward and northward components on the unit sphere
+  std::vector<Real> m_d;
+  std::vector<Real> m_dinv;
+  std::vector<Real> m_fcor;
+  std::vector<Real> m_spheremp;
+  std::vector<Real> m_metdet;
+  std::vector<Real> m_phis;
+  std::vector<Real> m_lat;
+  std::vector<Real> m_lon;
+
+  // The NUM_DIRECTIONS neighbours of each element; -1 for the missing
+  // corner neighbour at the 8 vertices of the cube
+  std::vector<int> m_neighbors;
+  // Unique id of each GLL point, shared by all the elements that contain it
+  std::vector<int> m_gids;
+
+  // Vertical coordinate of the state: p = hybrid_a * ps0 + hybrid_b * ps,
+  // with hybrid_b evenly spaced from 0 at the top to 1 at the surface
+  Real m_ps0;
+  std::vector<Real> m_hybrid_a;
+
+  // State of the first num_elems elements, as expected by
+  // Elements::pull_from_f90_pointers (all the time levels are the same)
+  std::vector<Real> m_state_v;
+  std::vector<Real> m_state_t;
+  std::vector<Real> m_state_dp3d;
+  std::vector<Real> m_derived_phi;
+  std::vector<Real> m_derived_pecnd;
+  std::vector<Real> m_derived_omega_p;
+  std::vector<Real> m_derived_v;
+  std::vector<Real> m_derived_eta_dot_dpdn;
+  std::vector<Real> m_state_qdp;
+
+private:
+  void init_gll();
+  void init_geometry();
+  void init_connectivity();
+
+  // Reference coordinate x = tan(alpha) of the g-th GLL point along a face
+  Real face_coordinate(const int g) const;
+
+  int m_ne;
+  int m_num_unique_points;
+};
+
+} // namespace Homme
+
+#endif // HOMMEXX_CUBED_SPHERE_HPP
@@ -8,6 +8,10 @@ namespace Homme
 
 struct PhysicalConstants
 {
+  static constexpr Real pi            = 3.141592653589793238462643383279;
+  static constexpr Real rearth        = 6.376e6;
+  static constexpr Real omega         = 7.292e-5;
+  static constexpr Real p0            = 100000.0;
   static constexpr Real Rwater_vapor  = 461.5;
   static constexpr Real Cpwater_vapor = 1870.0;
   static constexpr Real Rgas          = 287.04;
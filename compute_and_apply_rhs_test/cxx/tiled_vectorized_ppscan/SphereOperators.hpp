@@ -218,26 +218,44 @@ KOKKOS_INLINE_FUNCTION void laplace_wk_sl(
 // ================ MULTI-LEVEL IMPLEMENTATION =========================== //
 
 
+// The operators below work on a tile of LEV_TILE level packs starting at
+// kv.ilev, so the dvv rows and the metric terms they load at a point are
+// reused by all the packs of the tile. The last tile of an element is shorter
+// when LEV_TILE does not divide NUM_LEV
+template <int LEV_TILE>
+KOKKOS_INLINE_FUNCTION int levels_in_tile(const KernelVariables &kv) {
+  return kv.ilev + LEV_TILE <= NUM_LEV ? LEV_TILE : NUM_LEV - kv.ilev;
+}
+
+template <int LEV_TILE = 1>
 KOKKOS_INLINE_FUNCTION void
 gradient_sphere(const KernelVariables &kv,
                 ExecViewUnmanaged<const Real * [2][2][NP][NP]> dinv,
                 ExecViewUnmanaged<const Real[NP][NP]> dvv,
                 ExecViewUnmanaged<const Scalar[NUM_LEV]   [NP][NP]> scalar,
                 ExecViewUnmanaged<      Scalar[NUM_LEV][2][NP][NP]> grad_s) {
+  const int num_levels = levels_in_tile<LEV_TILE>(kv);
   constexpr int contra_iters = NP * NP;
   // TODO: Use scratch space for this
-  Scalar temp_v[2][NP][NP];
+  Scalar temp_v[LEV_TILE][2][NP][NP];
   Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, contra_iters),
                        [&](const int loop_idx) {
     const int igp = loop_idx / NP;
     const int jgp = loop_idx % NP;
-    Scalar dsdx, dsdy;
+    Real dvv_j[NP];
     for (int kgp = 0; kgp < NP; ++kgp) {
-      dsdx += dvv(jgp, kgp) * scalar(kv.ilev, igp, kgp);
-      dsdy += dvv(jgp, kgp) * scalar(kv.ilev, kgp, igp);
+      dvv_j[kgp] = dvv(jgp, kgp);
+    }
+    for (int itile = 0; itile < num_levels; ++itile) {
+      const int ilev = kv.ilev + itile;
+      Scalar dsdx, dsdy;
+      for (int kgp = 0; kgp < NP; ++kgp) {
+        dsdx += dvv_j[kgp] * scalar(ilev, igp, kgp);
+        dsdy += dvv_j[kgp] * scalar(ilev, kgp, igp);
+      }
+      temp_v[itile][0][igp][jgp] = dsdx * PhysicalConstants::rrearth;
+      temp_v[itile][1][jgp][igp] = dsdy * PhysicalConstants::rrearth;
     }
-    temp_v[0][igp][jgp] = dsdx * PhysicalConstants::rrearth;
-    temp_v[1][jgp][igp] = dsdy * PhysicalConstants::rrearth;
   });
 
   constexpr int grad_iters = NP * NP;
@@ -245,30 +263,49 @@ gradient_sphere(const KernelVariables &kv,
                        [&](const int loop_idx) {
     const int igp = loop_idx / NP;
     const int jgp = loop_idx % NP;
-    grad_s(kv.ilev, 0, igp, jgp) = dinv(kv.ie, 0, 0, igp, jgp) * temp_v[0][igp][jgp] + dinv(kv.ie, 0, 1, igp, jgp) * temp_v[1][igp][jgp];
-    grad_s(kv.ilev, 1, igp, jgp) = dinv(kv.ie, 1, 0, igp, jgp) * temp_v[0][igp][jgp] + dinv(kv.ie, 1, 1, igp, jgp) * temp_v[1][igp][jgp];
+    const Real dinv_00 = dinv(kv.ie, 0, 0, igp, jgp);
+    const Real dinv_01 = dinv(kv.ie, 0, 1, igp, jgp);
+    const Real dinv_10 = dinv(kv.ie, 1, 0, igp, jgp);
+    const Real dinv_11 = dinv(kv.ie, 1, 1, igp, jgp);
+    for (int itile = 0; itile < num_levels; ++itile) {
+      const int ilev = kv.ilev + itile;
+      grad_s(ilev, 0, igp, jgp) = dinv_00 * temp_v[itile][0][igp][jgp] +
+                                  dinv_01 * temp_v[itile][1][igp][jgp];
+      grad_s(ilev, 1, igp, jgp) = dinv_10 * temp_v[itile][0][igp][jgp] +
+                                  dinv_11 * temp_v[itile][1][igp][jgp];
+    }
   });
 }
 
+template <int LEV_TILE = 1>
 KOKKOS_INLINE_FUNCTION void gradient_sphere_update(
     KernelVariables &kv,
     ExecViewUnmanaged<const Real * [2][2][NP][NP]> dinv,
     ExecViewUnmanaged<const Real[NP][NP]> dvv,
     ExecViewUnmanaged<const Scalar[NUM_LEV]   [NP][NP]> scalar,
     ExecViewUnmanaged<      Scalar[NUM_LEV][2][NP][NP]> grad_s) {
+  const int num_levels = levels_in_tile<LEV_TILE>(kv);
   constexpr int contra_iters = NP * NP;
-  Scalar temp_v[2][NP][NP];
+  Scalar temp_v[LEV_TILE][2][NP][NP];
   Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, contra_iters),
                        [&](const int loop_idx) {
     const int igp = loop_idx / NP;
     const int jgp = loop_idx % NP;
-    Scalar dsdx, dsdy;
+    Real dvv_i[NP], dvv_j[NP];
     for (int kgp = 0; kgp < NP; ++kgp) {
-      dsdx += dvv(jgp, kgp) * scalar(kv.ilev, igp, kgp);
-      dsdy += dvv(igp, kgp) * scalar(kv.ilev, kgp, jgp);
+      dvv_i[kgp] = dvv(igp, kgp);
+      dvv_j[kgp] = dvv(jgp, kgp);
+    }
+    for (int itile = 0; itile < num_levels; ++itile) {
+      const int ilev = kv.ilev + itile;
+      Scalar dsdx, dsdy;
+      for (int kgp = 0; kgp < NP; ++kgp) {
+        dsdx += dvv_j[kgp] * scalar(ilev, igp, kgp);
+        dsdy += dvv_i[kgp] * scalar(ilev, kgp, jgp);
+      }
+      temp_v[itile][0][igp][jgp] = dsdx * PhysicalConstants::rrearth;
+      temp_v[itile][1][igp][jgp] = dsdy * PhysicalConstants::rrearth;
     }
-    temp_v[0][igp][jgp] = dsdx * PhysicalConstants::rrearth;
-    temp_v[1][igp][jgp] = dsdy * PhysicalConstants::rrearth;
   });
 
   constexpr int grad_iters = NP * NP;
@@ -276,11 +313,21 @@ KOKKOS_INLINE_FUNCTION void gradient_sphere_update(
                        [&](const int loop_idx) {
     const int igp = loop_idx / NP;
     const int jgp = loop_idx % NP;
-    grad_s(kv.ilev, 0, igp, jgp) += dinv(kv.ie, 0, 0, igp, jgp) * temp_v[0][igp][jgp] + dinv(kv.ie, 0, 1, igp, jgp) * temp_v[1][igp][jgp];
-    grad_s(kv.ilev, 1, igp, jgp) += dinv(kv.ie, 1, 0, igp, jgp) * temp_v[0][igp][jgp] + dinv(kv.ie, 1, 1, igp, jgp) * temp_v[1][igp][jgp];
+    const Real dinv_00 = dinv(kv.ie, 0, 0, igp, jgp);
+    const Real dinv_01 = dinv(kv.ie, 0, 1, igp, jgp);
+    const Real dinv_10 = dinv(kv.ie, 1, 0, igp, jgp);
+    const Real dinv_11 = dinv(kv.ie, 1, 1, igp, jgp);
+    for (int itile = 0; itile < num_levels; ++itile) {
+      const int ilev = kv.ilev + itile;
+      grad_s(ilev, 0, igp, jgp) += dinv_00 * temp_v[itile][0][igp][jgp] +
+                                   dinv_01 * temp_v[itile][1][igp][jgp];
+      grad_s(ilev, 1, igp, jgp) += dinv_10 * temp_v[itile][0][igp][jgp] +
+                                   dinv_11 * temp_v[itile][1][igp][jgp];
+    }
   });
 }
 
+template <int LEV_TILE = 1>
 KOKKOS_INLINE_FUNCTION void
 divergence_sphere(const KernelVariables &kv,
                   ExecViewUnmanaged<const Real * [2][2][NP][NP]> dinv,
@@ -288,14 +335,25 @@ divergence_sphere(const KernelVariables &kv,
                   ExecViewUnmanaged<const Real[NP][NP]> dvv,
                   ExecViewUnmanaged<const Scalar[NUM_LEV][2][NP][NP]> v,
                   ExecViewUnmanaged<      Scalar[NUM_LEV]   [NP][NP]> div_v) {
+  const int num_levels = levels_in_tile<LEV_TILE>(kv);
   constexpr int contra_iters = NP * NP;
-  Scalar gv[2][NP][NP];
+  Scalar gv[LEV_TILE][2][NP][NP];
   Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, contra_iters),
                        [&](const int loop_idx) {
     const int igp = loop_idx / NP;
     const int jgp = loop_idx % NP;
-    gv[0][igp][jgp] = (dinv(kv.ie, 0, 0, igp, jgp) * v(kv.ilev, 0, igp, jgp) + dinv(kv.ie, 1, 0, igp, jgp) * v(kv.ilev, 1, igp, jgp)) * metdet(kv.ie, igp, jgp);
-    gv[1][igp][jgp] = (dinv(kv.ie, 0, 1, igp, jgp) * v(kv.ilev, 0, igp, jgp) + dinv(kv.ie, 1, 1, igp, jgp) * v(kv.ilev, 1, igp, jgp)) * metdet(kv.ie, igp, jgp);
+    const Real dinv_00 = dinv(kv.ie, 0, 0, igp, jgp);
+    const Real dinv_01 = dinv(kv.ie, 0, 1, igp, jgp);
+    const Real dinv_10 = dinv(kv.ie, 1, 0, igp, jgp);
+    const Real dinv_11 = dinv(kv.ie, 1, 1, igp, jgp);
+    const Real metdet_ij = metdet(kv.ie, igp, jgp);
+    for (int itile = 0; itile < num_levels; ++itile) {
+      const int ilev = kv.ilev + itile;
+      gv[itile][0][igp][jgp] = (dinv_00 * v(ilev, 0, igp, jgp) +
+                                dinv_10 * v(ilev, 1, igp, jgp)) * metdet_ij;
+      gv[itile][1][igp][jgp] = (dinv_01 * v(ilev, 0, igp, jgp) +
+                                dinv_11 * v(ilev, 1, igp, jgp)) * metdet_ij;
+    }
   });
 
   constexpr int div_iters = NP * NP;
@@ -303,12 +361,21 @@ divergence_sphere(const KernelVariables &kv,
                        [&](const int loop_idx) {
     const int igp = loop_idx / NP;
     const int jgp = loop_idx % NP;
-    Scalar dudx, dvdy;
+    Real dvv_i[NP], dvv_j[NP];
     for (int kgp = 0; kgp < NP; ++kgp) {
-      dudx += dvv(jgp, kgp) * gv[0][igp][kgp];
-      dvdy += dvv(igp, kgp) * gv[1][kgp][jgp];
+      dvv_i[kgp] = dvv(igp, kgp);
+      dvv_j[kgp] = dvv(jgp, kgp);
+    }
+    const Real rmetdet =
+        1.0 / metdet(kv.ie, igp, jgp) * PhysicalConstants::rrearth;
+    for (int itile = 0; itile < num_levels; ++itile) {
+      Scalar dudx, dvdy;
+      for (int kgp = 0; kgp < NP; ++kgp) {
+        dudx += dvv_j[kgp] * gv[itile][0][igp][kgp];
+        dvdy += dvv_i[kgp] * gv[itile][1][kgp][jgp];
+      }
+      div_v(kv.ilev + itile, igp, jgp) = (dudx + dvdy) * rmetdet;
     }
-    div_v(kv.ilev, igp, jgp) = (dudx + dvdy) * (1.0 / metdet(kv.ie, igp, jgp) * PhysicalConstants::rrearth);
   });
 }
 
@@ -348,6 +415,7 @@ divergence_sphere_update(const KernelVariables &kv,
   });
 }
 
+template <int LEV_TILE = 1>
 KOKKOS_INLINE_FUNCTION void
 vorticity_sphere(const KernelVariables &kv,
                  ExecViewUnmanaged<const Real * [2][2][NP][NP]> d,
@@ -356,14 +424,24 @@ vorticity_sphere(const KernelVariables &kv,
                  ExecViewUnmanaged<const Scalar[NUM_LEV][NP][NP]> u,
                  ExecViewUnmanaged<const Scalar[NUM_LEV][NP][NP]> v,
                  ExecViewUnmanaged<      Scalar[NUM_LEV][NP][NP]> vort) {
+  const int num_levels = levels_in_tile<LEV_TILE>(kv);
   constexpr int covar_iters = NP * NP;
-  Scalar vcov[2][NP][NP];
+  Scalar vcov[LEV_TILE][2][NP][NP];
   Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, covar_iters),
                        [&](const int loop_idx) {
     const int igp = loop_idx / NP;
     const int jgp = loop_idx % NP;
-    vcov[0][igp][jgp] = d(kv.ie, 0, 0, igp, jgp) * u(kv.ilev, igp, jgp) + d(kv.ie, 0, 1, igp, jgp) * v(kv.ilev, igp, jgp);
-    vcov[1][igp][jgp] = d(kv.ie, 1, 0, igp, jgp) * u(kv.ilev, igp, jgp) + d(kv.ie, 1, 1, igp, jgp) * v(kv.ilev, igp, jgp);
+    const Real d_00 = d(kv.ie, 0, 0, igp, jgp);
+    const Real d_01 = d(kv.ie, 0, 1, igp, jgp);
+    const Real d_10 = d(kv.ie, 1, 0, igp, jgp);
+    const Real d_11 = d(kv.ie, 1, 1, igp, jgp);
+    for (int itile = 0; itile < num_levels; ++itile) {
+      const int ilev = kv.ilev + itile;
+      vcov[itile][0][igp][jgp] =
+          d_00 * u(ilev, igp, jgp) + d_01 * v(ilev, igp, jgp);
+      vcov[itile][1][igp][jgp] =
+          d_10 * u(ilev, igp, jgp) + d_11 * v(ilev, igp, jgp);
+    }
   });
 
   constexpr int vort_iters = NP * NP;
@@ -371,13 +449,21 @@ vorticity_sphere(const KernelVariables &kv,
                        [&](const int loop_idx) {
     const int igp = loop_idx / NP;
     const int jgp = loop_idx % NP;
-    Scalar dudy, dvdx;
+    Real dvv_i[NP], dvv_j[NP];
     for (int kgp = 0; kgp < NP; ++kgp) {
-      dvdx += dvv(jgp, kgp) * vcov[1][igp][kgp];
-      dudy += dvv(igp, kgp) * vcov[0][kgp][jgp];
+      dvv_i[kgp] = dvv(igp, kgp);
+      dvv_j[kgp] = dvv(jgp, kgp);
+    }
+    const Real rmetdet =
+        (1.0 / metdet(kv.ie, igp, jgp)) * PhysicalConstants::rrearth;
+    for (int itile = 0; itile < num_levels; ++itile) {
+      Scalar dudy, dvdx;
+      for (int kgp = 0; kgp < NP; ++kgp) {
+        dvdx += dvv_j[kgp] * vcov[itile][1][igp][kgp];
+        dudy += dvv_i[kgp] * vcov[itile][0][kgp][jgp];
+      }
+      vort(kv.ilev + itile, igp, jgp) = (dvdx - dudy) * rmetdet;
     }
-    vort(kv.ilev, igp, jgp) = (dvdx - dudy) * ((1.0 / metdet(kv.ie, igp, jgp)) *
-                                                PhysicalConstants::rrearth);
   });
 }
 
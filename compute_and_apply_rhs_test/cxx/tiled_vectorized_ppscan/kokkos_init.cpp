@@ -3,6 +3,7 @@
 #include "Control.hpp"
 #include "Elements.hpp"
 #include "Derivative.hpp"
+#include "CubedSphere.hpp"
 #include "CaarFunctor.hpp"
 
 #include "profiling.hpp"
@@ -57,6 +58,33 @@ void flush_caches(HostViewManaged<Real *> &trash) {
 
 void finalize_kokkos() { Kokkos::finalize(); }
 
+// Replace the random data with the first num_elems elements of a cubed sphere
+void init_from_mesh(const int ne, const int num_elems, Control &data,
+                    Elements &elem, Derivative &deriv) {
+  CubedSphere mesh(ne);
+  mesh.init_state(num_elems);
+
+  deriv.init(mesh.m_dvv.data());
+
+  elem.init(num_elems);
+  elem.init_2d(mesh.m_d.data(), mesh.m_dinv.data(), mesh.m_fcor.data(),
+               mesh.m_spheremp.data(), mesh.m_metdet.data(),
+               mesh.m_phis.data());
+  elem.pull_from_f90_pointers(
+      mesh.m_state_v.data(), mesh.m_state_t.data(), mesh.m_state_dp3d.data(),
+      mesh.m_derived_phi.data(), mesh.m_derived_pecnd.data(),
+      mesh.m_derived_omega_p.data(), mesh.m_derived_v.data(),
+      mesh.m_derived_eta_dot_dpdn.data(), mesh.m_state_qdp.data());
+
+  data.ps0 = mesh.m_ps0;
+  ExecViewManaged<Real[NUM_LEV_P]>::HostMirror h_hybrid_a =
+      Kokkos::create_mirror_view(data.hybrid_a);
+  for (int i = 0; i < NUM_LEV_P; ++i) {
+    h_hybrid_a(i) = mesh.m_hybrid_a[i];
+  }
+  Kokkos::deep_copy(data.hybrid_a, h_hybrid_a);
+}
+
 int main(int argc, char **argv) {
   constexpr int tstep = 600;
 
@@ -92,11 +120,27 @@ int main(int argc, char **argv) {
     num_elems = atoi(argv[1]);
   }
 
-  Elements elem;
-  elem.random_init(num_elems, rng);
+  // With ne > 0 the elements are taken from a cubed sphere with ne x ne
+  // elements per face, instead of being filled with random numbers
+  int ne = 0;
+  if (argc > 3) {
+    ne = atoi(argv[3]);
+  }
+  if (num_elems > 6 * ne * ne && ne > 0) {
+    std::cerr << "A cubed sphere with ne=" << ne << " only has "
+              << 6 * ne * ne << " elements\n";
+    finalize_kokkos();
+    return 1;
+  }
 
+  Elements elem;
   Derivative deriv;
-  deriv.random_init(rng);
+  if (ne > 0) {
+    init_from_mesh(ne, num_elems, data, elem, deriv);
+  } else {
+    elem.random_init(num_elems, rng);
+    deriv.random_init(rng);
+  }
 
   constexpr int seconds_per_day = 24 * 3600;
   constexpr int rk_stages = 5;
@@ -107,7 +151,7 @@ int main(int argc, char **argv) {
   }
 
   // Create the functor
-  CaarFunctor func(data, elem, deriv);
+  CaarFunctor<> func(data, elem, deriv);
 
   constexpr int kb_size = 1024;
   constexpr int doubles_per_kb = kb_size / sizeof(double);
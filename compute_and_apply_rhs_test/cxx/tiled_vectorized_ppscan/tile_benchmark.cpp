@@ -0,0 +1,168 @@
+#include "Types.hpp"
+#include "Control.hpp"
+#include "Elements.hpp"
+#include "Derivative.hpp"
+#include "CaarFunctor.hpp"
+
+#include "profiling.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <chrono>
+#include <random>
+
+using namespace Homme;
+
+using clock_type = std::chrono::high_resolution_clock;
+using ns = std::chrono::nanoseconds;
+
+using StateView = ExecViewManaged<Scalar * [NUM_TIME_LEVELS][NUM_LEV][NP][NP]>;
+
+// A host copy of the state CAAR writes at np1
+struct StateCopy {
+  explicit StateCopy(const Elements &elem)
+      : u(Kokkos::create_mirror(elem.m_u)), v(Kokkos::create_mirror(elem.m_v)),
+        t(Kokkos::create_mirror(elem.m_t)),
+        dp3d(Kokkos::create_mirror(elem.m_dp3d)) {
+    Kokkos::deep_copy(u, elem.m_u);
+    Kokkos::deep_copy(v, elem.m_v);
+    Kokkos::deep_copy(t, elem.m_t);
+    Kokkos::deep_copy(dp3d, elem.m_dp3d);
+  }
+
+  StateView::HostMirror u, v, t, dp3d;
+};
+
+// Largest difference between the packs of two copies of a field
+static Real max_diff(const StateView::HostMirror &computed,
+                     const StateView::HostMirror &expected) {
+  const Scalar *c = computed.data();
+  const Scalar *e = expected.data();
+  Real diff = 0;
+  for (size_t i = 0; i < expected.size(); ++i) {
+    for (int v = 0; v < VECTOR_SIZE; ++v) {
+      diff = std::max(diff, std::abs(c[i][v] - e[i][v]));
+    }
+  }
+  return diff;
+}
+
+static Real max_diff(const StateCopy &computed, const StateCopy &expected) {
+  return std::max(std::max(max_diff(computed.u, expected.u),
+                           max_diff(computed.v, expected.v)),
+                  std::max(max_diff(computed.t, expected.t),
+                           max_diff(computed.dp3d, expected.dp3d)));
+}
+
+// Runs CAAR with tiles of LEV_TILE level packs num_exec times, after once to
+// warm up the caches, and returns the seconds it took
+template <int LEV_TILE>
+static double time_caar(const Control &data, const Elements &elem,
+                        const Derivative &deriv, const int num_exec) {
+  constexpr int threads_per_team = 4;
+  constexpr int vectors_per_thread = 1;
+  const int num_elems = elem.num_elems();
+  Kokkos::TeamPolicy<ExecSpace> policy(num_elems, threads_per_team,
+                                       vectors_per_thread);
+  policy.set_chunk_size(1);
+
+  CaarFunctor<LEV_TILE> func(data, elem, deriv);
+  Kokkos::parallel_for(policy, func);
+  ExecSpace::fence();
+
+  const auto start = clock_type::now();
+  for (int exec = 0; exec < num_exec; ++exec) {
+    Kokkos::parallel_for(policy, func);
+    ExecSpace::fence();
+  }
+  const auto end = clock_type::now();
+  return std::chrono::duration_cast<ns>(end - start).count() * 1e-9;
+}
+
+// Times the tiles from 1 to LEV_TILE level packs, in that order
+template <int LEV_TILE> struct TileSweep {
+  static void run(const Control &data, const Elements &elem,
+                  const Derivative &deriv, const int num_exec,
+                  const StateCopy &expected) {
+    TileSweep<LEV_TILE - 1>::run(data, elem, deriv, num_exec, expected);
+
+    const double seconds = time_caar<LEV_TILE>(data, elem, deriv, num_exec);
+    std::cout << LEV_TILE << "," << CaarFunctor<LEV_TILE>::NUM_LEV_TILES
+              << "," << elem.num_elems() << "," << num_exec << ","
+              << seconds << "," << max_diff(StateCopy(elem), expected)
+              << std::endl;
+  }
+};
+
+template <> struct TileSweep<0> {
+  static void run(const Control &, const Elements &, const Derivative &,
+                  const int, const StateCopy &) {}
+};
+
+// CAAR with each level tile between 1 and NUM_LEV packs on the same random
+// elements, written as CSV: the tile, the number of tiles of an element, the
+// seconds to run it num_exec times and the largest difference of the np1
+// state with the one of the tiles of 1 pack (the tiles do not change the
+// arithmetic, so it should be 0). The fastest tile is the one to build
+// tiled_vectorized_ppscan with (HOMMEXX_LEVEL_TILE)
+int main(int argc, char **argv) {
+  constexpr int tstep = 600;
+
+  Kokkos::initialize();
+  ExecSpace::print_configuration(std::cout, true);
+  GPTLinitialize();
+
+  int num_elems = 32;
+  if (argc > 1) {
+    num_elems = atoi(argv[1]);
+  }
+
+  int num_exec = 100;
+  if (argc > 2) {
+    num_exec = atoi(argv[2]);
+  }
+
+  if (num_elems < 1 || num_exec < 1) {
+    std::cerr << "Usage: " << argv[0] << " [num_elems] [num_exec]\n";
+    Kokkos::finalize();
+    return 1;
+  }
+
+  std::random_device rd;
+  std::mt19937_64 rng(rd());
+
+  Control data;
+  data.nm1 = 0;
+  data.n0 = 1;
+  data.np1 = 2;
+  data.qn0 = -1;
+  data.dt = tstep;
+  data.ps0 = 1.0;
+  data.eta_ave_w = 1.0;
+  data.hybrid_a = ExecViewManaged<Real[NUM_LEV_P]>(
+      "Hybrid coordinates; translates between pressure and velocity");
+  HostViewManaged<Real[NUM_LEV_P]> hybrid_a_host =
+      Kokkos::create_mirror_view(data.hybrid_a);
+  std::uniform_real_distribution<Real> dist(1.0, 2.0);
+  for (int i = 0; i < NUM_LEV_P; ++i) {
+    hybrid_a_host(i) = dist(rng);
+  }
+  Kokkos::deep_copy(data.hybrid_a, hybrid_a_host);
+
+  Elements elem;
+  elem.random_init(num_elems, rng);
+  Derivative deriv;
+  deriv.random_init(rng);
+
+  // CAAR only reads nm1 and n0, so every run writes the same np1 state
+  time_caar<1>(data, elem, deriv, 1);
+  const StateCopy expected(elem);
+
+  std::cout << "level_tile,tiles_per_element,elements,executions,seconds,"
+            << "max_diff\n";
+  TileSweep<NUM_LEV>::run(data, elem, deriv, num_exec, expected);
+
+  Kokkos::finalize();
+  return 0;
+}
@@ -0,0 +1,200 @@
+#include "element_layout.hpp"
+
+#include <algorithm>
+
+namespace {
+
+constexpr double scalar = 3.0;
+
+// Calls op(offset, length) on the runs of the part [begin, end) of the
+// slices, offset being the one of the run in the slice of time level 0
+template <typename Op>
+inline void for_each_run( const ElementShape & shape
+                        , const std::size_t begin
+                        , const std::size_t end
+                        , const Op & op
+                        )
+{
+  const std::size_t run = shape.run_length;
+  const std::size_t run_stride = NUM_TIME_LEVELS * run;
+  std::size_t k = begin % run;
+  std::size_t offset = begin / run * run_stride + k;
+  for (std::size_t i = begin; i < end; ) {
+    const std::size_t length = std::min(run - k, end - i);
+    op(offset, length);
+    i += length;
+    offset += run_stride - k;
+    k = 0;
+  }
+}
+
+// a(np1) = op(b(n0), c(nm1)) on the part [begin, end) of the slices
+template <typename Op>
+inline void slice_loop( const ElementShape & shape
+                      , double * __restrict__ a
+                      , const double * __restrict__ b
+                      , const double * __restrict__ c
+                      , const std::size_t begin
+                      , const std::size_t end
+                      , const Op & op
+                      )
+{
+  const std::size_t run = shape.run_length;
+  for_each_run(shape, begin, end,
+               [=](const std::size_t offset, const std::size_t length) {
+    double * __restrict__ a_np1 = a + offset + NP1 * run;
+    const double * __restrict__ b_n0 = b + offset + N0 * run;
+    const double * __restrict__ c_nm1 = c + offset + NM1 * run;
+    #pragma omp simd
+    for (std::size_t j = 0; j < length; ++j) {
+      a_np1[j] = op(b_n0[j], c_nm1[j]);
+    }
+  });
+}
+
+} // anonymous namespace
+
+const char * ordering_name( const ElementOrdering ordering )
+{
+  static const char * names[NUM_ORDERINGS] = {
+    "ie.tl.lev.np", "ie.tl.np.pack", "ie.lev.tl.np", "ie.np.tl.pack",
+    "ie.pack.tl.np.vec", "ie.lev.np.tl", "tl.ie.lev.np"
+  };
+  return names[ordering];
+}
+
+ElementShape::ElementShape( const ElementOrdering ordering_
+                          , const int num_elems_
+                          , const int nlev_
+                          )
+  : ordering(ordering_)
+  , num_elems(num_elems_)
+  , nlev(nlev_)
+  , stored_levels(nlev_)
+  , num_runs(0)
+  , run_length(0)
+{
+  const std::size_t points = NP * NP;
+  const std::size_t num_packs = (nlev + PACK_SIZE - 1) / PACK_SIZE;
+  if (ordering == IE_TL_NP_PACK || ordering == IE_NP_TL_PACK ||
+      ordering == IE_PACK_TL_NP_VEC) {
+    stored_levels = num_packs * PACK_SIZE;
+  }
+  switch (ordering) {
+  case IE_TL_LEV_NP:
+    num_runs = num_elems;
+    run_length = nlev * points;
+    break;
+  case IE_TL_NP_PACK:
+    num_runs = num_elems;
+    run_length = points * stored_levels;
+    break;
+  case IE_LEV_TL_NP:
+    num_runs = static_cast<std::size_t>(num_elems) * nlev;
+    run_length = points;
+    break;
+  case IE_NP_TL_PACK:
+    num_runs = num_elems * points;
+    run_length = stored_levels;
+    break;
+  case IE_PACK_TL_NP_VEC:
+    num_runs = num_elems * num_packs;
+    run_length = points * PACK_SIZE;
+    break;
+  case IE_LEV_NP_TL:
+    num_runs = static_cast<std::size_t>(num_elems) * nlev * points;
+    run_length = 1;
+    break;
+  case TL_IE_LEV_NP:
+    num_runs = 1;
+    run_length = static_cast<std::size_t>(num_elems) * nlev * points;
+    break;
+  default:
+    break;
+  }
+}
+
+std::size_t ElementShape::slice_values() const
+{
+  return static_cast<std::size_t>(num_elems) * nlev * NP * NP;
+}
+
+void place_elements( const ElementShape & shape
+                   , double * x
+                   , const double value
+                   )
+{
+  const std::size_t run = shape.run_length;
+  #pragma omp parallel
+  {
+    std::size_t begin, end;
+    thread_range(shape.slice_size(), begin, end);
+    for_each_run(shape, begin, end,
+                 [=](const std::size_t offset, const std::size_t length) {
+      for (int tl = 0; tl < NUM_TIME_LEVELS; ++tl) {
+        for (std::size_t j = 0; j < length; ++j) {
+          x[offset + tl * run + j] = value;
+        }
+      }
+    });
+  }
+}
+
+double run_element_kernel( const StreamKernel kernel
+                         , const ElementShape & shape
+                         , double * a
+                         , const double * b
+                         , const double * c
+                         , const int reps
+                         )
+{
+  const std::size_t run = shape.run_length;
+  double sum = 0.0;
+  #pragma omp parallel reduction(+:sum)
+  {
+    std::size_t begin, end;
+    thread_range(shape.slice_size(), begin, end);
+    for (int rep = 0; rep < reps; ++rep) {
+      switch (kernel) {
+      case COPY:
+        slice_loop(shape, a, b, c, begin, end,
+                   [](const double x, const double) { return x; });
+        break;
+      case SCALE:
+        slice_loop(shape, a, b, c, begin, end,
+                   [](const double x, const double) { return scalar * x; });
+        break;
+      case ADD:
+        slice_loop(shape, a, b, c, begin, end,
+                   [](const double x, const double y) { return x + y; });
+        break;
+      case TRIAD:
+        slice_loop(shape, a, b, c, begin, end,
+                   [](const double x, const double y) {
+                     return x + scalar * y;
+                   });
+        break;
+      case READ: {
+        double part = 0.0;
+        for_each_run(shape, begin, end,
+                     [&](const std::size_t offset, const std::size_t length) {
+          const double * b_n0 = b + offset + N0 * run;
+          #pragma omp simd reduction(+:part)
+          for (std::size_t j = 0; j < length; ++j) {
+            part += b_n0[j];
+          }
+        });
+        sum += part;
+        break;
+      }
+      case WRITE:
+        slice_loop(shape, a, b, c, begin, end,
+                   [](const double, const double) { return scalar; });
+        break;
+      default:
+        break;
+      }
+    }
+  }
+  return sum;
+}
@@ -0,0 +1,100 @@
+#ifndef ELEMENT_LAYOUT_HPP
+#define ELEMENT_LAYOUT_HPP
+
+#include "stream.hpp"
+
+#include <cstddef>
+
+#include <config.h>
+
+// The shape of the prognostic fields of compute_and_apply_rhs_test:
+// num_elems elements of NP x NP points, NUM_TIME_LEVELS time levels and nlev
+// levels, the levels possibly stored in packs of PACK_SIZE (Scalar), the last
+// one padded
+constexpr int NP = NP_MACRO;
+constexpr int NUM_TIME_LEVELS = 3;
+constexpr int PACK_SIZE = PACK_SIZE_MACRO;
+
+// Time levels the kernels work on, as in a CAAR step
+constexpr int NM1 = 0;
+constexpr int N0 = 1;
+constexpr int NP1 = 2;
+
+// Orderings of the indices of a field, from the slowest to the fastest
+// (ie: element, tl: time level, lev: level, pack: pack of levels,
+// vec: level in the pack, np: the NP x NP points):
+//   ie,tl,lev,np     the F90 element arrays (state%T, state%dp3d)
+//   ie,tl,np,pack    the Elements views of the level vectorized variants
+//   ie,lev,tl,np     the time levels of a level next to each other; the
+//                    short NP x NP runs of the state
+//   ie,np,tl,pack    a column of packs per point and time level
+//   ie,pack,tl,np,vec  one Scalar per point, the time levels of a pack
+//                    next to each other
+//   ie,lev,np,tl     the time levels innermost
+//   tl,ie,lev,np     the time levels outermost: the slice of a time level is
+//                    contiguous, as the arrays of STREAM
+enum ElementOrdering {
+  IE_TL_LEV_NP = 0,
+  IE_TL_NP_PACK,
+  IE_LEV_TL_NP,
+  IE_NP_TL_PACK,
+  IE_PACK_TL_NP_VEC,
+  IE_LEV_NP_TL,
+  TL_IE_LEV_NP,
+  NUM_ORDERINGS
+};
+
+const char * ordering_name( const ElementOrdering ordering );
+
+// A field of one of the orderings. The slice of a time level is made of
+// num_runs contiguous runs of run_length doubles, one every
+// NUM_TIME_LEVELS * run_length doubles
+struct ElementShape {
+  ElementShape( const ElementOrdering ordering
+              , const int num_elems
+              , const int nlev
+              );
+
+  // Doubles of a field, padding included
+  std::size_t size() const { return NUM_TIME_LEVELS * num_runs * run_length; }
+
+  // Doubles of the slice of a time level the kernels compute on, padding
+  // included, and the ones that are not padding
+  std::size_t slice_size() const { return num_runs * run_length; }
+  std::size_t slice_values() const;
+
+  ElementOrdering ordering;
+  int num_elems;
+  int nlev;
+  int stored_levels;
+  std::size_t num_runs;
+  std::size_t run_length;
+};
+
+// Sets the doubles of the time levels of x to value, each thread touching
+// the part of every time level it works on in the kernels
+void place_elements( const ElementShape & shape
+                   , double * x
+                   , const double value
+                   );
+
+// Runs the kernel reps times on the time levels of the fields a, b and c of
+// the shape with the current number of threads, visiting them in the order
+// of their memory (the best a loop nest can do with the ordering):
+//   copy:  a(np1) = b(n0)
+//   scale: a(np1) = s * b(n0)
+//   add:   a(np1) = b(n0) + c(nm1)
+//   triad: a(np1) = b(n0) + s * c(nm1)
+//   read:  sum += b(n0)
+//   write: a(np1) = s
+// The slices are partitioned among the threads as an array of slice_size()
+// doubles, so each of them works on its own part. Returns the sum of read
+double run_element_kernel( const StreamKernel kernel
+                         , const ElementShape & shape
+                         , double * a
+                         , const double * b
+                         , const double * c
+                         , const int reps
+                         );
+
+#endif // ELEMENT_LAYOUT_HPP
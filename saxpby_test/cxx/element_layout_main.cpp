@@ -0,0 +1,171 @@
+#include "element_layout.hpp"
+#include "stream.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+using clock_type = std::chrono::high_resolution_clock;
+
+// Each measurement moves at least this many bytes, as in stream_test_cxx
+constexpr double min_bytes_per_trial = 256.0 * 1024 * 1024;
+
+double seconds_since( const clock_type::time_point & start )
+{
+  return 1.0e-9 * std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      clock_type::now() - start ).count();
+}
+
+// Best time of the trials of run(reps), after running it once to warm up
+// the caches and the TLB; the sums it returns go to checksum
+template <typename Run>
+double best_seconds( const int trials
+                   , const int reps
+                   , double & checksum
+                   , const Run & run
+                   )
+{
+  checksum += run(1);
+  double best = 0.0;
+  for (int trial = 0; trial < trials; ++trial) {
+    const clock_type::time_point start = clock_type::now();
+    checksum += run(reps);
+    const double seconds = seconds_since(start);
+    if (trial == 0 || seconds < best) {
+      best = seconds;
+    }
+  }
+  return best;
+}
+
+} // anonymous namespace
+
+// Bandwidth of the STREAM kernels on fields shaped as the ones of
+// compute_and_apply_rhs_test, for each ordering of their indices and number
+// of elements, next to the one of the same kernel on contiguous arrays of as
+// many values (the STREAM arrays). The kernels compute on one time level of
+// the fields, as CAAR does, and only count the bytes of the values of that
+// time level, so fraction_of_stream is the part of the bandwidth that the
+// ordering keeps: the rest goes to the other time levels sharing its cache
+// lines, the padding of the packs and the overhead of the short runs.
+// Written as CSV on stdout, with the number of threads OpenMP uses.
+//
+// Usage: element_layout_test_cxx [nlev] [max_elems] [min_elems] [trials]
+int main( int argc, char * argv[] )
+{
+  int nlev = 72;
+  if (argc > 1) {
+    nlev = std::atoi( argv[1] );
+  }
+  int max_elems = 4096;
+  if (argc > 2) {
+    max_elems = std::atoi( argv[2] );
+  }
+  int min_elems = 1;
+  if (argc > 3) {
+    min_elems = std::atoi( argv[3] );
+  }
+  int trials = 5;
+  if (argc > 4) {
+    trials = std::atoi( argv[4] );
+  }
+  if (nlev < 1 || min_elems < 1 || max_elems < min_elems || trials < 1) {
+    std::cerr << "Usage: " << argv[0]
+              << " [nlev] [max_elems] [min_elems] [trials]" << std::endl;
+    return 1;
+  }
+
+#ifdef _OPENMP
+  const int threads = omp_get_max_threads();
+#else
+  const int threads = 1;
+#endif
+
+  std::cout << "kernel,ordering,threads,elements,run_doubles,gb_per_s,"
+            << "stream_gb_per_s,fraction_of_stream" << std::endl;
+
+  double checksum = 0.0;
+  for (int num_elems = min_elems; num_elems <= max_elems; num_elems *= 4) {
+    // The contiguous arrays of STREAM, as many values as a time level
+    const std::size_t n = ElementShape(TL_IE_LEV_NP, num_elems, nlev)
+                              .slice_values();
+    double stream_gb_per_s[NUM_KERNELS];
+    {
+      double * a = allocate_array(n);
+      double * b = allocate_array(n);
+      double * c = allocate_array(n);
+      if (a == nullptr || b == nullptr || c == nullptr) {
+        std::cerr << "Error! Could not allocate 3 arrays of " << n
+                  << " doubles" << std::endl;
+        std::abort();
+      }
+      place_array(FIRST_TOUCH, a, n, 0.0);
+      place_array(FIRST_TOUCH, b, n, 1.0);
+      place_array(FIRST_TOUCH, c, n, 2.0);
+      for (int ik = 0; ik < NUM_KERNELS; ++ik) {
+        const StreamKernel kernel = static_cast<StreamKernel>(ik);
+        const double bytes = 8.0 * n *
+            (arrays_read(kernel) + arrays_written(kernel));
+        const int reps = std::max(1.0, min_bytes_per_trial / bytes);
+        const double best = best_seconds(trials, reps, checksum,
+                                         [&](const int r) {
+          return run_kernel(kernel, REGULAR_STORES, a, b, c, n, r);
+        });
+        stream_gb_per_s[ik] = 1.0e-9 * bytes * reps / best;
+      }
+      free_array(a);
+      free_array(b);
+      free_array(c);
+    }
+
+    for (int io = 0; io < NUM_ORDERINGS; ++io) {
+      const ElementShape shape(static_cast<ElementOrdering>(io), num_elems,
+                               nlev);
+      double * a = allocate_array(shape.size());
+      double * b = allocate_array(shape.size());
+      double * c = allocate_array(shape.size());
+      if (a == nullptr || b == nullptr || c == nullptr) {
+        std::cerr << "Error! Could not allocate 3 fields of " << num_elems
+                  << " elements" << std::endl;
+        std::abort();
+      }
+      place_elements(shape, a, 0.0);
+      place_elements(shape, b, 1.0);
+      place_elements(shape, c, 2.0);
+
+      for (int ik = 0; ik < NUM_KERNELS; ++ik) {
+        const StreamKernel kernel = static_cast<StreamKernel>(ik);
+        const double bytes = 8.0 * shape.slice_values() *
+            (arrays_read(kernel) + arrays_written(kernel));
+        const int reps = std::max(1.0, min_bytes_per_trial / bytes);
+        const double best = best_seconds(trials, reps, checksum,
+                                         [&](const int r) {
+          return run_element_kernel(kernel, shape, a, b, c, r);
+        });
+        const double gb_per_s = 1.0e-9 * bytes * reps / best;
+        std::printf("%s,%s,%d,%d,%zu,%.3f,%.3f,%.3f\n", kernel_name(kernel),
+                    ordering_name(shape.ordering), threads, num_elems,
+                    shape.run_length, gb_per_s, stream_gb_per_s[ik],
+                    gb_per_s / stream_gb_per_s[ik]);
+        std::fflush(stdout);
+      }
+
+      free_array(a);
+      free_array(b);
+      free_array(c);
+    }
+  }
+
+  // Keeps the read kernels from being optimized away
+  std::cerr << "Checksum: " << checksum << std::endl;
+
+  return 0;
+}
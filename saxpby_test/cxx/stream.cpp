@@ -0,0 +1,232 @@
+#include "stream.hpp"
+
+#include <cstdlib>
+#include <unistd.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+constexpr double scalar = 3.0;
+
+// Parts of the threads start on a cache line (8 doubles)
+constexpr std::size_t line_doubles = 8;
+
+int thread_id()
+{
+#ifdef _OPENMP
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
+
+int num_threads()
+{
+#ifdef _OPENMP
+  return omp_get_num_threads();
+#else
+  return 1;
+#endif
+}
+
+// a[i] = op(i) over [begin, end); begin is on a cache line
+template <StoreKind stores, typename Op>
+inline void store_loop( double * a
+                      , const std::size_t begin
+                      , const std::size_t end
+                      , const Op & op
+                      )
+{
+  std::size_t i = begin;
+#ifdef __SSE2__
+  if (stores == NON_TEMPORAL_STORES) {
+    for (; i + 2 <= end; i += 2) {
+      _mm_stream_pd(a + i, _mm_set_pd(op(i + 1), op(i)));
+    }
+    for (; i < end; ++i) {
+      a[i] = op(i);
+    }
+    _mm_sfence();
+    return;
+  }
+#endif
+  #pragma omp simd
+  for (std::size_t j = begin; j < end; ++j) {
+    a[j] = op(j);
+  }
+}
+
+template <StoreKind stores>
+double run_kernel( const StreamKernel kernel
+                 , double * __restrict__ a
+                 , const double * __restrict__ b
+                 , const double * __restrict__ c
+                 , const std::size_t n
+                 , const int reps
+                 )
+{
+  double sum = 0.0;
+  #pragma omp parallel reduction(+:sum)
+  {
+    std::size_t begin, end;
+    thread_range(n, begin, end);
+    for (int rep = 0; rep < reps; ++rep) {
+      switch (kernel) {
+      case COPY:
+        store_loop<stores>(a, begin, end,
+                           [=](const std::size_t i) { return b[i]; });
+        break;
+      case SCALE:
+        store_loop<stores>(a, begin, end,
+                           [=](const std::size_t i) { return scalar * b[i]; });
+        break;
+      case ADD:
+        store_loop<stores>(a, begin, end,
+                           [=](const std::size_t i) { return b[i] + c[i]; });
+        break;
+      case TRIAD:
+        store_loop<stores>(a, begin, end, [=](const std::size_t i) {
+          return b[i] + scalar * c[i];
+        });
+        break;
+      case READ: {
+        double part = 0.0;
+        #pragma omp simd reduction(+:part)
+        for (std::size_t i = begin; i < end; ++i) {
+          part += b[i];
+        }
+        sum += part;
+        break;
+      }
+      case WRITE:
+        store_loop<stores>(a, begin, end,
+                           [=](const std::size_t) { return scalar; });
+        break;
+      default:
+        break;
+      }
+    }
+  }
+  return sum;
+}
+
+} // anonymous namespace
+
+void thread_range( const std::size_t n
+                 , std::size_t & begin
+                 , std::size_t & end
+                 )
+{
+  const std::size_t lines = (n + line_doubles - 1) / line_doubles;
+  const std::size_t tid = thread_id();
+  const std::size_t nthreads = num_threads();
+  begin = lines * tid / nthreads * line_doubles;
+  end = lines * (tid + 1) / nthreads * line_doubles;
+  if (begin > n) begin = n;
+  if (end > n) end = n;
+}
+
+const char * kernel_name( const StreamKernel kernel )
+{
+  static const char * names[NUM_KERNELS] = {
+    "copy", "scale", "add", "triad", "read", "write"
+  };
+  return names[kernel];
+}
+
+const char * store_name( const StoreKind stores )
+{
+  static const char * names[NUM_STORE_KINDS] = { "regular", "non_temporal" };
+  return names[stores];
+}
+
+const char * placement_name( const Placement placement )
+{
+  static const char * names[NUM_PLACEMENTS] = {
+    "first_touch", "interleaved", "single_node"
+  };
+  return names[placement];
+}
+
+int arrays_read( const StreamKernel kernel )
+{
+  static const int reads[NUM_KERNELS] = { 1, 1, 2, 2, 1, 0 };
+  return reads[kernel];
+}
+
+int arrays_written( const StreamKernel kernel )
+{
+  static const int writes[NUM_KERNELS] = { 1, 1, 1, 1, 0, 1 };
+  return writes[kernel];
+}
+
+double * allocate_array( const std::size_t n )
+{
+  void * x = nullptr;
+  if (posix_memalign(&x, sysconf(_SC_PAGESIZE), sizeof(double) * n) != 0) {
+    return nullptr;
+  }
+  return static_cast<double *>(x);
+}
+
+void free_array( double * x )
+{
+  free(x);
+}
+
+void place_array( const Placement placement
+                , double * x
+                , const std::size_t n
+                , const double value
+                )
+{
+  const std::size_t page_doubles = sysconf(_SC_PAGESIZE) / sizeof(double);
+  switch (placement) {
+  case FIRST_TOUCH:
+    #pragma omp parallel
+    {
+      std::size_t begin, end;
+      thread_range(n, begin, end);
+      for (std::size_t i = begin; i < end; ++i) {
+        x[i] = value;
+      }
+    }
+    return;
+  case INTERLEAVED:
+    #pragma omp parallel
+    {
+      const std::size_t step = num_threads() * page_doubles;
+      for (std::size_t i = thread_id() * page_doubles; i < n; i += step) {
+        x[i] = value;
+      }
+    }
+    break;
+  default:
+    break;
+  }
+  for (std::size_t i = 0; i < n; ++i) {
+    x[i] = value;
+  }
+}
+
+double run_kernel( const StreamKernel kernel
+                 , const StoreKind stores
+                 , double * a
+                 , const double * b
+                 , const double * c
+                 , const std::size_t n
+                 , const int reps
+                 )
+{
+  if (stores == NON_TEMPORAL_STORES) {
+    return run_kernel<NON_TEMPORAL_STORES>(kernel, a, b, c, n, reps);
+  }
+  return run_kernel<REGULAR_STORES>(kernel, a, b, c, n, reps);
+}
@@ -0,0 +1,70 @@
+#ifndef STREAM_HPP
+#define STREAM_HPP
+
+#include <cstddef>
+
+// The kernels of the bandwidth suite:
+//   copy:  a = b
+//   scale: a = s * b
+//   add:   a = b + c
+//   triad: a = b + s * c
+//   read:  sum += b
+//   write: a = s
+enum StreamKernel { COPY = 0, SCALE, ADD, TRIAD, READ, WRITE, NUM_KERNELS };
+
+// Regular stores read the line they write first (write allocate), which the
+// bytes counted by the suite do not include; non-temporal stores bypass the
+// caches and do not
+enum StoreKind { REGULAR_STORES = 0, NON_TEMPORAL_STORES, NUM_STORE_KINDS };
+
+// Where the pages of the arrays go:
+//   first touch: each page on the node of the thread that uses it in the
+//                kernels, with their static partition
+//   interleaved: pages dealt round robin to the threads, so spread over
+//                the nodes of the threads (with OMP_PROC_BIND=spread)
+//   single node: all of them on the node of the master thread
+enum Placement { FIRST_TOUCH = 0, INTERLEAVED, SINGLE_NODE, NUM_PLACEMENTS };
+
+const char * kernel_name( const StreamKernel kernel );
+const char * store_name( const StoreKind stores );
+const char * placement_name( const Placement placement );
+
+// Number of arrays a kernel reads and writes; the bytes it moves per element
+// are 8 times their sum, as in STREAM
+int arrays_read( const StreamKernel kernel );
+int arrays_written( const StreamKernel kernel );
+
+// The part of [0, n) of the calling thread in the static partition among the
+// threads of the team that the kernels and first touch use; the parts start
+// on a cache line
+void thread_range( const std::size_t n
+                 , std::size_t & begin
+                 , std::size_t & end
+                 );
+
+// Allocates n doubles aligned to a page, which no thread touched yet
+double * allocate_array( const std::size_t n );
+void free_array( double * x );
+
+// Sets the n values of x to value, touching its pages first as placement
+// says, with the current number of threads
+void place_array( const Placement placement
+                , double * x
+                , const std::size_t n
+                , const double value
+                );
+
+// Runs the kernel reps times over n elements with the current number of
+// threads. Each thread only works on its own part of the arrays (the one
+// first touch places near it), so the repetitions need no barriers. Returns
+// the sum of read, so that it cannot be optimized away
+double run_kernel( const StreamKernel kernel
+                 , const StoreKind stores
+                 , double * a
+                 , const double * b
+                 , const double * c
+                 , const std::size_t n
+                 , const int reps
+                 );
+
+#endif // STREAM_HPP
@@ -0,0 +1,148 @@
+#include "stream.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+using clock_type = std::chrono::high_resolution_clock;
+
+// Each measurement moves at least this many bytes, so that the arrays that
+// fit in the caches are swept enough times to be timed accurately
+constexpr double min_bytes_per_trial = 256.0 * 1024 * 1024;
+
+double seconds_since( const clock_type::time_point & start )
+{
+  return 1.0e-9 * std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      clock_type::now() - start ).count();
+}
+
+// 1, 2, 4, ... up to the number of threads OpenMP would use, which is always
+// the last
+std::vector<int> thread_counts()
+{
+#ifdef _OPENMP
+  const int max_threads = omp_get_max_threads();
+#else
+  const int max_threads = 1;
+#endif
+  std::vector<int> counts;
+  for (int count = 1; count < max_threads; count *= 2) {
+    counts.push_back(count);
+  }
+  counts.push_back(max_threads);
+  return counts;
+}
+
+void set_threads( const int count )
+{
+#ifdef _OPENMP
+  omp_set_num_threads(count);
+#else
+  (void) count;
+#endif
+}
+
+} // anonymous namespace
+
+// Bandwidth of the STREAM kernels plus read-only and write-only ones, for
+// each number of threads, placement of the pages, kind of stores and array
+// size (from the L1 cache to the DRAM), in GB/s (1e9 bytes per second, the
+// bytes STREAM counts). The best of the trials of each configuration is
+// written as CSV on stdout.
+//
+// Usage: stream_test_cxx [max_kib_per_array] [min_kib_per_array] [trials]
+int main( int argc, char * argv[] )
+{
+  std::size_t max_kib = 512 * 1024;
+  if (argc > 1) {
+    max_kib = std::atol( argv[1] );
+  }
+  std::size_t min_kib = 16;
+  if (argc > 2) {
+    min_kib = std::atol( argv[2] );
+  }
+  int trials = 5;
+  if (argc > 3) {
+    trials = std::atoi( argv[3] );
+  }
+  if (min_kib < 1 || max_kib < min_kib || trials < 1) {
+    std::cerr << "Usage: " << argv[0]
+              << " [max_kib_per_array] [min_kib_per_array] [trials]"
+              << std::endl;
+    return 1;
+  }
+
+  std::cout << "kernel,stores,placement,threads,array_bytes,gb_per_s"
+            << std::endl;
+
+  const std::vector<int> counts = thread_counts();
+  double checksum = 0.0;
+  for (std::size_t kib = min_kib; kib <= max_kib; kib *= 4) {
+    const std::size_t n = kib * 1024 / sizeof(double);
+    for (int ip = 0; ip < NUM_PLACEMENTS; ++ip) {
+      const Placement placement = static_cast<Placement>(ip);
+      for (const int count : counts) {
+        set_threads(count);
+
+        // Fresh pages for every placement and number of threads
+        double * a = allocate_array(n);
+        double * b = allocate_array(n);
+        double * c = allocate_array(n);
+        if (a == nullptr || b == nullptr || c == nullptr) {
+          std::cerr << "Error! Could not allocate 3 arrays of " << kib
+                    << " KiB" << std::endl;
+          std::abort();
+        }
+        place_array(placement, a, n, 0.0);
+        place_array(placement, b, n, 1.0);
+        place_array(placement, c, n, 2.0);
+
+        for (int ik = 0; ik < NUM_KERNELS; ++ik) {
+          const StreamKernel kernel = static_cast<StreamKernel>(ik);
+          const double bytes = 8.0 * n *
+              (arrays_read(kernel) + arrays_written(kernel));
+          const int reps = std::max(1.0, min_bytes_per_trial / bytes);
+          for (int is = 0; is < NUM_STORE_KINDS; ++is) {
+            const StoreKind stores = static_cast<StoreKind>(is);
+            if (arrays_written(kernel) == 0 && stores != REGULAR_STORES) {
+              continue;
+            }
+            // Once to warm up the caches and the TLB
+            checksum += run_kernel(kernel, stores, a, b, c, n, 1);
+            double best = 0.0;
+            for (int trial = 0; trial < trials; ++trial) {
+              const clock_type::time_point start = clock_type::now();
+              checksum += run_kernel(kernel, stores, a, b, c, n, reps);
+              const double seconds = seconds_since(start);
+              if (trial == 0 || seconds < best) {
+                best = seconds;
+              }
+            }
+            std::printf("%s,%s,%s,%d,%zu,%.3f\n", kernel_name(kernel),
+                        store_name(stores), placement_name(placement), count,
+                        n * sizeof(double), 1.0e-9 * bytes * reps / best);
+            std::fflush(stdout);
+          }
+        }
+
+        free_array(a);
+        free_array(b);
+        free_array(c);
+      }
+    }
+  }
+
+  // Keeps the read kernel from being optimized away
+  std::cerr << "Checksum: " << checksum << std::endl;
+
+  return 0;
+}